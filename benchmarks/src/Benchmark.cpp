@@ -0,0 +1,17 @@
+#include "Benchmark.h"
+
+//usage: benchmarks [filter], filter is substring of "Group.Name"
+int main(int argc, char* argv[])
+{
+	std::string filter = argc > 1 ? argv[1] : "";
+	for (auto& test : benchmark::getCases()) {
+		std::string name = test.group + "." + test.name;
+		if (name.find(filter) == std::string::npos)
+			continue;
+
+		std::cout << "[" << name << "]" << std::endl;
+		test.body();
+	}
+
+	return 0;
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <random>
+#include <thread>
+#include <algorithm>
+
+namespace benchmark {
+	struct Case {
+		std::string group;
+		std::string name;
+		std::function<void()> body;
+	};
+
+	inline std::vector<Case>& getCases() {
+		static std::vector<Case> cases;
+		return cases;
+	}
+
+	struct Registrar {
+		Registrar(std::string group, std::string name, std::function<void()> body) {
+			getCases().push_back({ group, name, body });
+		}
+	};
+
+	//prevent compiler from throwing away computations which result isn't used
+	template <class T>
+	inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__)
+		asm volatile("" : : "r,m"(value) : "memory");
+#else
+		static volatile const void* sink;
+		sink = &value;
+#endif
+	}
+
+	//run body once and print time spent per operation, returns nanoseconds per operation
+	template <class F>
+	double measure(const std::string& label, size_t operations, F&& body) {
+		auto start = std::chrono::steady_clock::now();
+		body();
+		auto end = std::chrono::steady_clock::now();
+		double nanoseconds = std::chrono::duration<double, std::nano>(end - start).count();
+		double perOperation = nanoseconds / std::max<size_t>(operations, 1);
+		std::cout << "  " << label << ": " << perOperation << " ns/op, " << operations * 1e3 / nanoseconds << " Mop/s" << std::endl;
+		return perOperation;
+	}
+
+	inline int getThreadsNumber() {
+		return std::max(1u, std::thread::hardware_concurrency());
+	}
+}
+
+#define BENCHMARK(group, name) \
+	static void benchmark_##group##_##name(); \
+	static benchmark::Registrar registrar_##group##_##name(#group, #name, benchmark_##group##_##name); \
+	static void benchmark_##group##_##name()
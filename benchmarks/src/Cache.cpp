@@ -0,0 +1,86 @@
+#include "Benchmark.h"
+#include "Cache.h"
+
+//Zipfian distribution over [0, number): key k is requested with probability ~ 1 / (k + 1)^skew
+static std::vector<int> generateZipf(int number, double skew, int length, int seed) {
+	std::vector<double> cdf(number);
+	double sum = 0;
+	for (int i = 0; i < number; i++) {
+		sum += 1.0 / std::pow(i + 1, skew);
+		cdf[i] = sum;
+	}
+
+	std::mt19937 generator(seed);
+	std::uniform_real_distribution<double> uniform(0, sum);
+	std::vector<int> trace(length);
+	for (auto& key : trace)
+		key = static_cast<int>(std::lower_bound(cdf.begin(), cdf.end(), uniform(generator)) - cdf.begin());
+
+	//popular keys shouldn't be small numbers
+	std::vector<int> permutation(number);
+	for (int i = 0; i < number; i++)
+		permutation[i] = i;
+	std::shuffle(permutation.begin(), permutation.end(), generator);
+	for (auto& key : trace)
+		key = permutation[key];
+
+	return trace;
+}
+
+static const char* getName(algogin::CachePolicy policy) {
+	switch (policy) {
+	case algogin::CachePolicy::LRU:
+		return "LRU";
+	case algogin::CachePolicy::CLOCK:
+		return "CLOCK";
+	default:
+		return "TinyLFU";
+	}
+}
+
+static const algogin::CachePolicy policies[] = { algogin::CachePolicy::LRU, algogin::CachePolicy::CLOCK, algogin::CachePolicy::TINY_LFU };
+
+BENCHMARK(Cache, HitRatio) {
+	auto trace = generateZipf(1'000'000, 0.99, 5'000'000, 1);
+	for (size_t capacity : { 1'000, 10'000, 100'000 }) {
+		for (auto policy : policies) {
+			algogin::Cache<int, int> cache({ .capacity = capacity, .policy = policy, .shards = 1 });
+			int hits = 0;
+			for (int key : trace) {
+				if (cache.get(key))
+					hits++;
+				else
+					cache.put(key, key);
+			}
+			std::cout << "  capacity " << capacity << ", " << getName(policy) << ": hit ratio " << 100.0 * hits / trace.size() << "%" << std::endl;
+		}
+	}
+}
+
+BENCHMARK(Cache, Threads) {
+	const int operations = 1'000'000;
+	std::vector<std::vector<int>> traces;
+	for (int t = 0; t < benchmark::getThreadsNumber(); t++)
+		traces.push_back(generateZipf(1'000'000, 0.99, operations, t));
+
+	for (auto policy : policies) {
+		for (int threadsNumber = 1; threadsNumber <= benchmark::getThreadsNumber(); threadsNumber *= 2) {
+			algogin::Cache<int, int> cache({ .capacity = 100'000, .policy = policy });
+			std::vector<std::thread> threads;
+			auto start = std::chrono::steady_clock::now();
+			for (int t = 0; t < threadsNumber; t++) {
+				threads.emplace_back([&cache, &trace = traces[t]] {
+					for (int key : trace) {
+						if (cache.get(key).has_value() == false)
+							cache.put(key, key);
+					}
+				});
+			}
+			for (auto& thread : threads)
+				thread.join();
+			auto end = std::chrono::steady_clock::now();
+			double throughput = threadsNumber * operations / std::chrono::duration<double, std::micro>(end - start).count();
+			std::cout << "  " << getName(policy) << ", threads " << threadsNumber << ": " << throughput << " Mop/s" << std::endl;
+		}
+	}
+}
@@ -0,0 +1,65 @@
+#include "Benchmark.h"
+#include "Dictionary.h"
+
+template <class Table>
+static void compareBatch(const std::string& label, const Table& table, const std::vector<int>& keys) {
+	long long sum = 0;
+	benchmark::measure(label + ", find one by one", keys.size(), [&] {
+		for (int key : keys) {
+			auto value = table.find(key);
+			sum += value.has_value();
+		}
+	});
+
+	std::vector<std::optional<int>> values(256);
+	for (int batch : { 1, 4, 16, 64, 256 }) {
+		benchmark::measure(label + ", findBatch " + std::to_string(batch), keys.size(), [&] {
+			for (size_t start = 0; start + batch <= keys.size(); start += batch) {
+				table.findBatch(std::span(keys).subspan(start, batch), std::span(values).first(batch));
+				sum += values[0].has_value();
+			}
+		});
+	}
+	benchmark::doNotOptimize(sum);
+}
+
+BENCHMARK(HashTable, FindBatch) {
+	const int number = 1'000'000;
+	std::vector<int> keys(number);
+	std::mt19937 generator(1);
+	algogin::HashTable<int, int> table(number);
+	for (auto& key : keys) {
+		key = generator();
+		table.insert(key, key);
+	}
+
+	std::shuffle(keys.begin(), keys.end(), generator);
+	compareBatch("HashTable", table, keys);
+}
+
+//Dictionary::find throws if key doesn't exist, so wrap it to the same interface as HashTable::find
+struct DictionaryAdapter {
+	algogin::Dictionary<int, int>& dictionary;
+
+	std::optional<int> find(int key) const {
+		return dictionary.find(key);
+	}
+
+	void findBatch(std::span<const int> keys, std::span<std::optional<int>> values) const {
+		dictionary.findBatch(keys, values);
+	}
+};
+
+BENCHMARK(Dictionary, FindBatch) {
+	const int number = 1'000'000;
+	std::vector<int> keys(number);
+	std::mt19937 generator(1);
+	algogin::Dictionary<int, int> dictionary;
+	for (int i = 0; i < number; i++) {
+		keys[i] = i * 2;
+		dictionary.insert(keys[i], i);
+	}
+
+	std::shuffle(keys.begin(), keys.end(), generator);
+	compareBatch("Dictionary", DictionaryAdapter{ dictionary }, keys);
+}
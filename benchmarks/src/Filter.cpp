@@ -0,0 +1,38 @@
+#include "Benchmark.h"
+#include "Filter.h"
+#include "Dictionary.h"
+
+BENCHMARK(Filter, Contains) {
+	const int number = 4'000'000;
+	std::vector<uint64_t> keys(number);
+	for (int i = 0; i < number; i++)
+		keys[i] = i * 2ull;
+
+	algogin::BloomFilter<uint64_t> bloom(number);
+	benchmark::measure("BloomFilter build, " + std::to_string(benchmark::getThreadsNumber()) + " threads", number, [&] {
+		bloom.build(keys, benchmark::getThreadsNumber());
+	});
+	algogin::CuckooFilter<uint64_t> cuckoo(number);
+	benchmark::measure("CuckooFilter build", number, [&] {
+		cuckoo.build(keys, benchmark::getThreadsNumber());
+	});
+	algogin::HashTable<uint64_t, bool> table(number);
+	for (auto key : keys)
+		table.insert(key, true);
+
+	//half of the queries are absent keys
+	int found = 0;
+	benchmark::measure("BloomFilter contains", number, [&] {
+		for (uint64_t i = 0; i < number; i++)
+			found += bloom.contains(i);
+	});
+	benchmark::measure("CuckooFilter contains", number, [&] {
+		for (uint64_t i = 0; i < number; i++)
+			found += cuckoo.contains(i);
+	});
+	benchmark::measure("HashTable find", number, [&] {
+		for (uint64_t i = 0; i < number; i++)
+			found += table.find(i).has_value();
+	});
+	benchmark::doNotOptimize(found);
+}
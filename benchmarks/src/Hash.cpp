@@ -0,0 +1,259 @@
+#include "Benchmark.h"
+#include "Hash.h"
+#include "Dictionary.h"
+
+static std::vector<std::string> generateKeys(int number, int length) {
+	std::mt19937 generator(1);
+	std::uniform_int_distribution<int> symbol('a', 'z');
+	std::vector<std::string> keys(number);
+	for (auto& key : keys) {
+		key.resize(length);
+		for (auto& c : key)
+			c = symbol(generator);
+	}
+
+	return keys;
+}
+
+BENCHMARK(Hash, Integer) {
+	const int number = 10'000'000;
+	uint64_t sum = 0;
+	algogin::Hash<uint64_t> hash;
+	benchmark::measure("algogin::Hash<uint64_t>", number, [&] {
+		for (uint64_t i = 0; i < number; i++)
+			sum += hash(i);
+	});
+	std::hash<uint64_t> stdHash;
+	benchmark::measure("std::hash<uint64_t>", number, [&] {
+		for (uint64_t i = 0; i < number; i++)
+			sum += stdHash(i);
+	});
+	benchmark::doNotOptimize(sum);
+}
+
+BENCHMARK(Hash, String) {
+	for (int length : { 8, 16, 64, 1024 }) {
+		const int number = length > 64 ? 100'000 : 1'000'000;
+		auto keys = generateKeys(number, length);
+		uint64_t sum = 0;
+		algogin::Hash<std::string> hash;
+		double algogin = benchmark::measure("algogin::Hash<std::string>, length " + std::to_string(length), number, [&] {
+			for (auto& key : keys)
+				sum += hash(key);
+		});
+		std::hash<std::string> stdHash;
+		benchmark::measure("std::hash<std::string>, length " + std::to_string(length), number, [&] {
+			for (auto& key : keys)
+				sum += stdHash(key);
+		});
+		std::cout << "  algogin::Hash throughput: " << length / algogin << " GB/s" << std::endl;
+		benchmark::doNotOptimize(sum);
+	}
+}
+
+BENCHMARK(HashTable, Find) {
+	const int number = 1'000'000;
+	algogin::HashTable<int, int> table(number);
+	for (int i = 0; i < number; i++)
+		table.insert(i * 7, i);
+
+	int found = 0;
+	benchmark::measure("find int", number, [&] {
+		for (int i = 0; i < number; i++)
+			found += table.find(i * 7).has_value();
+	});
+
+	auto keys = generateKeys(number, 16);
+	algogin::HashTable<std::string, int> strings(number);
+	for (int i = 0; i < number; i++)
+		strings.insert(keys[i], i);
+
+	benchmark::measure("find std::string_view", number, [&] {
+		for (auto& key : keys)
+			found += strings.find(std::string_view(key)).has_value();
+	});
+	benchmark::doNotOptimize(found);
+}
+
+//mixed workload: 50% find, 40% insertOrAssign, 10% remove over 1M keys
+template <class Operation>
+static double runThreads(int threadsNumber, int operationsPerThread, Operation operation) {
+	std::vector<std::thread> threads;
+	auto start = std::chrono::steady_clock::now();
+	for (int t = 0; t < threadsNumber; t++) {
+		threads.emplace_back([&operation, operationsPerThread, t] {
+			std::mt19937 generator(t);
+			std::uniform_int_distribution<int> keys(0, 1'000'000);
+			for (int i = 0; i < operationsPerThread; i++)
+				operation(keys(generator), i % 10);
+		});
+	}
+	for (auto& thread : threads)
+		thread.join();
+	auto end = std::chrono::steady_clock::now();
+	return threadsNumber * operationsPerThread / std::chrono::duration<double, std::micro>(end - start).count();
+}
+
+BENCHMARK(ConcurrentHashTable, Threads) {
+	const int operations = 500'000;
+	for (int threadsNumber = 1; threadsNumber <= benchmark::getThreadsNumber(); threadsNumber *= 2) {
+		algogin::ConcurrentHashTable<int, int> sharded(1 << 20);
+		double shardedThroughput = runThreads(threadsNumber, operations, [&](int key, int type) {
+			if (type < 5)
+				benchmark::doNotOptimize(sharded.find(key));
+			else if (type < 9)
+				sharded.insertOrAssign(key, type);
+			else
+				sharded.remove(key);
+		});
+
+		std::mutex mutex;
+		algogin::HashTable<int, int> locked(1 << 20);
+		double lockedThroughput = runThreads(threadsNumber, operations, [&](int key, int type) {
+			std::lock_guard lock(mutex);
+			if (type < 5)
+				benchmark::doNotOptimize(locked.find(key));
+			else if (type < 9)
+				locked.insertOrAssign(key, type);
+			else
+				locked.remove(key);
+		});
+
+		std::cout << "  threads " << threadsNumber << ": sharded " << shardedThroughput << " Mop/s, single mutex " << lockedThroughput << " Mop/s" << std::endl;
+	}
+}
+
+BENCHMARK(LockFreeHashTable, Threads) {
+	const int operations = 500'000;
+	for (int threadsNumber = 1; threadsNumber <= benchmark::getThreadsNumber(); threadsNumber *= 2) {
+		algogin::LockFreeHashTable<int, int> lockFree;
+		double lockFreeThroughput = runThreads(threadsNumber, operations, [&](int key, int type) {
+			if (type < 5)
+				benchmark::doNotOptimize(lockFree.find(key));
+			else if (type < 9)
+				lockFree.insert(key, type);
+			else
+				lockFree.remove(key);
+		});
+
+		algogin::ConcurrentHashTable<int, int> sharded(1 << 20);
+		double shardedThroughput = runThreads(threadsNumber, operations, [&](int key, int type) {
+			if (type < 5)
+				benchmark::doNotOptimize(sharded.find(key));
+			else if (type < 9)
+				sharded.insertOrAssign(key, type);
+			else
+				sharded.remove(key);
+		});
+
+		std::cout << "  threads " << threadsNumber << ": lock-free " << lockFreeThroughput << " Mop/s, sharded " << shardedThroughput << " Mop/s" << std::endl;
+	}
+}
+
+//latency of every lookup is measured separately, timer overhead is included and the same for all tables
+template <class Table>
+static void printLatency(const std::string& label, Table& table, const std::vector<int>& keys) {
+	std::vector<double> latency;
+	latency.reserve(keys.size());
+	for (int key : keys) {
+		auto start = std::chrono::steady_clock::now();
+		benchmark::doNotOptimize(table.find(key));
+		auto end = std::chrono::steady_clock::now();
+		latency.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+	}
+
+	std::sort(latency.begin(), latency.end());
+	auto percentile = [&latency](double p) { return latency[static_cast<size_t>(p * (latency.size() - 1))]; };
+	std::cout << "  " << label << ": p50 " << percentile(0.5) << " ns, p99 " << percentile(0.99) << " ns, p999 " << percentile(0.999) << " ns" << std::endl;
+}
+
+BENCHMARK(CuckooHashTable, Latency) {
+	const int number = 1'000'000;
+	std::vector<int> keys(number);
+	std::mt19937 generator(1);
+	for (auto& key : keys)
+		key = generator();
+
+	algogin::CuckooHashTable<int, int> cuckoo(number);
+	//chained tables with load factor 1 and 4 elements per bucket
+	algogin::HashTable<int, int> chained(number);
+	algogin::HashTable<int, int> chainedDense(number / 4);
+	for (int key : keys) {
+		cuckoo.insertOrAssign(key, key);
+		chained.insertOrAssign(key, key);
+		chainedDense.insertOrAssign(key, key);
+	}
+
+	std::shuffle(keys.begin(), keys.end(), generator);
+	printLatency("cuckoo", cuckoo, keys);
+	printLatency("chained, load 1", chained, keys);
+	printLatency("chained, load 4", chainedDense, keys);
+}
+
+BENCHMARK(PerfectHashTable, Build) {
+	const int number = 1'000'000;
+	std::vector<std::pair<uint64_t, uint64_t>> input(number);
+	std::mt19937_64 generator(1);
+	for (auto& [key, value] : input) {
+		key = generator();
+		value = key / 2;
+	}
+
+	algogin::PerfectHashTable<uint64_t, uint64_t> table;
+	benchmark::measure("build", number, [&] {
+		table.build(input);
+	});
+	std::cout << "  metadata: " << table.getMetadataBits() << " bits/key" << std::endl;
+
+	uint64_t sum = 0;
+	benchmark::measure("find", number, [&] {
+		for (auto& [key, value] : input)
+			sum += *table.find(key);
+	});
+
+	table.dump("perfect_benchmark.bin");
+	algogin::PerfectHashTable<uint64_t, uint64_t> loaded;
+	benchmark::measure("load (mmap)", 1, [&] {
+		loaded.load("perfect_benchmark.bin");
+	});
+	benchmark::measure("find (mmap)", number, [&] {
+		for (auto& [key, value] : input)
+			sum += *loaded.find(key);
+	});
+	std::filesystem::remove("perfect_benchmark.bin");
+	benchmark::doNotOptimize(sum);
+}
+
+BENCHMARK(HashTable, Snapshot) {
+	const int number = 2'000'000;
+	algogin::HashTable<uint64_t, uint64_t> table(number);
+	for (uint64_t i = 0; i < number; i++)
+		table.insert(i * 7, i);
+
+	auto tmp = std::filesystem::current_path() / "temp";
+	std::filesystem::create_directory(tmp);
+	benchmark::measure("HashTable dump", number, [&] {
+		table.dump(tmp / "snapshot.bin");
+	});
+	algogin::HashTable<uint64_t, uint64_t> loaded;
+	benchmark::measure("HashTable load", number, [&] {
+		loaded.load(tmp / "snapshot.bin");
+	});
+	algogin::HashTableView<uint64_t, uint64_t> view;
+	double open = benchmark::measure("HashTableView open", 1, [&] {
+		view.open(tmp / "snapshot.bin");
+	});
+	std::cout << "  cold start: " << open / 1e6 << " ms for " << number << " entries" << std::endl;
+
+	uint64_t sum = 0;
+	benchmark::measure("HashTable find", number, [&] {
+		for (uint64_t i = 0; i < number; i++)
+			sum += std::get<1>(loaded.find(i * 7).value());
+	});
+	benchmark::measure("HashTableView find", number, [&] {
+		for (uint64_t i = 0; i < number; i++)
+			sum += view.find(i * 7).value();
+	});
+	benchmark::doNotOptimize(sum);
+	std::filesystem::remove(tmp / "snapshot.bin");
+}
@@ -0,0 +1,453 @@
+#include "Benchmark.h"
+#include "Queue.h"
+#include <queue>
+#include <mutex>
+#include <filesystem>
+
+template <class Queue, class T>
+static double pushPop(const std::string& name, const std::vector<T>& priorities) {
+	Queue queue;
+	int64_t sum = 0;
+	double result = benchmark::measure(name, priorities.size() * 2, [&] {
+		for (int i = 0; i < priorities.size(); i++)
+			queue.insert(priorities[i], i);
+		for (int i = 0; i < priorities.size(); i++)
+			sum += std::get<1>(queue.getMinimum().value());
+	});
+	benchmark::doNotOptimize(sum);
+	return result;
+}
+
+template <class T>
+static void comparePushPop(const std::string& type) {
+	const int number = 1'000'000;
+	std::mt19937 generator(1);
+	std::vector<T> priorities(number);
+	for (auto& priority : priorities)
+		priority = static_cast<T>(generator() % 1'000'000'000);
+
+	std::cout << "  priority " << type << ", " << number << " push + pop" << std::endl;
+	using algogin::HeapLayout;
+	pushPop<algogin::PriorityQueue<T, int>>("binary", priorities);
+	pushPop<algogin::PriorityQueue<T, int, 4>>("4-ary", priorities);
+	pushPop<algogin::PriorityQueue<T, int, 8>>("8-ary", priorities);
+	pushPop<algogin::PriorityQueue<T, int, 2, HeapLayout::SPLIT>>("binary split", priorities);
+	pushPop<algogin::PriorityQueue<T, int, 4, HeapLayout::SPLIT>>("4-ary split", priorities);
+	pushPop<algogin::PriorityQueue<T, int, 8, HeapLayout::SPLIT>>("8-ary split", priorities);
+
+	std::priority_queue<std::pair<T, int>, std::vector<std::pair<T, int>>, std::greater<>> queue;
+	int64_t sum = 0;
+	benchmark::measure("std::priority_queue", number * 2, [&] {
+		for (int i = 0; i < number; i++)
+			queue.push({ priorities[i], i });
+		for (int i = 0; i < number; i++) {
+			sum += queue.top().second;
+			queue.pop();
+		}
+	});
+	benchmark::doNotOptimize(sum);
+}
+
+BENCHMARK(PriorityQueue, PushPop) {
+	comparePushPop<int32_t>("int32");
+	comparePushPop<float>("float");
+	comparePushPop<int64_t>("int64");
+}
+
+BENCHMARK(PriorityQueue, Build) {
+	const int number = 4'000'000;
+	std::mt19937 generator(1);
+	std::vector<std::pair<int, int>> input(number);
+	for (int i = 0; i < number; i++)
+		input[i] = { static_cast<int>(generator()), i };
+
+	int64_t sum = 0;
+	benchmark::measure("insert one by one", number, [&] {
+		algogin::PriorityQueue<int, int> queue;
+		for (auto& [priority, value] : input)
+			queue.insert(priority, value);
+		sum += std::get<1>(queue.top().value());
+	});
+	benchmark::measure("range constructor (heapify)", number, [&] {
+		algogin::PriorityQueue<int, int> queue(input);
+		sum += std::get<1>(queue.top().value());
+	});
+	benchmark::measure("std::make_heap", number, [&] {
+		auto heap = input;
+		std::make_heap(heap.begin(), heap.end(), std::greater<>());
+		sum += heap.front().second;
+	});
+	benchmark::doNotOptimize(sum);
+}
+
+namespace {
+	struct Event {
+		uint64_t sequence;
+		int priority;
+		bool insert;
+	};
+
+	const int RANGE = 1 << 22;
+
+	//average number of elements in queue smaller than deleted one, events are replayed in global order
+	double getRankError(std::vector<std::vector<Event>>& logs, const std::vector<int>& prefill) {
+		std::vector<Event> events;
+		for (auto& log : logs)
+			events.insert(events.end(), log.begin(), log.end());
+		std::sort(events.begin(), events.end(), [](auto& left, auto& right) { return left.sequence < right.sequence; });
+
+		//Fenwick tree over priorities
+		std::vector<int> tree(RANGE + 1);
+		auto add = [&tree](int priority, int delta) {
+			for (int i = priority + 1; i <= RANGE; i += i & -i)
+				tree[i] += delta;
+		};
+		auto countLess = [&tree](int priority) {
+			int count = 0;
+			for (int i = priority; i > 0; i -= i & -i)
+				count += tree[i];
+			return count;
+		};
+
+		for (auto priority : prefill)
+			add(priority, 1);
+		double rank = 0;
+		int deletes = 0;
+		for (auto& event : events) {
+			if (event.insert) {
+				add(event.priority, 1);
+			}
+			else {
+				rank += countLess(event.priority);
+				deletes++;
+				add(event.priority, -1);
+			}
+		}
+
+		return deletes ? rank / deletes : 0;
+	}
+
+	//every thread alternates insert and delete, insert gets priority a bit bigger than the last deleted one
+	//(like scheduler or Dijkstra), if logs aren't null every operation is recorded with global sequence number
+	template <class Queue, class MakeWorker>
+	double runMixed(Queue& queue, MakeWorker makeWorker, int threads, int operations, std::vector<std::vector<Event>>* logs) {
+		std::atomic<uint64_t> sequence = 0;
+		std::vector<std::thread> workers;
+		auto start = std::chrono::steady_clock::now();
+		for (int t = 0; t < threads; t++) {
+			workers.emplace_back([&, t] {
+				auto worker = makeWorker(queue, t);
+				std::mt19937 generator(t);
+				int last = 0;
+				for (int i = 0; i < operations; i++) {
+					auto minimum = worker.getMinimum();
+					if (minimum) {
+						last = std::get<0>(minimum.value());
+						if (logs)
+							(*logs)[t].push_back({ sequence.fetch_add(1), last, false });
+					}
+					int priority = std::min(RANGE - 1, last + static_cast<int>(generator() % 1024));
+					worker.insert(priority, t);
+					if (logs)
+						(*logs)[t].push_back({ sequence.fetch_add(1), priority, true });
+				}
+			});
+		}
+		for (auto& worker : workers)
+			worker.join();
+		auto time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+		return 2.0 * threads * operations / time / 1e6;
+	}
+
+	//single heap under one mutex, the baseline
+	struct LockedQueue {
+		std::mutex mutex;
+		algogin::PriorityQueue<int, int, 4> heap;
+	};
+
+	struct LockedWorker {
+		LockedQueue* queue;
+
+		void insert(int priority, int value) {
+			std::lock_guard lock(queue->mutex);
+			queue->heap.insert(priority, value);
+		}
+
+		std::optional<std::tuple<int, int>> getMinimum() {
+			std::lock_guard lock(queue->mutex);
+			return queue->heap.getMinimum();
+		}
+	};
+}
+
+BENCHMARK(MultiQueue, Threads) {
+	const int prefillSize = 1 << 20;
+	const int operations = 200'000;
+	std::mt19937 generator(1);
+	std::vector<int> prefill(prefillSize);
+	for (auto& priority : prefill)
+		priority = generator() % (RANGE / 2);
+
+	std::vector<int> threadsNumbers;
+	for (int threads = 1; threads <= std::max(4, benchmark::getThreadsNumber()); threads *= 2)
+		threadsNumbers.push_back(threads);
+
+	auto report = [&](const std::string& name, auto create, auto makeWorker) {
+		for (int threads : threadsNumbers) {
+			auto queue = create(threads);
+			{
+				auto worker = makeWorker(*queue, 1000);
+				for (auto priority : prefill)
+					worker.insert(priority, 0);
+			}
+			double throughput = runMixed(*queue, makeWorker, threads, operations, nullptr);
+
+			auto checked = create(threads);
+			{
+				auto worker = makeWorker(*checked, 1000);
+				for (auto priority : prefill)
+					worker.insert(priority, 0);
+			}
+			std::vector<std::vector<Event>> logs(threads);
+			runMixed(*checked, makeWorker, threads, operations / 4, &logs);
+			std::cout << "  " << name << ", " << threads << " threads: " << throughput << " Mop/s, rank error " << getRankError(logs, prefill) << std::endl;
+		}
+	};
+
+	report("locked PriorityQueue", [](int) { return std::make_unique<LockedQueue>(); },
+		[](LockedQueue& queue, int) { return LockedWorker{ &queue }; });
+	for (auto [factor, buffer] : { std::pair{ 2, 1 }, std::pair{ 2, 8 }, std::pair{ 4, 16 } }) {
+		report("MultiQueue c=" + std::to_string(factor) + " buffer=" + std::to_string(buffer),
+			[factor, buffer](int threads) { return std::make_unique<algogin::MultiQueue<int, int>>(threads, factor, buffer); },
+			[](algogin::MultiQueue<int, int>& queue, int seed) { return queue.getWorker(seed); });
+	}
+}
+
+//Dijkstra-like workload: every extracted minimum inserts element with slightly bigger priority
+template <class Queue>
+static void runMonotone(const std::string& name, Queue queue, const std::vector<uint32_t>& prefill, const std::vector<uint32_t>& steps) {
+	uint64_t sum = 0;
+	benchmark::measure(name, prefill.size() + steps.size() * 2, [&] {
+		for (auto priority : prefill)
+			queue.insert(priority, priority);
+		for (auto step : steps) {
+			auto [priority, value] = queue.getMinimum().value();
+			sum += value;
+			queue.insert(priority + step, priority);
+		}
+	});
+	benchmark::doNotOptimize(sum);
+}
+
+BENCHMARK(PriorityQueue, Monotone) {
+	const int size = 1'000'000;
+	const int operations = 4'000'000;
+	std::mt19937 generator(1);
+	std::vector<uint32_t> prefill(size), steps(operations);
+	for (auto& priority : prefill)
+		priority = generator() % size;
+	for (auto& step : steps)
+		step = generator() % 1000;
+
+	runMonotone("PriorityQueue binary", algogin::PriorityQueue<uint32_t, uint32_t>(), prefill, steps);
+	runMonotone("PriorityQueue 4-ary", algogin::PriorityQueue<uint32_t, uint32_t, 4>(), prefill, steps);
+	runMonotone("RadixHeap", algogin::RadixHeap<uint32_t, uint32_t>(), prefill, steps);
+	runMonotone("BucketQueue", algogin::BucketQueue<uint32_t, uint32_t>(size), prefill, steps);
+}
+
+//every tick schedules timers with random delay and cancels 90% of them before expiration (like request timeouts)
+template <class Schedule, class Cancel, class Advance>
+static void runTimers(const std::string& name, Schedule schedule, Cancel cancel, Advance advance) {
+	const int ticks = 100'000;
+	const int perTick = 20;
+	std::mt19937 generator(1);
+	std::vector<decltype(schedule(0, 0))> pending;
+	int64_t fired = 0;
+	benchmark::measure(name, ticks * perTick, [&] {
+		for (uint64_t tick = 1; tick <= ticks; tick++) {
+			for (int i = 0; i < perTick; i++)
+				pending.push_back(schedule(tick + 1 + generator() % 65536, i));
+			//cancel random timers which haven't fired yet
+			for (int i = 0; i < perTick * 9 / 10; i++) {
+				int index = generator() % pending.size();
+				cancel(pending[index]);
+				pending[index] = pending.back();
+				pending.pop_back();
+			}
+			fired += advance(tick);
+		}
+	});
+	benchmark::doNotOptimize(fired);
+}
+
+BENCHMARK(TimerWheel, Cancel) {
+	algogin::TimerWheel<int> wheel;
+	runTimers("TimerWheel",
+		[&](uint64_t expiration, int value) { return wheel.schedule(expiration, value); },
+		[&](algogin::queue::Handle handle) { wheel.cancel(handle); },
+		[&](uint64_t tick) { return wheel.advance(tick, [](uint64_t, int) {}); });
+
+	algogin::PriorityQueue<uint64_t, int> heap;
+	runTimers("PriorityQueue with erase",
+		[&](uint64_t expiration, int value) { return heap.insert(expiration, value); },
+		[&](algogin::queue::Handle handle) { heap.erase(handle); },
+		[&](uint64_t tick) {
+			int count = 0;
+			while (heap.getSize() > 0 && std::get<0>(heap.top().value()) <= tick) {
+				heap.getMinimum();
+				count++;
+			}
+			return count;
+		});
+
+	//cancelled timers stay in heap and are skipped when they reach the top
+	algogin::PriorityQueue<uint64_t, int> lazy;
+	std::vector<bool> cancelled;
+	runTimers("PriorityQueue with lazy cancel",
+		[&](uint64_t expiration, int value) {
+			cancelled.push_back(false);
+			lazy.insert(expiration, static_cast<int>(cancelled.size()) - 1);
+			return static_cast<int>(cancelled.size()) - 1;
+		},
+		[&](int id) { cancelled[id] = true; },
+		[&](uint64_t tick) {
+			int count = 0;
+			while (lazy.getSize() > 0 && std::get<0>(lazy.top().value()) <= tick)
+				count += cancelled[std::get<1>(lazy.getMinimum().value())] == false;
+			return count;
+		});
+}
+
+//merge of many queues into one: pairing heaps are melded, binary heaps have to move elements one by one
+BENCHMARK(PairingHeap, Meld) {
+	const int queues = 64;
+	const int size = 1'000'000;
+	std::mt19937 generator(1);
+	{
+		std::vector<algogin::PairingHeap<uint32_t, uint32_t>> heaps(queues);
+		benchmark::measure("PairingHeap insert", queues * size, [&] {
+			for (auto& heap : heaps)
+				for (int i = 0; i < size; i++)
+					heap.insert(generator(), i);
+		});
+		benchmark::measure("PairingHeap meld, per queue", queues - 1, [&] {
+			for (int i = 1; i < queues; i++)
+				heaps[0].meld(heaps[i]);
+		});
+		int64_t sum = 0;
+		benchmark::measure("PairingHeap pop after meld (first pop pairs all inserted nodes)", size, [&] {
+			for (int i = 0; i < size; i++)
+				sum += std::get<1>(heaps[0].getMinimum().value());
+		});
+		benchmark::doNotOptimize(sum);
+	}
+
+	std::vector<algogin::PriorityQueue<uint32_t, uint32_t>> heaps(queues);
+	benchmark::measure("PriorityQueue insert", queues * size, [&] {
+		for (auto& heap : heaps)
+			for (int i = 0; i < size; i++)
+				heap.insert(generator(), i);
+	});
+	benchmark::measure("PriorityQueue pop + insert, per queue", queues - 1, [&] {
+		uint32_t priority, value;
+		for (int i = 1; i < queues; i++) {
+			while (heaps[i].popInto(priority, value) == algogin::ALGOGIN_ERROR::OK)
+				heaps[0].insert(priority, value);
+			heaps[i] = algogin::PriorityQueue<uint32_t, uint32_t>();
+		}
+	});
+	int64_t sum = 0;
+	benchmark::measure("PriorityQueue pop after merge", size, [&] {
+		for (int i = 0; i < size; i++)
+			sum += std::get<1>(heaps[0].getMinimum().value());
+	});
+	benchmark::doNotOptimize(sum);
+}
+
+//queue 8x bigger than memory budget: insert everything, then drain
+BENCHMARK(ExternalPriorityQueue, Drain) {
+	const int number = 16'000'000;
+	std::mt19937 generator(1);
+	std::vector<uint32_t> priorities(number);
+	for (auto& priority : priorities)
+		priority = generator();
+
+	auto directory = std::filesystem::current_path() / "temp";
+	std::filesystem::create_directory(directory);
+	algogin::ExternalPriorityQueue<uint32_t, uint32_t> queue({ .memory = 16 << 20, .blockSize = 1 << 20, .directory = directory });
+	benchmark::measure("ExternalPriorityQueue insert, 16 MB memory", number, [&] {
+		for (int i = 0; i < number; i++)
+			queue.insert(priorities[i], i);
+	});
+	std::cout << "  runs on disk: " << queue.getRuns() << std::endl;
+	int64_t sum = 0;
+	benchmark::measure("ExternalPriorityQueue pop", number, [&] {
+		uint32_t value;
+		while (queue.popInto(value) == algogin::ALGOGIN_ERROR::OK)
+			sum += value;
+	});
+
+	algogin::PriorityQueue<uint32_t, uint32_t, 4> memory;
+	benchmark::measure("PriorityQueue 4-ary insert, in memory", number, [&] {
+		for (int i = 0; i < number; i++)
+			memory.insert(priorities[i], i);
+	});
+	benchmark::measure("PriorityQueue 4-ary pop, in memory", number, [&] {
+		uint32_t value;
+		while (memory.popInto(value) == algogin::ALGOGIN_ERROR::OK)
+			sum += value;
+	});
+	benchmark::doNotOptimize(sum);
+}
+
+//top 1000 of 50M scores: bounded selector against PriorityQueue which is trimmed after every insert
+BENCHMARK(TopK, Offer) {
+	const int number = 50'000'000;
+	const int capacity = 1000;
+	std::mt19937 generator(1);
+	std::vector<float> scores(number);
+	std::vector<int> items(number);
+	for (int i = 0; i < number; i++) {
+		scores[i] = std::uniform_real_distribution<float>()(generator);
+		items[i] = i;
+	}
+
+	int64_t sum = 0;
+	algogin::TopK<float, int> single(capacity);
+	benchmark::measure("TopK offer", number, [&] {
+		for (int i = 0; i < number; i++)
+			sum += single.offer(scores[i], items[i]) == algogin::ALGOGIN_ERROR::OK;
+	});
+	algogin::TopK<float, int> batch(capacity);
+	benchmark::measure("TopK offerBatch", number, [&] {
+		sum += batch.offerBatch(scores, items);
+	});
+
+	int threads = benchmark::getThreadsNumber();
+	algogin::TopK<float, int> merged(capacity);
+	benchmark::measure("TopK offerBatch + merge, " + std::to_string(threads) + " threads", number, [&] {
+		std::vector<algogin::TopK<float, int>> partial(threads, algogin::TopK<float, int>(capacity));
+		std::vector<std::thread> workers;
+		for (int t = 0; t < threads; t++) {
+			workers.emplace_back([&, t] {
+				size_t begin = static_cast<size_t>(number) * t / threads, end = static_cast<size_t>(number) * (t + 1) / threads;
+				partial[t].offerBatch(std::span<const float>(scores).subspan(begin, end - begin), std::span<const int>(items).subspan(begin, end - begin));
+			});
+		}
+		for (auto& worker : workers)
+			worker.join();
+		for (auto& part : partial)
+			merged.merge(std::move(part));
+	});
+
+	algogin::PriorityQueue<float, int> queue;
+	benchmark::measure("PriorityQueue insert + pop excess", number, [&] {
+		for (int i = 0; i < number; i++) {
+			queue.insert(scores[i], items[i]);
+			if (queue.getSize() > capacity)
+				queue.getMinimum();
+		}
+	});
+	benchmark::doNotOptimize(sum);
+}
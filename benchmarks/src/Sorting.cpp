@@ -0,0 +1,251 @@
+#include "Benchmark.h"
+#include "Sorting.h"
+
+//distributions which break naive pivot selection
+static std::vector<std::pair<std::string, std::vector<int>>> generateDistributions(int number) {
+	std::mt19937 generator(1);
+	std::vector<int> random(number), sorted(number), reverse(number), organ(number), duplicates(number);
+	for (int i = 0; i < number; i++) {
+		random[i] = generator();
+		sorted[i] = i;
+		reverse[i] = number - i;
+		organ[i] = i < number / 2 ? i : number - i;
+		duplicates[i] = generator() % 16;
+	}
+
+	return { { "random", random }, { "sorted", sorted }, { "reverse", reverse }, { "organ-pipe", organ }, { "16 distinct", duplicates } };
+}
+
+BENCHMARK(Sorting, QuickSort) {
+	const int number = 10'000'000;
+	Sorting sorting;
+	for (auto& [name, input] : generateDistributions(number)) {
+		std::cout << "  " << name << std::endl;
+		int64_t sum = 0;
+		std::vector<int> output(input);
+		benchmark::measure("Sorting::quickSort, by value", number, [&] {
+			sum += sorting.quickSort(input)[number / 2];
+		});
+		benchmark::measure("Sorting::quickSort, in place", number, [&] {
+			sorting.quickSort(std::span<int>(output));
+		});
+		output = input;
+		benchmark::measure("Sorting::mergeSort, in place", number, [&] {
+			sorting.mergeSort(output.begin(), output.end());
+		});
+		output = input;
+		benchmark::measure("Sorting::sampleSort, in place", number, [&] {
+			sorting.sampleSort(output.begin(), output.end());
+		});
+		output = input;
+		benchmark::measure("std::sort", number, [&] {
+			std::sort(output.begin(), output.end());
+		});
+		sum += output[number / 2];
+		benchmark::doNotOptimize(sum);
+	}
+}
+
+//threads: powers of two up to hardware concurrency
+static std::vector<int> getThreadCounts() {
+	std::vector<int> counts;
+	for (int threads = 1; threads < benchmark::getThreadsNumber(); threads *= 2)
+		counts.push_back(threads);
+	counts.push_back(benchmark::getThreadsNumber());
+	return counts;
+}
+
+BENCHMARK(Sorting, ParallelMergeSort) {
+	const int number = 50'000'000;
+	std::mt19937_64 generator(1);
+	std::vector<uint64_t> input(number);
+	for (auto& value : input)
+		value = generator();
+
+	Sorting sorting;
+	std::vector<uint64_t> output(input);
+	benchmark::measure("Sorting::mergeSort", number, [&] {
+		sorting.mergeSort(output.begin(), output.end());
+	});
+	for (int threads : getThreadCounts()) {
+		algogin::ThreadPool pool(threads);
+		output = input;
+		benchmark::measure("Sorting::parallelMergeSort, " + std::to_string(threads) + " threads", number, [&] {
+			sorting.parallelMergeSort(output.begin(), output.end(), pool);
+		});
+	}
+	output = input;
+	benchmark::measure("std::stable_sort", number, [&] {
+		std::stable_sort(output.begin(), output.end());
+	});
+	benchmark::doNotOptimize(output[number / 2]);
+}
+
+BENCHMARK(Sorting, ParallelSampleSort) {
+	const int number = 50'000'000;
+	std::mt19937_64 generator(1);
+	std::vector<uint64_t> input(number);
+	for (auto& value : input)
+		value = generator();
+
+	Sorting sorting;
+	std::vector<uint64_t> output(input);
+	benchmark::measure("Sorting::quickSort", number, [&] {
+		sorting.quickSort(output.begin(), output.end());
+	});
+	output = input;
+	benchmark::measure("Sorting::sampleSort", number, [&] {
+		sorting.sampleSort(output.begin(), output.end());
+	});
+	for (int threads : getThreadCounts()) {
+		algogin::ThreadPool pool(threads);
+		output = input;
+		benchmark::measure("Sorting::parallelSampleSort, " + std::to_string(threads) + " threads", number, [&] {
+			sorting.parallelSampleSort(output.begin(), output.end(), pool);
+		});
+		output = input;
+		benchmark::measure("Sorting::parallelMergeSort, " + std::to_string(threads) + " threads", number, [&] {
+			sorting.parallelMergeSort(output.begin(), output.end(), pool);
+		});
+	}
+	output = input;
+	benchmark::measure("std::sort", number, [&] {
+		std::sort(output.begin(), output.end());
+	});
+	benchmark::doNotOptimize(output[number / 2]);
+}
+
+template <class T>
+static void measureRadixSort(const std::string& name, const std::vector<T>& input) {
+	const int number = static_cast<int>(input.size());
+	Sorting sorting;
+	std::cout << "  " << name << std::endl;
+	std::vector<T> output(input);
+	benchmark::measure("Sorting::radixSort", number, [&] {
+		sorting.radixSort(output.begin(), output.end());
+	});
+	output = input;
+	benchmark::measure("Sorting::radixSort, 8-bit digits", number, [&] {
+		sorting.radixSort<8>(output.begin(), output.end());
+	});
+	output = input;
+	benchmark::measure("Sorting::msdRadixSort", number, [&] {
+		sorting.msdRadixSort(output.begin(), output.end());
+	});
+	for (int threads : getThreadCounts()) {
+		algogin::ThreadPool pool(threads);
+		output = input;
+		benchmark::measure("Sorting::parallelRadixSort, " + std::to_string(threads) + " threads", number, [&] {
+			sorting.parallelRadixSort(output.begin(), output.end(), pool);
+		});
+	}
+	output = input;
+	benchmark::measure("Sorting::sampleSort", number, [&] {
+		sorting.sampleSort(output.begin(), output.end());
+	});
+	output = input;
+	benchmark::measure("std::sort", number, [&] {
+		std::sort(output.begin(), output.end());
+	});
+	benchmark::doNotOptimize(output[number / 2]);
+}
+
+BENCHMARK(Sorting, RadixSort) {
+	const int number = 20'000'000;
+	std::mt19937_64 generator(1);
+	std::vector<uint32_t> keys32(number);
+	std::vector<uint64_t> keys64(number), narrow(number);
+	std::vector<double> doubles(number);
+	for (int i = 0; i < number; i++) {
+		keys32[i] = static_cast<uint32_t>(generator());
+		keys64[i] = generator();
+		//high bytes are constant, their passes are skipped
+		narrow[i] = generator() % 1'000'000;
+		doubles[i] = std::uniform_real_distribution<double>(-1e9, 1e9)(generator);
+	}
+
+	measureRadixSort("uint32", keys32);
+	measureRadixSort("uint64", keys64);
+	measureRadixSort("uint64 below 10^6", narrow);
+	measureRadixSort("double", doubles);
+}
+
+template <class T>
+static void measureNetwork(const std::string& name) {
+	const int number = 1 << 22;
+	std::mt19937_64 generator(1);
+	std::vector<T> input(number);
+	for (auto& value : input)
+		value = static_cast<T>(static_cast<int64_t>(generator() >> 1));
+
+	Sorting sorting;
+	std::cout << "  " << name << std::endl;
+	for (int size : { 16, 64, 256 }) {
+		std::vector<T> output(input);
+		std::string suffix = ", blocks of " + std::to_string(size);
+		for (auto [level, levelName] : { std::pair{ algogin::network::Level::AVX2, "AVX2" }, std::pair{ algogin::network::Level::AVX512, "AVX-512" } }) {
+			output = input;
+			benchmark::measure(std::string("network::sort, ") + levelName + suffix, number, [&] {
+				for (int i = 0; i < number; i += size)
+					algogin::network::sort(output.data() + i, size, level);
+			});
+		}
+		output = input;
+		benchmark::measure("Sorting::insertionSort" + suffix, number, [&] {
+			for (int i = 0; i < number; i += size)
+				sorting.insertionSort(output.begin() + i, output.begin() + i + size);
+		});
+		output = input;
+		benchmark::measure("std::sort" + suffix, number, [&] {
+			for (int i = 0; i < number; i += size)
+				std::sort(output.begin() + i, output.begin() + i + size);
+		});
+		benchmark::doNotOptimize(output[number / 2]);
+	}
+}
+
+BENCHMARK(Sorting, Network) {
+	std::cout << "  CPU level: " << static_cast<int>(algogin::network::getLevel()) << std::endl;
+	measureNetwork<int32_t>("int32");
+	measureNetwork<int64_t>("int64");
+	measureNetwork<float>("float");
+}
+
+BENCHMARK(Sorting, PowerSort) {
+	const int number = 10'000'000;
+	std::mt19937 generator(1);
+	std::vector<int> sorted(number), inserts(number), log(number), random(number);
+	for (int i = 0; i < number; i++) {
+		sorted[i] = i;
+		random[i] = generator();
+		//appended log: every element is late by a few positions
+		log[i] = i + static_cast<int>(generator() % 16);
+	}
+	//sorted with 0.1% of elements replaced by random values
+	inserts = sorted;
+	for (int i = 0; i < number / 1000; i++)
+		inserts[generator() % number] = generator() % number;
+
+	Sorting sorting;
+	for (auto& [name, input] : { std::pair{ "sorted", sorted }, std::pair{ "sorted + 0.1% random", inserts },
+								 std::pair{ "log with local reordering", log }, std::pair{ "random", random } }) {
+		std::cout << "  " << name << std::endl;
+		std::vector<int> output(input);
+		benchmark::measure("Sorting::powerSort", number, [&] {
+			sorting.powerSort(output.begin(), output.end());
+		});
+		output = input;
+		benchmark::measure("Sorting::mergeSort", number, [&] {
+			sorting.mergeSort(output.begin(), output.end());
+		});
+		output = input;
+		benchmark::measure("std::stable_sort", number, [&] {
+			std::stable_sort(output.begin(), output.end());
+		});
+		output = input;
+		benchmark::measure("std::sort", number, [&] {
+			std::sort(output.begin(), output.end());
+		});
+		benchmark::doNotOptimize(output[number / 2]);
+	}
+}
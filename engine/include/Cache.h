@@ -0,0 +1,358 @@
+#pragma once
+#include "Common.h"
+#include "Dictionary.h"
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace algogin {
+	enum class CachePolicy {
+		//evict least recently used entry
+		LRU,
+		//approximation of LRU: entries have referenced bit, hand sweeps entries and evicts the first one without the bit
+		CLOCK,
+		//LRU eviction, but new entry is admitted only if it's accessed more often than the victim
+		TINY_LFU
+	};
+
+	template <class Comparable, class V>
+	struct CacheOptions {
+		//maximum total weight of entries, every shard gets equal part of it
+		size_t capacity = 1024;
+		CachePolicy policy = CachePolicy::LRU;
+		//number of independently locked parts (0 - depends on hardware concurrency and maxWeight),
+		//entry heavier than capacity / shards is rejected
+		int shards = 0;
+		//entries older than ttl are expired (0 - never)
+		std::chrono::steady_clock::duration ttl = std::chrono::steady_clock::duration::zero();
+		//weight of entry, e.g. size in bytes (empty - every entry has weight 1, so capacity is number of entries)
+		std::function<size_t(const Comparable&, const V&)> weigher;
+		//weight of the heaviest entry, default number of shards is lowered so every shard can keep it (0 - capacity / 16)
+		size_t maxWeight = 0;
+	};
+
+	//Count-min sketch with 4 rows of counters saturated at 15, estimates how often key was accessed recently.
+	//All counters are halved periodically so old popularity fades out.
+	class FrequencySketch {
+	private:
+		static constexpr int ROWS = 4;
+		static constexpr uint8_t MAX_COUNTER = 15;
+
+		std::vector<uint8_t> _counters;
+		uint64_t _mask = 0;
+		size_t _additions = 0;
+		size_t _sampleSize = 0;
+
+		uint64_t _getIndex(uint64_t hash, int row) const noexcept {
+			return row * (_mask + 1) + (hashing::mix(hash + row) & _mask);
+		}
+	public:
+		FrequencySketch(size_t size = 16) {
+			uint64_t width = std::bit_ceil(std::max<uint64_t>(16, size));
+			_counters.resize(width * ROWS);
+			_mask = width - 1;
+			_sampleSize = width * 10;
+		}
+
+		void increment(uint64_t hash) noexcept {
+			for (int row = 0; row < ROWS; row++) {
+				auto& counter = _counters[_getIndex(hash, row)];
+				if (counter < MAX_COUNTER)
+					counter++;
+			}
+
+			if (++_additions >= _sampleSize) {
+				for (auto& counter : _counters)
+					counter >>= 1;
+				_additions /= 2;
+			}
+		}
+
+		int estimate(uint64_t hash) const noexcept {
+			int frequency = MAX_COUNTER;
+			for (int row = 0; row < ROWS; row++)
+				frequency = std::min<int>(frequency, _counters[_getIndex(hash, row)]);
+
+			return frequency;
+		}
+	};
+
+	//Bounded thread-safe cache: keys are distributed between independently locked shards,
+	//every shard has HashTable index from key to entry and own eviction state (LRU list, CLOCK hand, frequency sketch).
+	//Index doubles its buckets when it has more than LOAD_FACTOR entries per bucket, so weighted caches with
+	//unknown number of entries keep short chains
+	template <class Comparable, class V, class Hasher = Hash<Comparable>>
+	class Cache {
+	private:
+		using Clock = std::chrono::steady_clock;
+		static constexpr int LOAD_FACTOR = 2;
+
+		struct Entry {
+			Comparable key;
+			V value;
+			size_t weight = 0;
+			Clock::time_point expiration;
+			//LRU list links (indexes in entries)
+			int previous = -1;
+			int next = -1;
+			bool referenced = false;
+			bool used = false;
+		};
+
+		struct alignas(64) Shard {
+			std::mutex mutex;
+			HashTable<Comparable, int, Hasher> index;
+			std::vector<Entry> entries;
+			std::vector<int> free;
+			//head - the most recently used entry
+			int head = -1;
+			int tail = -1;
+			int hand = 0;
+			size_t weight = 0;
+			size_t capacity = 0;
+			FrequencySketch sketch;
+			//hash of the last key missed by get: put of this key is the same request and isn't counted again
+			std::optional<uint64_t> missed;
+		};
+
+		CacheOptions<Comparable, V> _options;
+		std::vector<std::unique_ptr<Shard>> _shards;
+		Hasher _hasher;
+
+		void _unlink(Shard& shard, int index) noexcept {
+			auto& entry = shard.entries[index];
+			if (entry.previous >= 0)
+				shard.entries[entry.previous].next = entry.next;
+			else
+				shard.head = entry.next;
+			if (entry.next >= 0)
+				shard.entries[entry.next].previous = entry.previous;
+			else
+				shard.tail = entry.previous;
+			entry.previous = entry.next = -1;
+		}
+
+		void _pushFront(Shard& shard, int index) noexcept {
+			auto& entry = shard.entries[index];
+			entry.previous = -1;
+			entry.next = shard.head;
+			if (shard.head >= 0)
+				shard.entries[shard.head].previous = index;
+			shard.head = index;
+			if (shard.tail < 0)
+				shard.tail = index;
+		}
+
+		void _touch(Shard& shard, int index) noexcept {
+			if (_options.policy == CachePolicy::CLOCK) {
+				shard.entries[index].referenced = true;
+			}
+			else if (shard.head != index) {
+				_unlink(shard, index);
+				_pushFront(shard, index);
+			}
+		}
+
+		void _erase(Shard& shard, int index) {
+			auto& entry = shard.entries[index];
+			if (_options.policy != CachePolicy::CLOCK)
+				_unlink(shard, index);
+			shard.index.remove(entry.key);
+			shard.weight -= entry.weight;
+			entry = Entry();
+			shard.free.push_back(index);
+		}
+
+		int _findVictim(Shard& shard) noexcept {
+			if (_options.policy != CachePolicy::CLOCK)
+				return shard.tail;
+
+			//second chance: referenced entries lose the bit and are skipped, every entry is visited at most twice
+			while (true) {
+				if (shard.hand >= shard.entries.size())
+					shard.hand = 0;
+				auto& entry = shard.entries[shard.hand];
+				if (entry.used) {
+					if (entry.referenced == false)
+						return shard.hand++;
+					entry.referenced = false;
+				}
+				shard.hand++;
+			}
+		}
+
+		Shard& _getShard(uint64_t hash) const noexcept {
+			//index takes bucket from hash modulo, so shard is taken from high bits of mixed hash
+			hash = hashing::mix(hash);
+			uint64_t shard = _shards.size();
+			hashing::multiply(hash, shard);
+			return *_shards[shard];
+		}
+
+		//TinyLFU counts one access per request: get which missed and put which fills the miss are one request
+		void _recordAccess(Shard& shard, uint64_t hash, bool miss) noexcept {
+			if (_options.policy != CachePolicy::TINY_LFU)
+				return;
+
+			if (miss) {
+				shard.missed = hash;
+			}
+			else if (shard.missed == hash) {
+				shard.missed.reset();
+				return;
+			}
+			shard.sketch.increment(hash);
+		}
+
+		size_t _getWeight(const Comparable& key, const V& value) const {
+			return _options.weigher ? _options.weigher(key, value) : 1;
+		}
+	public:
+		Cache(CacheOptions<Comparable, V> options) : _options(std::move(options)) {
+			int shards = _options.shards;
+			if (shards <= 0) {
+				shards = std::max(1u, std::thread::hardware_concurrency()) * 4;
+				if (_options.weigher) {
+					size_t maxWeight = _options.maxWeight ? _options.maxWeight : _options.capacity / 16;
+					shards = static_cast<int>(std::min<size_t>(shards, _options.capacity / std::max<size_t>(1, maxWeight)));
+				}
+			}
+			//every shard should be able to keep at least one entry
+			shards = static_cast<int>(std::max<size_t>(1, std::min<size_t>(shards, _options.capacity)));
+
+			for (int i = 0; i < shards; i++) {
+				auto shard = std::make_unique<Shard>();
+				shard->capacity = _options.capacity / shards + (i < _options.capacity % shards ? 1 : 0);
+				//number of entries is unknown for weighted cache, index starts for average weight 64 and grows
+				size_t entries = _options.weigher ? std::max<size_t>(1, shard->capacity / 64) : shard->capacity;
+				shard->index = HashTable<Comparable, int, Hasher>(static_cast<int>(entries));
+				shard->sketch = FrequencySketch(entries);
+				_shards.push_back(std::move(shard));
+			}
+		}
+
+		Cache(const Cache&) = delete;
+		Cache& operator=(const Cache&) = delete;
+		~Cache() = default;
+
+		std::optional<V> get(const Comparable& key) {
+			uint64_t hash = _hasher(key);
+			auto& shard = _getShard(hash);
+			std::lock_guard lock(shard.mutex);
+			auto found = shard.index.find(key);
+			if (found.has_value() == false) {
+				_recordAccess(shard, hash, true);
+				return std::nullopt;
+			}
+
+			int index = std::get<1>(found.value());
+			auto& entry = shard.entries[index];
+			if (_options.ttl != Clock::duration::zero() && entry.expiration <= Clock::now()) {
+				_erase(shard, index);
+				_recordAccess(shard, hash, true);
+				return std::nullopt;
+			}
+
+			_recordAccess(shard, hash, false);
+			_touch(shard, index);
+			return entry.value;
+		}
+
+		//returns REJECTED if entry is heavier than shard or TinyLFU decides that entry is less popular than victim
+		ALGOGIN_ERROR put(Comparable key, V value) {
+			uint64_t hash = _hasher(key);
+			auto& shard = _getShard(hash);
+			size_t weight = _getWeight(key, value);
+			auto expiration = Clock::now() + _options.ttl;
+			std::lock_guard lock(shard.mutex);
+			if (weight > shard.capacity)
+				return ALGOGIN_ERROR::REJECTED;
+
+			auto found = shard.index.find(key);
+			_recordAccess(shard, hash, false);
+			if (found.has_value()) {
+				int index = std::get<1>(found.value());
+				auto& entry = shard.entries[index];
+				shard.weight = shard.weight - entry.weight + weight;
+				entry.value = std::move(value);
+				entry.weight = weight;
+				entry.expiration = expiration;
+				_touch(shard, index);
+				//updated entry can be heavier than previous one
+				while (shard.weight > shard.capacity)
+					_erase(shard, _findVictim(shard));
+				return ALGOGIN_ERROR::OK;
+			}
+
+			if (_options.policy == CachePolicy::TINY_LFU && shard.weight + weight > shard.capacity) {
+				int victim = _findVictim(shard);
+				if (shard.sketch.estimate(hash) <= shard.sketch.estimate(_hasher(shard.entries[victim].key)))
+					return ALGOGIN_ERROR::REJECTED;
+			}
+
+			while (shard.weight + weight > shard.capacity)
+				_erase(shard, _findVictim(shard));
+
+			int index;
+			if (shard.free.empty() == false) {
+				index = shard.free.back();
+				shard.free.pop_back();
+			}
+			else {
+				index = static_cast<int>(shard.entries.size());
+				shard.entries.push_back(Entry());
+			}
+
+			auto& entry = shard.entries[index];
+			entry.key = key;
+			entry.value = std::move(value);
+			entry.weight = weight;
+			entry.expiration = expiration;
+			entry.used = true;
+			//new entry gets no referenced bit, it's evicted first if it isn't accessed again
+			entry.referenced = false;
+			if (_options.policy != CachePolicy::CLOCK)
+				_pushFront(shard, index);
+			shard.index.insert(std::move(key), index);
+			if (shard.index.getSize() > static_cast<int64_t>(shard.index.getBucketCount()) * LOAD_FACTOR)
+				shard.index.rehash(shard.index.getBucketCount() * 2);
+			shard.weight += weight;
+
+			return ALGOGIN_ERROR::OK;
+		}
+
+		ALGOGIN_ERROR remove(const Comparable& key) {
+			auto& shard = _getShard(_hasher(key));
+			std::lock_guard lock(shard.mutex);
+			auto found = shard.index.find(key);
+			if (found.has_value() == false)
+				return ALGOGIN_ERROR::NOT_FOUND;
+
+			_erase(shard, std::get<1>(found.value()));
+			return ALGOGIN_ERROR::OK;
+		}
+
+		//number of entries, expired but not accessed entries are counted too
+		int getSize() const {
+			int size = 0;
+			for (auto& shard : _shards) {
+				std::lock_guard lock(shard->mutex);
+				size += shard->index.getSize();
+			}
+
+			return size;
+		}
+
+		size_t getWeight() const {
+			size_t weight = 0;
+			for (auto& shard : _shards) {
+				std::lock_guard lock(shard->mutex);
+				weight += shard->weight;
+			}
+
+			return weight;
+		}
+	};
+}
@@ -1,5 +1,9 @@
 #pragma once
 #include <iostream>
+#include <cstdint>
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>
+#endif
 
 namespace algogin {
 	enum class ALGOGIN_ERROR : uint8_t {
@@ -7,10 +11,20 @@ namespace algogin {
 		OUT_OF_BOUNDS,
 		NOT_FOUND,
 		WRONG_KEY,
+		REJECTED,
 		UNKNOWN_ERROR
 	};
 
 	enum class TraversalMode {
 		LEVEL_ORDER
 	};
+
+	//hint CPU to load cache line with address, so independent memory accesses can overlap
+	inline void prefetch(const void* address) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+		__builtin_prefetch(address);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+		_mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+#endif
+	}
 }
\ No newline at end of file
@@ -7,6 +7,23 @@
 #include <functional>
 #include <type_traits>
 #include <cmath>
+#include <utility>
+#include <vector>
+#include <string>
+#include <shared_mutex>
+#include <mutex>
+#include <thread>
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <ranges>
+#include <span>
+#include <fstream>
+#include <filesystem>
+#include <cstring>
+#include <initializer_list>
+#include "Hash.h"
+#include "MappedFile.h"
 
 namespace algogin {
 
@@ -583,6 +600,49 @@ namespace algogin {
 			return target->value;
 		}
 
+		//find for many keys at once: descents for group of keys are interleaved, on every step the next node is prefetched
+		//and other keys are processed while it's loaded, so cache misses of independent lookups overlap
+		ALGOGIN_ERROR findBatch(std::span<const Comparable> keys, std::span<std::optional<V>> values) const {
+			if (keys.size() != values.size())
+				return ALGOGIN_ERROR::OUT_OF_BOUNDS;
+
+			constexpr int GROUP = 16;
+			Tree* nodes[GROUP];
+			for (size_t start = 0; start < keys.size(); start += GROUP) {
+				int size = static_cast<int>(std::min<size_t>(GROUP, keys.size() - start));
+				for (int i = 0; i < size; i++) {
+					nodes[i] = _head.get();
+					values[start + i] = std::nullopt;
+				}
+
+				int active = size;
+				while (active > 0) {
+					active = 0;
+					for (int i = 0; i < size; i++) {
+						Tree* node = nodes[i];
+						if (node == nullptr)
+							continue;
+
+						const Comparable& key = keys[start + i];
+						if (key == node->key) {
+							values[start + i] = node->value;
+							nodes[i] = nullptr;
+							continue;
+						}
+
+						node = key < node->key ? node->left.get() : node->right.get();
+						if (node) {
+							prefetch(node);
+							active++;
+						}
+						nodes[i] = node;
+					}
+				}
+			}
+
+			return ALGOGIN_ERROR::OK;
+		}
+
 		int getSize() noexcept {
 			return _size;
 		}
@@ -1022,34 +1082,139 @@ namespace algogin {
 		}
 	};
 
-	template <class Comparable, class V>
+	//Layout of flat files which are mapped to memory and queried in place: header, then sections of trivially copyable
+	//elements, every section starts at offset aligned to 64 bytes
+	namespace snapshot {
+		constexpr size_t ALIGNMENT = 64;
+
+		struct Section {
+			uint64_t offset;
+			const void* data;
+			uint64_t size;
+		};
+
+		inline uint64_t align(uint64_t offset) noexcept {
+			return (offset + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+		}
+
+		//writes sections sorted by offset (header is section at 0), gaps between them are filled by zeros
+		inline ALGOGIN_ERROR write(const std::filesystem::path& path, std::initializer_list<Section> sections) {
+			std::ofstream file{ path, std::ios::binary };
+			if (file.is_open() == false)
+				return ALGOGIN_ERROR::UNKNOWN_ERROR;
+
+			static const char zeros[ALIGNMENT] = {};
+			uint64_t end = 0;
+			for (auto& section : sections) {
+				file.write(zeros, section.offset - end);
+				file.write(static_cast<const char*>(section.data), section.size);
+				end = section.offset + section.size;
+			}
+
+			return file.good() ? ALGOGIN_ERROR::OK : ALGOGIN_ERROR::UNKNOWN_ERROR;
+		}
+
+		//section has to be aligned and lie between end of previous section and limit, sizes are compared
+		//by division so corrupted header can't overflow them; moves end behind the section
+		inline bool checkSection(uint64_t offset, uint64_t count, uint64_t elementSize, uint64_t& end, uint64_t limit) noexcept {
+			if (offset % ALIGNMENT != 0 || offset < end || offset > limit || count > (limit - offset) / elementSize)
+				return false;
+
+			end = offset + count * elementSize;
+			return true;
+		}
+	}
+
+	//Flat snapshot of HashTable (see snapshot): header, bucket offsets (bucketCount + 1), keys and values grouped
+	//by bucket, file can be mapped to memory and queried in place (see HashTableView)
+	struct HashTableSnapshot {
+		static constexpr uint64_t MAGIC = 0x3153544841474c41ull; //"ALGAHTS1"
+		static constexpr uint32_t VERSION = 1;
+
+		struct Header {
+			uint64_t magic;
+			uint32_t version;
+			uint32_t keySize;
+			uint32_t valueSize;
+			uint32_t reserved;
+			uint64_t size;
+			uint64_t bucketCount;
+			uint64_t offsetsOffset;
+			uint64_t keysOffset;
+			uint64_t valuesOffset;
+		};
+
+		//checks header, sections and bucket offsets, returns nullptr if mapping doesn't contain valid snapshot
+		template <class Comparable, class V>
+		static const Header* validate(const MappedFile& mapping) noexcept {
+			if (mapping.getSize() < sizeof(Header))
+				return nullptr;
+
+			auto header = reinterpret_cast<const Header*>(mapping.getData());
+			if (header->magic != MAGIC || header->version != VERSION || header->keySize != sizeof(Comparable) || header->valueSize != sizeof(V) ||
+				header->size > INT32_MAX || header->bucketCount == UINT64_MAX || (header->bucketCount == 0 && header->size > 0))
+				return nullptr;
+
+			uint64_t end = sizeof(Header);
+			if (snapshot::checkSection(header->offsetsOffset, header->bucketCount + 1, sizeof(uint64_t), end, mapping.getSize()) == false ||
+				snapshot::checkSection(header->keysOffset, header->size, sizeof(Comparable), end, mapping.getSize()) == false ||
+				snapshot::checkSection(header->valuesOffset, header->size, sizeof(V), end, mapping.getSize()) == false)
+				return nullptr;
+
+			//buckets are ranges of keys: offsets go from 0 to size without decreasing
+			auto offsets = reinterpret_cast<const uint64_t*>(mapping.getData() + header->offsetsOffset);
+			if (offsets[0] != 0 || offsets[header->bucketCount] != header->size ||
+				std::is_sorted(offsets, offsets + header->bucketCount + 1) == false)
+				return nullptr;
+
+			return header;
+		}
+	};
+
+	//Hash table with separate chaining, Hasher maps key to 64 bit value (see Hash.h)
+	template <class Comparable, class V, class Hasher = Hash<Comparable>>
 	class HashTable {
 	private:
 		std::vector<std::list<std::tuple<Comparable, V>>> _hashTable;
+		Hasher _hasher;
+		int _size = 0;
 
-		int _getIndex(Comparable key) {
-			int index = -1;
-			if constexpr (std::is_same_v<Comparable, int>) {
-				float m = 0.5f * (sqrt(5) - 1.f);
-				float s = (float)key * m;
-				float f = s - floor(s);
-				index = floor(f * _hashTable.size());
-			}
-			else if constexpr (std::is_same_v<Comparable, std::string>) {
-				//can be used std::hash
-				//std::hash<std::string> hashFunc;
-				//size_t test = hashFunc(key);
-				int alphabetSize = 31;
-				int n = key.size();
-				size_t hash = 0;
-				for (int i = 0; i < n; i++) {
-					int c = key[i];
-					hash += (c - 'a') * std::pow(alphabetSize, n - (i + 1));
-				}
-				index = hash % _hashTable.size();
+		template <class K>
+		int _getIndex(const K& key) const noexcept {
+			if (_hashTable.size() == 0)
+				return -1;
+
+			return _hasher(key) % _hashTable.size();
+		}
+
+		template <class K>
+		std::optional<std::tuple<Comparable, V>> _find(const K& key) const {
+			int index = _getIndex(key);
+			if (index < 0)
+				return std::nullopt;
+
+			for (auto& elem : _hashTable[index]) {
+				if (std::get<0>(elem) == key)
+					return elem;
 			}
 
-			return index;
+			return std::nullopt;
+		}
+
+		template <class K>
+		ALGOGIN_ERROR _remove(const K& key) {
+			int index = _getIndex(key);
+			if (index < 0)
+				return ALGOGIN_ERROR::UNKNOWN_ERROR;
+
+			//returns old size - new size
+			auto size = _hashTable[index].remove_if([&key](const std::tuple<Comparable, V>& value) {	return std::get<0>(value) == key; });
+			if (size) {
+				_size -= size;
+				return ALGOGIN_ERROR::OK;
+			}
+
+			return ALGOGIN_ERROR::UNKNOWN_ERROR;
 		}
 	public:
 		HashTable(int size) {
@@ -1059,6 +1224,8 @@ namespace algogin {
 		~HashTable() = default;
 
 		HashTable(const HashTable& object) noexcept {
+			_hasher = object._hasher;
+			_size = object._size;
 			_hashTable.resize(object._hashTable.size());
 
 			for (int i = 0; i < object._hashTable.size(); i++)
@@ -1072,6 +1239,8 @@ namespace algogin {
 		}
 
 		HashTable& operator=(const HashTable& object) noexcept {
+			_hasher = object._hasher;
+			_size = object._size;
 			_hashTable.clear();
 
 			_hashTable.resize(object._hashTable.size());
@@ -1085,48 +1254,1458 @@ namespace algogin {
 		}
 
 		HashTable& operator=(HashTable&& object) noexcept {
+			_hasher = object._hasher;
 			_hashTable = object._hashTable;
+			_size = std::exchange(object._size, 0);
 			for (auto& item : object._hashTable)
 				item.clear();
 
 			return *this;
 		}
 
-		std::optional<std::tuple<Comparable, V>> find(Comparable key) {
+		std::optional<std::tuple<Comparable, V>> find(const Comparable& key) const {
+			return _find(key);
+		}
+
+		//lookup by any type comparable with key if hasher is transparent, e.g. std::string_view for std::string keys
+		template <class K> requires TransparentHash<Hasher> && (!std::is_same_v<std::remove_cvref_t<K>, Comparable>)
+		std::optional<std::tuple<Comparable, V>> find(const K& key) const {
+			return _find(key);
+		}
+
+		ALGOGIN_ERROR remove(const Comparable& key) {
+			return _remove(key);
+		}
+
+		template <class K> requires TransparentHash<Hasher> && (!std::is_same_v<std::remove_cvref_t<K>, Comparable>)
+		ALGOGIN_ERROR remove(const K& key) {
+			return _remove(key);
+		}
+
+		ALGOGIN_ERROR insert(Comparable key, V value) {
 			int index = _getIndex(key);
 			if (index < 0)
-				return std::nullopt;
+				return ALGOGIN_ERROR::UNKNOWN_ERROR;
 
-			for (auto elem : _hashTable[index]) {
-				if (std::get<0>(elem) == key)
-					return std::tuple{ key, std::get<1>(elem) };
-			}
+			_hashTable[index].push_back({ key, value });
+			_size++;
 
-			return std::nullopt;
+			return ALGOGIN_ERROR::OK;
 		}
 
-		ALGOGIN_ERROR remove(Comparable key) {
+		//replace value if key already exists, insert new key:value pair otherwise
+		ALGOGIN_ERROR insertOrAssign(Comparable key, V value) {
 			int index = _getIndex(key);
 			if (index < 0)
 				return ALGOGIN_ERROR::UNKNOWN_ERROR;
-			
-			//returns old size - new size
-			auto size = _hashTable[index].remove_if([key](const std::tuple<Comparable, V>& value) {	return std::get<0>(value) == key; });
-			if (size)
+
+			for (auto& elem : _hashTable[index]) {
+				if (std::get<0>(elem) == key) {
+					std::get<1>(elem) = std::move(value);
+					return ALGOGIN_ERROR::OK;
+				}
+			}
+
+			_hashTable[index].push_back({ std::move(key), std::move(value) });
+			_size++;
+
+			return ALGOGIN_ERROR::OK;
+		}
+
+		//find for many keys at once: keys are processed by groups, first buckets of all keys in group are prefetched,
+		//then first nodes of chains, and only then chains are checked, so cache misses of independent lookups overlap
+		ALGOGIN_ERROR findBatch(std::span<const Comparable> keys, std::span<std::optional<V>> values) const {
+			if (keys.size() != values.size())
+				return ALGOGIN_ERROR::OUT_OF_BOUNDS;
+
+			constexpr int GROUP = 16;
+			int indexes[GROUP];
+			for (size_t start = 0; start < keys.size(); start += GROUP) {
+				int size = static_cast<int>(std::min<size_t>(GROUP, keys.size() - start));
+				for (int i = 0; i < size; i++) {
+					indexes[i] = _getIndex(keys[start + i]);
+					if (indexes[i] >= 0)
+						prefetch(&_hashTable[indexes[i]]);
+				}
+
+				for (int i = 0; i < size; i++) {
+					if (indexes[i] >= 0 && _hashTable[indexes[i]].empty() == false)
+						prefetch(&_hashTable[indexes[i]].front());
+				}
+
+				for (int i = 0; i < size; i++) {
+					values[start + i] = std::nullopt;
+					if (indexes[i] < 0)
+						continue;
+
+					for (auto& elem : _hashTable[indexes[i]]) {
+						if (std::get<0>(elem) == keys[start + i]) {
+							values[start + i] = std::get<1>(elem);
+							break;
+						}
+					}
+				}
+			}
+
+			return ALGOGIN_ERROR::OK;
+		}
+
+		int getSize() const noexcept {
+			return _size;
+		}
+
+		int getBucketCount() const noexcept {
+			return static_cast<int>(_hashTable.size());
+		}
+
+		//changes number of buckets, nodes are moved to new chains by splice without copying elements
+		ALGOGIN_ERROR rehash(int size) {
+			if (size <= 0)
+				return ALGOGIN_ERROR::OUT_OF_BOUNDS;
+
+			std::vector<std::list<std::tuple<Comparable, V>>> table(size);
+			for (auto& chain : _hashTable) {
+				while (chain.empty() == false) {
+					auto& target = table[_hasher(std::get<0>(chain.front())) % size];
+					target.splice(target.end(), chain, chain.begin());
+				}
+			}
+			_hashTable = std::move(table);
+
+			return ALGOGIN_ERROR::OK;
+		}
+
+		//writes flat snapshot (see HashTableSnapshot), it can be queried by HashTableView without deserialization
+		ALGOGIN_ERROR dump(const std::filesystem::path& path) const requires std::is_trivially_copyable_v<Comparable> && std::is_trivially_copyable_v<V> {
+			using Snapshot = HashTableSnapshot;
+			Snapshot::Header header = {};
+			header.magic = Snapshot::MAGIC;
+			header.version = Snapshot::VERSION;
+			header.keySize = sizeof(Comparable);
+			header.valueSize = sizeof(V);
+			header.size = _size;
+			header.bucketCount = _hashTable.size();
+			header.offsetsOffset = snapshot::align(sizeof(Snapshot::Header));
+			header.keysOffset = snapshot::align(header.offsetsOffset + (header.bucketCount + 1) * sizeof(uint64_t));
+			header.valuesOffset = snapshot::align(header.keysOffset + header.size * sizeof(Comparable));
+
+			std::vector<uint64_t> offsets(_hashTable.size() + 1);
+			std::vector<Comparable> keys;
+			std::vector<V> values;
+			keys.reserve(_size);
+			values.reserve(_size);
+			for (size_t i = 0; i < _hashTable.size(); i++) {
+				offsets[i] = keys.size();
+				for (auto& elem : _hashTable[i]) {
+					keys.push_back(std::get<0>(elem));
+					values.push_back(std::get<1>(elem));
+				}
+			}
+			offsets.back() = keys.size();
+
+			return snapshot::write(path, {
+				{ 0, &header, sizeof(header) },
+				{ header.offsetsOffset, offsets.data(), offsets.size() * sizeof(uint64_t) },
+				{ header.keysOffset, keys.data(), keys.size() * sizeof(Comparable) },
+				{ header.valuesOffset, values.data(), values.size() * sizeof(V) }
+			});
+		}
+
+		//reads snapshot back into modifiable table with the same number of buckets
+		ALGOGIN_ERROR load(const std::filesystem::path& path) requires std::is_trivially_copyable_v<Comparable> && std::is_trivially_copyable_v<V> {
+			MappedFile mapping;
+			auto error = mapping.open(path);
+			if (error != ALGOGIN_ERROR::OK)
+				return error;
+
+			auto header = HashTableSnapshot::validate<Comparable, V>(mapping);
+			if (header == nullptr)
+				return ALGOGIN_ERROR::UNKNOWN_ERROR;
+
+			auto offsets = reinterpret_cast<const uint64_t*>(mapping.getData() + header->offsetsOffset);
+			auto keys = reinterpret_cast<const Comparable*>(mapping.getData() + header->keysOffset);
+			auto values = reinterpret_cast<const V*>(mapping.getData() + header->valuesOffset);
+			std::vector<std::list<std::tuple<Comparable, V>>> table(header->bucketCount);
+			for (uint64_t i = 0; i < header->bucketCount; i++) {
+				for (uint64_t j = offsets[i]; j < offsets[i + 1]; j++) {
+					//snapshot written with another hasher
+					if (_hasher(keys[j]) % header->bucketCount != i)
+						return ALGOGIN_ERROR::UNKNOWN_ERROR;
+					table[i].push_back({ keys[j], values[j] });
+				}
+			}
+
+			_hashTable = std::move(table);
+			_size = static_cast<int>(header->size);
+			return ALGOGIN_ERROR::OK;
+		}
+	};
+
+	//Read-only HashTable snapshot mapped to memory: open maps file and checks bucket offsets, keys and values aren't read,
+	//find hashes key to bucket and scans its keys directly in mapped file, pages are loaded on first access
+	template <class Comparable, class V, class Hasher = Hash<Comparable>>
+	requires std::is_trivially_copyable_v<Comparable> && std::is_trivially_copyable_v<V>
+	class HashTableView {
+	private:
+		MappedFile _mapping;
+		const uint64_t* _offsets = nullptr;
+		const Comparable* _keys = nullptr;
+		const V* _values = nullptr;
+		uint64_t _bucketCount = 0;
+		uint64_t _size = 0;
+		Hasher _hasher;
+	public:
+		HashTableView() = default;
+		~HashTableView() = default;
+		HashTableView(const HashTableView&) = delete;
+		HashTableView& operator=(const HashTableView&) = delete;
+		HashTableView(HashTableView&&) noexcept = default;
+		HashTableView& operator=(HashTableView&&) noexcept = default;
+
+		//returns NOT_FOUND if file doesn't exist, UNKNOWN_ERROR if file isn't snapshot of HashTable<Comparable, V>
+		ALGOGIN_ERROR open(const std::filesystem::path& path) {
+			MappedFile mapping;
+			auto error = mapping.open(path);
+			if (error != ALGOGIN_ERROR::OK)
+				return error;
+
+			auto header = HashTableSnapshot::validate<Comparable, V>(mapping);
+			if (header == nullptr)
+				return ALGOGIN_ERROR::UNKNOWN_ERROR;
+
+			_offsets = reinterpret_cast<const uint64_t*>(mapping.getData() + header->offsetsOffset);
+			_keys = reinterpret_cast<const Comparable*>(mapping.getData() + header->keysOffset);
+			_values = reinterpret_cast<const V*>(mapping.getData() + header->valuesOffset);
+			_bucketCount = header->bucketCount;
+			_size = header->size;
+			//cheap check that snapshot was written with the same hasher
+			if (_size > 0) {
+				uint64_t first = std::upper_bound(_offsets, _offsets + _bucketCount + 1, 0) - _offsets - 1;
+				if (_hasher(_keys[0]) % _bucketCount != first) {
+					*this = HashTableView();
+					return ALGOGIN_ERROR::UNKNOWN_ERROR;
+				}
+			}
+			_mapping = std::move(mapping);
+
+			return ALGOGIN_ERROR::OK;
+		}
+
+		std::optional<V> find(const Comparable& key) const noexcept {
+			if (_bucketCount == 0)
+				return std::nullopt;
+
+			uint64_t index = _hasher(key) % _bucketCount;
+			for (uint64_t i = _offsets[index]; i < _offsets[index + 1]; i++) {
+				if (_keys[i] == key)
+					return _values[i];
+			}
+
+			return std::nullopt;
+		}
+
+		int getSize() const noexcept {
+			return static_cast<int>(_size);
+		}
+
+		int getBucketCount() const noexcept {
+			return static_cast<int>(_bucketCount);
+		}
+	};
+
+	//Thread-safe hash table: keys are distributed between independently locked shards (HashTable + shared_mutex),
+	//so threads working with different shards don't contend, find takes shared lock and doesn't block other readers.
+	//Shard doubles its buckets under its own lock when it has more than LOAD_FACTOR elements per bucket
+	template <class Comparable, class V, class Hasher = Hash<Comparable>>
+	class ConcurrentHashTable {
+	private:
+		static constexpr int LOAD_FACTOR = 2;
+
+		//every shard in own cache line to avoid false sharing between mutexes
+		struct alignas(64) Shard {
+			mutable std::shared_mutex mutex;
+			HashTable<Comparable, V, Hasher> table;
+		};
+
+		std::vector<std::unique_ptr<Shard>> _shards;
+		Hasher _hasher;
+
+		template <class K>
+		Shard& _getShard(const K& key) const noexcept {
+			//HashTable takes bucket from hash modulo, so shard is taken from high bits of mixed hash: hashers
+			//of small integers (identity, modulo) still spread keys over all shards
+			uint64_t hash = hashing::mix(_hasher(key));
+			uint64_t shard = _shards.size();
+			hashing::multiply(hash, shard);
+			return *_shards[shard];
+		}
+
+		//called under unique lock of shard after insertion
+		static void _grow(Shard& shard) {
+			auto& table = shard.table;
+			if (table.getSize() > static_cast<int64_t>(table.getBucketCount()) * LOAD_FACTOR)
+				table.rehash(table.getBucketCount() * 2);
+		}
+	public:
+		//size - initial total number of buckets, shards - number of independently locked parts (0 - depends on hardware concurrency)
+		ConcurrentHashTable(int size, int shards = 0) {
+			if (shards <= 0)
+				shards = std::max(1u, std::thread::hardware_concurrency()) * 4;
+
+			for (int i = 0; i < shards; i++) {
+				auto shard = std::make_unique<Shard>();
+				shard->table = HashTable<Comparable, V, Hasher>(std::max(1, size / shards));
+				_shards.push_back(std::move(shard));
+			}
+		}
+
+		ConcurrentHashTable(const ConcurrentHashTable&) = delete;
+		ConcurrentHashTable& operator=(const ConcurrentHashTable&) = delete;
+		~ConcurrentHashTable() = default;
+
+		std::optional<std::tuple<Comparable, V>> find(const Comparable& key) const {
+			auto& shard = _getShard(key);
+			std::shared_lock lock(shard.mutex);
+			return shard.table.find(key);
+		}
+
+		template <class K> requires TransparentHash<Hasher> && (!std::is_same_v<std::remove_cvref_t<K>, Comparable>)
+		std::optional<std::tuple<Comparable, V>> find(const K& key) const {
+			auto& shard = _getShard(key);
+			std::shared_lock lock(shard.mutex);
+			return shard.table.find(key);
+		}
+
+		ALGOGIN_ERROR insert(Comparable key, V value) {
+			auto& shard = _getShard(key);
+			std::unique_lock lock(shard.mutex);
+			auto error = shard.table.insert(std::move(key), std::move(value));
+			_grow(shard);
+			return error;
+		}
+
+		ALGOGIN_ERROR insertOrAssign(Comparable key, V value) {
+			auto& shard = _getShard(key);
+			std::unique_lock lock(shard.mutex);
+			auto error = shard.table.insertOrAssign(std::move(key), std::move(value));
+			_grow(shard);
+			return error;
+		}
+
+		ALGOGIN_ERROR remove(const Comparable& key) {
+			auto& shard = _getShard(key);
+			std::unique_lock lock(shard.mutex);
+			return shard.table.remove(key);
+		}
+
+		template <class K> requires TransparentHash<Hasher> && (!std::is_same_v<std::remove_cvref_t<K>, Comparable>)
+		ALGOGIN_ERROR remove(const K& key) {
+			auto& shard = _getShard(key);
+			std::unique_lock lock(shard.mutex);
+			return shard.table.remove(key);
+		}
+
+		//not linearizable with concurrent modifications, shards are visited one by one
+		int getSize() const {
+			int size = 0;
+			for (auto& shard : _shards) {
+				std::shared_lock lock(shard->mutex);
+				size += shard->table.getSize();
+			}
+
+			return size;
+		}
+
+		int getBucketCount() const {
+			int count = 0;
+			for (auto& shard : _shards) {
+				std::shared_lock lock(shard->mutex);
+				count += shard->table.getBucketCount();
+			}
+
+			return count;
+		}
+	};
+
+	//Lock-free hash table based on split-ordered list (Shalev, Shavit): all elements are kept in one lock-free sorted list
+	//(Harris-Michael), ordered by bit-reversed hash, buckets are shortcuts (dummy nodes) into this list.
+	//Table grows by doubling bucket count, new buckets are lazily split from parents so no element is ever moved.
+	//Removed nodes are freed with epoch based reclamation.
+	template <class Comparable, class V, class Hasher = Hash<Comparable>>
+	class LockFreeHashTable {
+	private:
+		struct Node {
+			//bit-reversed hash, the lowest bit is 1 for regular nodes and 0 for bucket (dummy) nodes
+			uint64_t order;
+			//pointer to the next node, the lowest bit marks this node as logically removed
+			std::atomic<uintptr_t> next{ 0 };
+		};
+
+		struct Item : Node {
+			Comparable key;
+			V value;
+		};
+
+		//every thread working with table holds one slot while operation is in progress
+		struct alignas(64) Slot {
+			std::atomic<bool> claimed{ false };
+			//0 if slot isn't in critical section, epoch observed on enter otherwise
+			std::atomic<uint64_t> epoch{ 0 };
+			std::vector<std::tuple<Item*, uint64_t>> retired;
+		};
+
+		static constexpr int SLOTS = 128;
+		static constexpr int SEGMENTS = 48;
+		static constexpr int RETIRE_THRESHOLD = 64;
+		static constexpr int LOAD_FACTOR = 2;
+
+		//buckets are stored in segments of sizes 1, 1, 2, 4, 8... so directory never moves during growth
+		std::atomic<std::atomic<Node*>*> _segments[SEGMENTS] = {};
+		std::atomic<uint64_t> _bucketCount{ 2 };
+		std::atomic<int64_t> _size{ 0 };
+		std::atomic<uint64_t> _epoch{ 1 };
+		Slot _slots[SLOTS];
+		Hasher _hasher;
+
+		static bool _isMarked(uintptr_t pointer) noexcept {
+			return pointer & 1;
+		}
+
+		static Node* _getPointer(uintptr_t pointer) noexcept {
+			return reinterpret_cast<Node*>(pointer & ~uintptr_t(1));
+		}
+
+		static uint64_t _reverse(uint64_t value) noexcept {
+			value = ((value >> 1) & 0x5555555555555555ull) | ((value & 0x5555555555555555ull) << 1);
+			value = ((value >> 2) & 0x3333333333333333ull) | ((value & 0x3333333333333333ull) << 2);
+			value = ((value >> 4) & 0x0f0f0f0f0f0f0f0full) | ((value & 0x0f0f0f0f0f0f0f0full) << 4);
+			value = ((value >> 8) & 0x00ff00ff00ff00ffull) | ((value & 0x00ff00ff00ff00ffull) << 8);
+			value = ((value >> 16) & 0x0000ffff0000ffffull) | ((value & 0x0000ffff0000ffffull) << 16);
+			return (value >> 32) | (value << 32);
+		}
+
+		//RAII guard for critical section: nodes retired after enter aren't freed until guard is released
+		class EpochGuard {
+		private:
+			Slot* _slot;
+		public:
+			EpochGuard(LockFreeHashTable& table) {
+				thread_local size_t hint = std::hash<std::thread::id>{}(std::this_thread::get_id());
+				for (size_t i = hint;; i++) {
+					Slot& slot = table._slots[i % SLOTS];
+					bool expected = false;
+					if (slot.claimed.load(std::memory_order_relaxed) == false && slot.claimed.compare_exchange_strong(expected, true)) {
+						hint = i;
+						_slot = &slot;
+						break;
+					}
+					//all slots are busy, more than SLOTS threads are working with table simultaneously
+					if ((i + 1 - hint) % SLOTS == 0)
+						std::this_thread::yield();
+				}
+
+				uint64_t epoch;
+				do {
+					epoch = table._epoch.load();
+					_slot->epoch.store(epoch);
+				} while (table._epoch.load() != epoch);
+			}
+
+			~EpochGuard() {
+				_slot->epoch.store(0);
+				_slot->claimed.store(false);
+			}
+
+			Slot& getSlot() noexcept {
+				return *_slot;
+			}
+		};
+
+		//epoch can be advanced only if all threads in critical sections have already observed current epoch
+		void _tryAdvance() noexcept {
+			uint64_t epoch = _epoch.load();
+			for (auto& slot : _slots) {
+				uint64_t slotEpoch = slot.epoch.load();
+				if (slotEpoch != 0 && slotEpoch != epoch)
+					return;
+			}
+
+			_epoch.compare_exchange_strong(epoch, epoch + 1);
+		}
+
+		void _retire(EpochGuard& guard, Item* item) {
+			auto& retired = guard.getSlot().retired;
+			retired.push_back({ item, _epoch.load() });
+			if (retired.size() < RETIRE_THRESHOLD)
+				return;
+
+			_tryAdvance();
+			//nobody can hold pointer to node retired two epochs ago
+			uint64_t epoch = _epoch.load();
+			auto end = std::remove_if(retired.begin(), retired.end(), [epoch](const std::tuple<Item*, uint64_t>& elem) {
+				if (std::get<1>(elem) + 2 <= epoch) {
+					delete std::get<0>(elem);
+					return true;
+				}
+				return false;
+			});
+			retired.erase(end, retired.end());
+		}
+
+		std::atomic<Node*>& _getBucket(uint64_t index) {
+			int segment = std::bit_width(index);
+			uint64_t offset = segment > 0 ? index - (1ull << (segment - 1)) : 0;
+			auto buckets = _segments[segment].load();
+			if (buckets == nullptr) {
+				uint64_t size = segment > 0 ? 1ull << (segment - 1) : 1;
+				auto allocated = new std::atomic<Node*>[size];
+				for (uint64_t i = 0; i < size; i++)
+					allocated[i].store(nullptr, std::memory_order_relaxed);
+				//another thread could allocate segment simultaneously
+				if (_segments[segment].compare_exchange_strong(buckets, allocated))
+					buckets = allocated;
+				else
+					delete[] allocated;
+			}
+
+			return buckets[offset];
+		}
+
+		//search list starting from head for the first node with order >= target (and equal key for regular nodes)
+		//physically removes marked nodes on the way, returns position for insert: previous link and current node
+		template <class K>
+		bool _search(EpochGuard& guard, Node* head, uint64_t order, const K* key, std::atomic<uintptr_t>*& previous, Node*& current) {
+		retry:
+			previous = &head->next;
+			current = _getPointer(previous->load());
+			while (current) {
+				uintptr_t next = current->next.load();
+				if (_isMarked(next)) {
+					uintptr_t expected = reinterpret_cast<uintptr_t>(current);
+					if (previous->compare_exchange_strong(expected, next & ~uintptr_t(1)) == false)
+						goto retry;
+
+					_retire(guard, static_cast<Item*>(current));
+					current = _getPointer(next);
+					continue;
+				}
+
+				if (current->order > order)
+					return false;
+				//different keys can have the same hash so all nodes with equal order have to be checked
+				if (current->order == order && (key == nullptr || static_cast<Item*>(current)->key == *key))
+					return true;
+
+				previous = &current->next;
+				current = _getPointer(next);
+			}
+
+			return false;
+		}
+
+		//dummy node of bucket, bucket is created from parent bucket (index without the highest bit) if doesn't exist yet
+		Node* _getDummy(EpochGuard& guard, uint64_t index) {
+			auto& bucket = _getBucket(index);
+			Node* dummy = bucket.load();
+			if (dummy)
+				return dummy;
+
+			Node* parent = _getDummy(guard, index & ~(std::bit_floor(index)));
+			Node* node = new Node();
+			node->order = _reverse(index);
+			std::atomic<uintptr_t>* previous;
+			Node* current;
+			while (true) {
+				if (_search<Comparable>(guard, parent, node->order, nullptr, previous, current)) {
+					//another thread already inserted dummy node
+					delete node;
+					node = current;
+					break;
+				}
+
+				node->next.store(reinterpret_cast<uintptr_t>(current));
+				uintptr_t expected = reinterpret_cast<uintptr_t>(current);
+				if (previous->compare_exchange_strong(expected, reinterpret_cast<uintptr_t>(node)))
+					break;
+			}
+
+			bucket.store(node);
+			return node;
+		}
+
+		template <class K>
+		std::tuple<Node*, uint64_t> _locate(EpochGuard& guard, const K& key) {
+			//the highest bit is dropped, it's set to distinguish regular nodes from dummy ones
+			uint64_t hash = _hasher(key) & ~(1ull << 63);
+			uint64_t index = hash & (_bucketCount.load() - 1);
+			return { _getDummy(guard, index), _reverse(hash) | 1 };
+		}
+
+		template <class K>
+		std::optional<std::tuple<Comparable, V>> _find(const K& key) {
+			EpochGuard guard(*this);
+			auto [head, order] = _locate(guard, key);
+			std::atomic<uintptr_t>* previous;
+			Node* current;
+			if (_search(guard, head, order, &key, previous, current)) {
+				auto item = static_cast<Item*>(current);
+				return std::tuple{ item->key, item->value };
+			}
+
+			return std::nullopt;
+		}
+
+		template <class K>
+		ALGOGIN_ERROR _remove(const K& key) {
+			EpochGuard guard(*this);
+			auto [head, order] = _locate(guard, key);
+			std::atomic<uintptr_t>* previous;
+			Node* current;
+			while (true) {
+				if (_search(guard, head, order, &key, previous, current) == false)
+					return ALGOGIN_ERROR::NOT_FOUND;
+
+				//logical remove: mark next pointer so nobody can insert after this node
+				uintptr_t next = current->next.load();
+				if (_isMarked(next))
+					continue;
+				if (current->next.compare_exchange_strong(next, next | 1) == false)
+					continue;
+
+				_size--;
+				//physical remove, if it fails the node will be unlinked by the next search
+				uintptr_t expected = reinterpret_cast<uintptr_t>(current);
+				if (previous->compare_exchange_strong(expected, next))
+					_retire(guard, static_cast<Item*>(current));
+				else
+					_search(guard, head, order, &key, previous, current);
+
 				return ALGOGIN_ERROR::OK;
+			}
+		}
+	public:
+		LockFreeHashTable() {
+			//bucket 0 is the head of the list
+			auto& bucket = _getBucket(0);
+			Node* head = new Node();
+			head->order = 0;
+			bucket.store(head);
+		}
 
-			return ALGOGIN_ERROR::UNKNOWN_ERROR;
+		LockFreeHashTable(const LockFreeHashTable&) = delete;
+		LockFreeHashTable& operator=(const LockFreeHashTable&) = delete;
+
+		~LockFreeHashTable() {
+			Node* current = _getBucket(0).load();
+			while (current) {
+				Node* next = _getPointer(current->next.load());
+				if (current->order & 1)
+					delete static_cast<Item*>(current);
+				else
+					delete current;
+				current = next;
+			}
+
+			for (auto& slot : _slots)
+				for (auto& [item, epoch] : slot.retired)
+					delete item;
+
+			for (auto& segment : _segments)
+				delete[] segment.load();
 		}
 
+		//returns WRONG_KEY if key already exists
 		ALGOGIN_ERROR insert(Comparable key, V value) {
-			int index = _getIndex(key);
+			EpochGuard guard(*this);
+			auto [head, order] = _locate(guard, key);
+			Item* item = new Item();
+			item->order = order;
+			item->key = std::move(key);
+			item->value = std::move(value);
+			std::atomic<uintptr_t>* previous;
+			Node* current;
+			while (true) {
+				if (_search(guard, head, order, &item->key, previous, current)) {
+					delete item;
+					return ALGOGIN_ERROR::WRONG_KEY;
+				}
+
+				item->next.store(reinterpret_cast<uintptr_t>(current));
+				uintptr_t expected = reinterpret_cast<uintptr_t>(current);
+				if (previous->compare_exchange_strong(expected, reinterpret_cast<uintptr_t>(static_cast<Node*>(item))))
+					break;
+			}
+
+			//resize is just increase of bucket count, new buckets are initialized on first access
+			uint64_t bucketCount = _bucketCount.load();
+			if (++_size > static_cast<int64_t>(bucketCount * LOAD_FACTOR) && std::bit_width(bucketCount) < SEGMENTS - 1)
+				_bucketCount.compare_exchange_strong(bucketCount, bucketCount * 2);
+
+			return ALGOGIN_ERROR::OK;
+		}
+
+		std::optional<std::tuple<Comparable, V>> find(const Comparable& key) {
+			return _find(key);
+		}
+
+		template <class K> requires TransparentHash<Hasher> && (!std::is_same_v<std::remove_cvref_t<K>, Comparable>)
+		std::optional<std::tuple<Comparable, V>> find(const K& key) {
+			return _find(key);
+		}
+
+		ALGOGIN_ERROR remove(const Comparable& key) {
+			return _remove(key);
+		}
+
+		template <class K> requires TransparentHash<Hasher> && (!std::is_same_v<std::remove_cvref_t<K>, Comparable>)
+		ALGOGIN_ERROR remove(const K& key) {
+			return _remove(key);
+		}
+
+		int getSize() const noexcept {
+			return static_cast<int>(_size.load());
+		}
+
+		int getBucketCount() const noexcept {
+			return static_cast<int>(_bucketCount.load());
+		}
+	};
+
+	//Bucketized cuckoo hash table: every key can be placed only in one of 4 slots of 2 buckets, so lookup checks
+	//at most 2 buckets (2 cache lines for small keys/values) + small stash, which is empty in most cases.
+	//Insert moves existing elements to their alternative buckets if both buckets are full (random walk),
+	//elements which can't be placed go to stash of STASH_SIZE elements. Table doubles when it's MAX_LOAD full;
+	//when stash is full, table is rebuilt with new hash seed (and doubled if it's at least half full), insert is
+	//rejected only if hasher gives the same buckets to too many keys.
+	template <class Comparable, class V, class Hasher = Hash<Comparable>>
+	class CuckooHashTable {
+	private:
+		static constexpr int WAYS = 4;
+		static constexpr int STASH_SIZE = 8;
+		static constexpr int MAX_KICKS = 256;
+		static constexpr int MAX_REHASHES = 4;
+		//grow is useless for very bad hasher, table less than half full is only rehashed with new seed
+		static constexpr double MIN_GROW_LOAD = 0.5;
+		static constexpr double MAX_LOAD = 0.9;
+
+		struct alignas(64) Bucket {
+			//8 bits of hash for fast filtering, 0 means empty slot
+			uint8_t tags[WAYS] = {};
+			Comparable keys[WAYS];
+			V values[WAYS];
+		};
+
+		std::vector<Bucket> _buckets;
+		std::vector<std::tuple<Comparable, V>> _stash;
+		uint64_t _mask = 0;
+		int _size = 0;
+		uint64_t _random = 0x9e3779b97f4a7c15ull;
+		//0 until the first rehash, raw hash is used then
+		uint64_t _seed = 0;
+		Hasher _hasher;
+
+		uint64_t _nextRandom() noexcept {
+			_random ^= _random << 13;
+			_random ^= _random >> 7;
+			_random ^= _random << 17;
+			return _random;
+		}
+
+		template <class K>
+		uint64_t _hash(const K& key) const noexcept {
+			uint64_t hash = _hasher(key);
+			return _seed == 0 ? hash : hashing::mix(hash ^ _seed);
+		}
+
+		static uint8_t _getTag(uint64_t hash) noexcept {
+			return static_cast<uint8_t>(hash >> 56) | 1;
+		}
+
+		uint64_t _getFirst(uint64_t hash) const noexcept {
+			return hash & _mask;
+		}
+
+		uint64_t _getSecond(uint64_t hash) const noexcept {
+			uint64_t second = hashing::mix(hash >> 32) & _mask;
+			if (second == (hash & _mask))
+				second ^= 1;
+			return second & _mask;
+		}
+
+		template <class K>
+		std::tuple<Bucket*, int> _findSlot(const K& key, uint64_t hash) noexcept {
+			uint8_t tag = _getTag(hash);
+			for (Bucket* bucket : { &_buckets[_getFirst(hash)], &_buckets[_getSecond(hash)] }) {
+				for (int i = 0; i < WAYS; i++) {
+					if (bucket->tags[i] == tag && bucket->keys[i] == key)
+						return { bucket, i };
+				}
+			}
+
+			return { nullptr, -1 };
+		}
+
+		template <class K>
+		int _findStash(const K& key) const noexcept {
+			for (int i = 0; i < _stash.size(); i++) {
+				if (std::get<0>(_stash[i]) == key)
+					return i;
+			}
+
+			return -1;
+		}
+
+		bool _placeFree(Bucket& bucket, uint8_t tag, Comparable& key, V& value) {
+			for (int i = 0; i < WAYS; i++) {
+				if (bucket.tags[i] == 0) {
+					bucket.tags[i] = tag;
+					bucket.keys[i] = std::move(key);
+					bucket.values[i] = std::move(value);
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		//returns false if element doesn't fit, kicks are undone then, so table and key, value are unchanged
+		bool _place(Comparable& key, V& value) {
+			uint64_t hash = _hash(key);
+			uint64_t index = _getFirst(hash);
+			if (_placeFree(_buckets[index], _getTag(hash), key, value) || _placeFree(_buckets[_getSecond(hash)], _getTag(hash), key, value))
+				return true;
+
+			//random walk: evict random element from one of buckets and try to place it to its alternative bucket
+			uint64_t kickedBuckets[MAX_KICKS];
+			int kickedSlots[MAX_KICKS];
+			for (int kick = 0; kick < MAX_KICKS; kick++) {
+				_nextRandom();
+				//both buckets of the new element are full, start from random one
+				if (kick == 0 && (_random & (1ull << 40)))
+					index = _getSecond(hash);
+				Bucket& bucket = _buckets[index];
+				int victim = _random % WAYS;
+				std::swap(key, bucket.keys[victim]);
+				std::swap(value, bucket.values[victim]);
+				bucket.tags[victim] = _getTag(hash);
+				kickedBuckets[kick] = index;
+				kickedSlots[kick] = victim;
+
+				hash = _hash(key);
+				index = _getFirst(hash) == index ? _getSecond(hash) : _getFirst(hash);
+				if (_placeFree(_buckets[index], _getTag(hash), key, value))
+					return true;
+			}
+
+			for (int kick = MAX_KICKS - 1; kick >= 0; kick--) {
+				Bucket& bucket = _buckets[kickedBuckets[kick]];
+				int slot = kickedSlots[kick];
+				std::swap(key, bucket.keys[slot]);
+				std::swap(value, bucket.values[slot]);
+				bucket.tags[slot] = _getTag(_hash(bucket.keys[slot]));
+			}
+			return false;
+		}
+
+		//moves all elements of buckets and stash to elements
+		void _take(std::vector<std::tuple<Comparable, V>>& elements) {
+			for (auto& bucket : _buckets) {
+				for (int i = 0; i < WAYS; i++) {
+					if (bucket.tags[i])
+						elements.push_back({ std::move(bucket.keys[i]), std::move(bucket.values[i]) });
+				}
+			}
+			std::move(_stash.begin(), _stash.end(), std::back_inserter(elements));
+			_stash.clear();
+		}
+
+		//places all elements to bucketCount buckets, every failed attempt takes new seed; the new element (if any)
+		//is placed last, so if it doesn't fit after MAX_REHASHES attempts, table keeps all other elements.
+		//The last attempt returns to the old size and seed, which already held old elements; if random walk still
+		//doesn't find their places, they go to stash over its limit, because they can't be lost
+		bool _rebuild(uint64_t bucketCount, bool reseed, Comparable* key = nullptr, V* value = nullptr) {
+			std::vector<std::tuple<Comparable, V>> elements;
+			elements.reserve(_size);
+			_take(elements);
+
+			uint64_t oldCount = _buckets.size();
+			uint64_t oldSeed = _seed;
+			for (int attempt = 0;; attempt++) {
+				bool last = attempt + 1 == MAX_REHASHES;
+				if (last) {
+					bucketCount = oldCount;
+					_seed = oldSeed;
+				}
+				else if (reseed || attempt > 0) {
+					_seed = _nextRandom() | 1;
+				}
+				_buckets.assign(bucketCount, Bucket());
+				_mask = bucketCount - 1;
+
+				size_t placed = 0;
+				for (; placed < elements.size(); placed++) {
+					auto& [elementKey, elementValue] = elements[placed];
+					if (_place(elementKey, elementValue) == false) {
+						if (_stash.size() >= STASH_SIZE && last == false)
+							break;
+						_stash.push_back({ std::move(elementKey), std::move(elementValue) });
+					}
+				}
+
+				if (placed == elements.size()) {
+					if (key == nullptr || _place(*key, *value))
+						return true;
+					if (_stash.size() < STASH_SIZE) {
+						_stash.push_back({ std::move(*key), std::move(*value) });
+						return true;
+					}
+					if (last)
+						return false;
+				}
+
+				//elements which weren't placed yet are untouched, the rest is taken back from table
+				std::vector<std::tuple<Comparable, V>> rest;
+				rest.reserve(elements.size());
+				_take(rest);
+				std::move(elements.begin() + placed, elements.end(), std::back_inserter(rest));
+				elements = std::move(rest);
+			}
+		}
+
+		//returns false if element doesn't fit even after rehashes
+		bool _insert(Comparable& key, V& value) {
+			if (_place(key, value))
+				return true;
+
+			if (_stash.size() < STASH_SIZE) {
+				_stash.push_back({ std::move(key), std::move(value) });
+				return true;
+			}
+
+			double load = static_cast<double>(_size) / (_buckets.size() * WAYS);
+			return _rebuild(load < MIN_GROW_LOAD ? _buckets.size() : _buckets.size() * 2, true, &key, &value);
+		}
+
+		template <class K>
+		std::optional<std::tuple<Comparable, V>> _find(const K& key) {
+			auto [bucket, slot] = _findSlot(key, _hash(key));
+			if (bucket)
+				return std::tuple{ bucket->keys[slot], bucket->values[slot] };
+
+			if (_stash.empty() == false) {
+				int index = _findStash(key);
+				if (index >= 0)
+					return _stash[index];
+			}
+
+			return std::nullopt;
+		}
+
+		template <class K>
+		ALGOGIN_ERROR _remove(const K& key) {
+			auto [bucket, slot] = _findSlot(key, _hash(key));
+			if (bucket) {
+				bucket->tags[slot] = 0;
+				bucket->keys[slot] = Comparable();
+				bucket->values[slot] = V();
+				_size--;
+				//the freed slot can be used by element from stash
+				for (int i = 0; i < _stash.size(); i++) {
+					auto& [stashKey, stashValue] = _stash[i];
+					uint64_t hash = _hash(stashKey);
+					if (&_buckets[_getFirst(hash)] == bucket || &_buckets[_getSecond(hash)] == bucket) {
+						_placeFree(*bucket, _getTag(hash), stashKey, stashValue);
+						_stash.erase(_stash.begin() + i);
+						break;
+					}
+				}
+				return ALGOGIN_ERROR::OK;
+			}
+
+			int index = _findStash(key);
 			if (index < 0)
+				return ALGOGIN_ERROR::NOT_FOUND;
+
+			_stash.erase(_stash.begin() + index);
+			_size--;
+			return ALGOGIN_ERROR::OK;
+		}
+	public:
+		//size - expected number of elements
+		CuckooHashTable(int size = 0) {
+			uint64_t buckets = std::bit_ceil(static_cast<uint64_t>(std::max(2, static_cast<int>(size / (WAYS * MAX_LOAD)) + 1)));
+			_buckets.resize(buckets);
+			_mask = buckets - 1;
+		}
+
+		~CuckooHashTable() = default;
+		CuckooHashTable(const CuckooHashTable&) = default;
+		CuckooHashTable(CuckooHashTable&&) noexcept = default;
+		CuckooHashTable& operator=(const CuckooHashTable&) = default;
+		CuckooHashTable& operator=(CuckooHashTable&&) noexcept = default;
+
+		//returns WRONG_KEY if key already exists, REJECTED if hasher gives the same buckets to too many keys
+		ALGOGIN_ERROR insert(Comparable key, V value) {
+			if (_find(key))
+				return ALGOGIN_ERROR::WRONG_KEY;
+
+			if (_size + 1 > _buckets.size() * WAYS * MAX_LOAD)
+				_rebuild(_buckets.size() * 2, false);
+
+			if (_insert(key, value) == false)
+				return ALGOGIN_ERROR::REJECTED;
+			_size++;
+			return ALGOGIN_ERROR::OK;
+		}
+
+		ALGOGIN_ERROR insertOrAssign(Comparable key, V value) {
+			auto [bucket, slot] = _findSlot(key, _hash(key));
+			if (bucket) {
+				bucket->values[slot] = std::move(value);
+				return ALGOGIN_ERROR::OK;
+			}
+
+			int index = _findStash(key);
+			if (index >= 0) {
+				std::get<1>(_stash[index]) = std::move(value);
+				return ALGOGIN_ERROR::OK;
+			}
+
+			return insert(std::move(key), std::move(value));
+		}
+
+		std::optional<std::tuple<Comparable, V>> find(const Comparable& key) {
+			return _find(key);
+		}
+
+		template <class K> requires TransparentHash<Hasher> && (!std::is_same_v<std::remove_cvref_t<K>, Comparable>)
+		std::optional<std::tuple<Comparable, V>> find(const K& key) {
+			return _find(key);
+		}
+
+		ALGOGIN_ERROR remove(const Comparable& key) {
+			return _remove(key);
+		}
+
+		template <class K> requires TransparentHash<Hasher> && (!std::is_same_v<std::remove_cvref_t<K>, Comparable>)
+		ALGOGIN_ERROR remove(const K& key) {
+			return _remove(key);
+		}
+
+		int getSize() const noexcept {
+			return _size;
+		}
+
+		int getStashSize() const noexcept {
+			return static_cast<int>(_stash.size());
+		}
+
+		int getBucketCount() const noexcept {
+			return static_cast<int>(_buckets.size());
+		}
+	};
+
+	//Static minimal perfect hash table (PTHash): built once from fixed set of keys, then every key maps to its own slot,
+	//lookup is one hash, one pilot read and one key comparison without any collisions.
+	//Keys are split to buckets (skewed: 60% of keys to 30% of buckets), for every bucket pilot is searched so all keys
+	//of bucket land to free slots: position = reduce(hash ^ mix(pilot), tableSize). Pilots are stored with fixed bit width,
+	//table is 1% bigger than number of keys, positions beyond keys number are remapped to free slots.
+	//Metadata (pilots + remap) takes about 3 bits per key. Table with trivially copyable keys and values can be dumped
+	//to flat file and loaded back by mmap without deserialization.
+	template <class Comparable, class V, class Hasher = Hash<Comparable>>
+	class PerfectHashTable {
+	private:
+		static constexpr uint64_t MAGIC = 0x3154485041474c41ull; //"ALGAPHT1"
+		static constexpr uint32_t VERSION = 1;
+		static constexpr double BUCKETS_FACTOR = 5.0;
+		static constexpr double ALPHA = 0.99;
+		static constexpr uint64_t MAX_PILOT = 1ull << 20;
+		static constexpr uint64_t MAX_SEEDS = 64;
+
+		struct Header {
+			uint64_t magic;
+			uint32_t version;
+			uint32_t keySize;
+			uint32_t valueSize;
+			uint32_t pilotWidth;
+			uint64_t seed;
+			uint64_t size;
+			uint64_t tableSize;
+			uint64_t bucketCount;
+			uint64_t pilotsOffset;
+			uint64_t pilotsWords;
+			uint64_t freeOffset;
+			uint64_t keysOffset;
+			uint64_t valuesOffset;
+		};
+
+		//storage is used if table is built in memory, mapping if table is loaded from file
+		std::vector<uint64_t> _pilotsStorage;
+		std::vector<uint32_t> _freeStorage;
+		std::vector<Comparable> _keysStorage;
+		std::vector<V> _valuesStorage;
+		MappedFile _mapping;
+
+		const uint64_t* _pilots = nullptr;
+		uint64_t _pilotsWords = 0;
+		const uint32_t* _free = nullptr;
+		const Comparable* _keys = nullptr;
+		const V* _values = nullptr;
+		uint32_t _pilotWidth = 0;
+		uint64_t _seed = 0;
+		uint64_t _size = 0;
+		uint64_t _tableSize = 0;
+		uint64_t _bucketCount = 0;
+		Hasher _hasher;
+
+		//maps hash to [0, range) by multiplication instead of slow modulo
+		static uint64_t _reduce(uint64_t hash, uint64_t range) noexcept {
+			hashing::multiply(hash, range);
+			return range;
+		}
+
+		uint64_t _getBucket(uint64_t hash) const noexcept {
+			//bucket has to be independent from position, otherwise keys of one bucket compete for the same slots
+			hash = hashing::mix(hash);
+			uint64_t denseBuckets = static_cast<uint64_t>(0.3 * _bucketCount);
+			if (denseBuckets == 0 || _bucketCount - denseBuckets == 0)
+				return _reduce(hash, _bucketCount);
+			//the lowest 32 bits decide if key goes to dense or sparse part
+			if (static_cast<uint32_t>(hash) < static_cast<uint32_t>(0.6 * UINT32_MAX))
+				return _reduce(hash, denseBuckets);
+			return denseBuckets + _reduce(hash, _bucketCount - denseBuckets);
+		}
+
+		uint64_t _getPosition(uint64_t hash, uint64_t pilot) const noexcept {
+			return _reduce(hash ^ hashing::mix(pilot), _tableSize);
+		}
+
+		uint64_t _getPilot(uint64_t bucket) const noexcept {
+			uint64_t bit = bucket * _pilotWidth;
+			uint64_t word = bit >> 6;
+			uint64_t shift = bit & 63;
+			uint64_t value = _pilots[word] >> shift;
+			if (shift + _pilotWidth > 64)
+				value |= _pilots[word + 1] << (64 - shift);
+			return _pilotWidth == 64 ? value : value & ((1ull << _pilotWidth) - 1);
+		}
+
+		template <class K>
+		uint64_t _hash(const K& key) const noexcept {
+			return hashing::mix(_hasher(key) ^ _seed);
+		}
+
+		template <class K>
+		const V* _find(const K& key) const noexcept {
+			if (_size == 0)
+				return nullptr;
+
+			uint64_t hash = _hash(key);
+			uint64_t position = _getPosition(hash, _getPilot(_getBucket(hash)));
+			if (position >= _size)
+				position = _free[position - _size];
+			if (_keys[position] == key)
+				return &_values[position];
+
+			return nullptr;
+		}
+
+		//returns false if some bucket can't be placed with this seed
+		bool _searchPilots(const std::vector<uint64_t>& hashes, std::vector<uint64_t>& pilots, std::vector<uint64_t>& positions) {
+			std::vector<std::vector<uint32_t>> buckets(_bucketCount);
+			for (uint32_t i = 0; i < hashes.size(); i++)
+				buckets[_getBucket(hashes[i])].push_back(i);
+
+			//the biggest buckets are placed first while table is almost empty
+			std::vector<uint32_t> order(_bucketCount);
+			for (uint32_t i = 0; i < _bucketCount; i++)
+				order[i] = i;
+			std::stable_sort(order.begin(), order.end(), [&buckets](uint32_t left, uint32_t right) { return buckets[left].size() > buckets[right].size(); });
+
+			std::vector<bool> taken(_tableSize);
+			std::vector<uint64_t> candidates;
+			pilots.assign(_bucketCount, 0);
+			positions.assign(hashes.size(), 0);
+			for (uint32_t bucket : order) {
+				auto& keys = buckets[bucket];
+				if (keys.size() == 0)
+					break;
+
+				bool placed = false;
+				for (uint64_t pilot = 0; pilot < MAX_PILOT && placed == false; pilot++) {
+					candidates.clear();
+					placed = true;
+					for (uint32_t key : keys) {
+						uint64_t position = _getPosition(hashes[key], pilot);
+						if (taken[position] || std::find(candidates.begin(), candidates.end(), position) != candidates.end()) {
+							placed = false;
+							break;
+						}
+						candidates.push_back(position);
+					}
+
+					if (placed) {
+						pilots[bucket] = pilot;
+						for (int i = 0; i < keys.size(); i++) {
+							taken[candidates[i]] = true;
+							positions[keys[i]] = candidates[i];
+						}
+					}
+				}
+
+				if (placed == false)
+					return false;
+			}
+
+			return true;
+		}
+
+		void _setPointers() noexcept {
+			_pilots = _pilotsStorage.data();
+			_pilotsWords = _pilotsStorage.size();
+			_free = _freeStorage.data();
+			_keys = _keysStorage.data();
+			_values = _valuesStorage.data();
+		}
+
+		//checks header against mapping, so queries never read outside of it
+		static bool _validate(const Header& header, const MappedFile& mapping) noexcept {
+			if (header.magic != MAGIC || header.version != VERSION || header.keySize != sizeof(Comparable) || header.valueSize != sizeof(V) ||
+				header.size >= UINT32_MAX || header.tableSize < header.size)
+				return false;
+
+			uint64_t end = sizeof(Header);
+			if (snapshot::checkSection(header.pilotsOffset, header.pilotsWords, sizeof(uint64_t), end, mapping.getSize()) == false ||
+				snapshot::checkSection(header.freeOffset, header.tableSize - header.size, sizeof(uint32_t), end, mapping.getSize()) == false ||
+				snapshot::checkSection(header.keysOffset, header.size, sizeof(Comparable), end, mapping.getSize()) == false ||
+				snapshot::checkSection(header.valuesOffset, header.size, sizeof(V), end, mapping.getSize()) == false)
+				return false;
+			if (header.size == 0)
+				return true;
+
+			//every bucket has pilot of pilotWidth bits and there is +1 word for reads crossing the end
+			if (header.pilotWidth == 0 || header.pilotWidth > 64 || header.bucketCount == 0 || header.pilotsWords == 0 ||
+				header.bucketCount > (header.pilotsWords - 1) * 64 / header.pilotWidth)
+				return false;
+
+			//remapped positions are used as indexes of keys
+			auto free = reinterpret_cast<const uint32_t*>(mapping.getData() + header.freeOffset);
+			return std::all_of(free, free + (header.tableSize - header.size), [&header](uint32_t position) { return position < header.size; });
+		}
+	public:
+		PerfectHashTable() = default;
+		~PerfectHashTable() = default;
+
+		PerfectHashTable(const PerfectHashTable&) = delete;
+		PerfectHashTable& operator=(const PerfectHashTable&) = delete;
+
+		PerfectHashTable(PerfectHashTable&& table) noexcept {
+			*this = std::move(table);
+		}
+
+		PerfectHashTable& operator=(PerfectHashTable&& table) noexcept {
+			if (this != &table) {
+				//vectors and mapping keep their buffers on move, so pointers stay valid
+				_pilotsStorage = std::move(table._pilotsStorage);
+				_freeStorage = std::move(table._freeStorage);
+				_keysStorage = std::move(table._keysStorage);
+				_valuesStorage = std::move(table._valuesStorage);
+				_mapping = std::move(table._mapping);
+				_pilots = std::exchange(table._pilots, nullptr);
+				_pilotsWords = std::exchange(table._pilotsWords, 0);
+				_free = std::exchange(table._free, nullptr);
+				_keys = std::exchange(table._keys, nullptr);
+				_values = std::exchange(table._values, nullptr);
+				_pilotWidth = std::exchange(table._pilotWidth, 0);
+				_seed = std::exchange(table._seed, 0);
+				_size = std::exchange(table._size, 0);
+				_tableSize = std::exchange(table._tableSize, 0);
+				_bucketCount = std::exchange(table._bucketCount, 0);
+				_hasher = table._hasher;
+			}
+			return *this;
+		}
+
+		//range of tuple-like key:value pairs (std::pair, std::tuple), returns WRONG_KEY if keys aren't unique,
+		//REJECTED if hasher gives equal hashes to different keys or no seed places all keys
+		template <std::ranges::input_range Range>
+		ALGOGIN_ERROR build(const Range& range) {
+			std::vector<Comparable> keys;
+			std::vector<V> values;
+			for (const auto& elem : range) {
+				keys.push_back(std::get<0>(elem));
+				values.push_back(std::get<1>(elem));
+			}
+
+			*this = PerfectHashTable();
+			_size = keys.size();
+			if (_size == 0)
+				return ALGOGIN_ERROR::OK;
+			if (_size >= UINT32_MAX)
+				return ALGOGIN_ERROR::OUT_OF_BOUNDS;
+
+			_tableSize = std::max<uint64_t>(_size, static_cast<uint64_t>(_size / ALPHA));
+			_bucketCount = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(BUCKETS_FACTOR * _size / std::max(1.0, std::log2(_size)))));
+			//keys with equal hasher values can't be separated by any seed or pilot
+			std::vector<uint64_t> baseHashes(_size);
+			for (uint64_t i = 0; i < _size; i++)
+				baseHashes[i] = _hasher(keys[i]);
+			std::vector<uint32_t> sorted(_size);
+			for (uint32_t i = 0; i < _size; i++)
+				sorted[i] = i;
+			std::sort(sorted.begin(), sorted.end(), [&baseHashes](uint32_t left, uint32_t right) { return baseHashes[left] < baseHashes[right]; });
+			for (uint64_t i = 1; i < _size; i++) {
+				if (baseHashes[sorted[i]] == baseHashes[sorted[i - 1]]) {
+					bool duplicate = keys[sorted[i]] == keys[sorted[i - 1]];
+					*this = PerfectHashTable();
+					return duplicate ? ALGOGIN_ERROR::WRONG_KEY : ALGOGIN_ERROR::REJECTED;
+				}
+			}
+
+			std::vector<uint64_t> hashes(_size), pilots, positions;
+			for (_seed = 0; _seed < MAX_SEEDS; _seed++) {
+				for (uint64_t i = 0; i < _size; i++)
+					hashes[i] = hashing::mix(baseHashes[i] ^ _seed);
+
+				//different hasher values still can collide after mixing with unlucky seed
+				std::sort(sorted.begin(), sorted.end(), [&hashes](uint32_t left, uint32_t right) { return hashes[left] < hashes[right]; });
+				bool collision = false;
+				for (uint64_t i = 1; i < _size && collision == false; i++)
+					collision = hashes[sorted[i]] == hashes[sorted[i - 1]];
+
+				if (collision == false && _searchPilots(hashes, pilots, positions))
+					break;
+			}
+			if (_seed == MAX_SEEDS) {
+				*this = PerfectHashTable();
+				return ALGOGIN_ERROR::REJECTED;
+			}
+
+			//pilots with fixed width, +1 word so reading never crosses the end
+			_pilotWidth = std::max(1, static_cast<int>(std::bit_width(*std::max_element(pilots.begin(), pilots.end()))));
+			_pilotsStorage.assign((_bucketCount * _pilotWidth + 63) / 64 + 1, 0);
+			for (uint64_t i = 0; i < _bucketCount; i++) {
+				uint64_t bit = i * _pilotWidth;
+				_pilotsStorage[bit >> 6] |= pilots[i] << (bit & 63);
+				if ((bit & 63) + _pilotWidth > 64)
+					_pilotsStorage[(bit >> 6) + 1] |= pilots[i] >> (64 - (bit & 63));
+			}
+
+			//positions beyond size point to slots which are free
+			std::vector<bool> taken(_size);
+			for (auto position : positions) {
+				if (position < _size)
+					taken[position] = true;
+			}
+			_freeStorage.assign(_tableSize - _size, 0);
+			uint32_t freeSlot = 0;
+			for (auto& position : positions) {
+				if (position >= _size) {
+					while (taken[freeSlot])
+						freeSlot++;
+					taken[freeSlot] = true;
+					_freeStorage[position - _size] = freeSlot;
+					position = freeSlot;
+				}
+			}
+
+			_keysStorage.resize(_size);
+			_valuesStorage.resize(_size);
+			for (uint64_t i = 0; i < _size; i++) {
+				_keysStorage[positions[i]] = std::move(keys[i]);
+				_valuesStorage[positions[i]] = std::move(values[i]);
+			}
+			_setPointers();
+
+			return ALGOGIN_ERROR::OK;
+		}
+
+		std::optional<V> find(const Comparable& key) const noexcept {
+			auto value = _find(key);
+			if (value)
+				return *value;
+
+			return std::nullopt;
+		}
+
+		template <class K> requires TransparentHash<Hasher> && (!std::is_same_v<std::remove_cvref_t<K>, Comparable>)
+		std::optional<V> find(const K& key) const noexcept {
+			auto value = _find(key);
+			if (value)
+				return *value;
+
+			return std::nullopt;
+		}
+
+		int getSize() const noexcept {
+			return static_cast<int>(_size);
+		}
+
+		//size of pilots and remap table per key
+		double getMetadataBits() const noexcept {
+			if (_size == 0)
+				return 0;
+
+			return (_pilotsWords * 64.0 + (_tableSize - _size) * 32.0) / _size;
+		}
+
+		//flat file (see snapshot): header, pilots, remap table, keys, values
+		ALGOGIN_ERROR dump(const std::filesystem::path& path) const requires std::is_trivially_copyable_v<Comparable> && std::is_trivially_copyable_v<V> {
+			Header header = {};
+			header.magic = MAGIC;
+			header.version = VERSION;
+			header.keySize = sizeof(Comparable);
+			header.valueSize = sizeof(V);
+			header.pilotWidth = _pilotWidth;
+			header.seed = _seed;
+			header.size = _size;
+			header.tableSize = _tableSize;
+			header.bucketCount = _bucketCount;
+			header.pilotsOffset = snapshot::align(sizeof(Header));
+			header.pilotsWords = _pilotsWords;
+			header.freeOffset = snapshot::align(header.pilotsOffset + _pilotsWords * sizeof(uint64_t));
+			header.keysOffset = snapshot::align(header.freeOffset + (_tableSize - _size) * sizeof(uint32_t));
+			header.valuesOffset = snapshot::align(header.keysOffset + _size * sizeof(Comparable));
+
+			return snapshot::write(path, {
+				{ 0, &header, sizeof(Header) },
+				{ header.pilotsOffset, _pilots, _pilotsWords * sizeof(uint64_t) },
+				{ header.freeOffset, _free, (_tableSize - _size) * sizeof(uint32_t) },
+				{ header.keysOffset, _keys, _size * sizeof(Comparable) },
+				{ header.valuesOffset, _values, _size * sizeof(V) }
+			});
+		}
+
+		//maps file to memory, table is queried directly from mapping; returns NOT_FOUND if file doesn't exist,
+		//UNKNOWN_ERROR if file isn't valid dump of PerfectHashTable<Comparable, V>
+		ALGOGIN_ERROR load(const std::filesystem::path& path) requires std::is_trivially_copyable_v<Comparable> && std::is_trivially_copyable_v<V> {
+			MappedFile mapping;
+			auto error = mapping.open(path);
+			if (error != ALGOGIN_ERROR::OK)
+				return error;
+
+			Header header;
+			if (mapping.getSize() < sizeof(Header))
+				return ALGOGIN_ERROR::UNKNOWN_ERROR;
+			std::memcpy(&header, mapping.getData(), sizeof(Header));
+			if (_validate(header, mapping) == false)
 				return ALGOGIN_ERROR::UNKNOWN_ERROR;
 
-			_hashTable[index].push_back({ key, value });
+			*this = PerfectHashTable();
+			_pilotWidth = header.pilotWidth;
+			_seed = header.seed;
+			_size = header.size;
+			_tableSize = header.tableSize;
+			_bucketCount = header.bucketCount;
+			_pilotsWords = header.pilotsWords;
+			_pilots = reinterpret_cast<const uint64_t*>(mapping.getData() + header.pilotsOffset);
+			_free = reinterpret_cast<const uint32_t*>(mapping.getData() + header.freeOffset);
+			_keys = reinterpret_cast<const Comparable*>(mapping.getData() + header.keysOffset);
+			_values = reinterpret_cast<const V*>(mapping.getData() + header.valuesOffset);
+			_mapping = std::move(mapping);
 
 			return ALGOGIN_ERROR::OK;
 		}
 	};
 
-}
+}
\ No newline at end of file
@@ -0,0 +1,458 @@
+#pragma once
+#include "Common.h"
+#include "Hash.h"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <ranges>
+#include <thread>
+#include <utility>
+#include <vector>
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+//AVX2 kernels are compiled with target attributes and chosen at runtime if CPU supports them
+#define ALGOGIN_FILTER_DISPATCH
+#endif
+
+namespace algogin {
+	namespace filter {
+		//binary file: header followed by raw filter data
+		struct Header {
+			uint64_t magic;
+			uint32_t version;
+			uint32_t kind;
+			uint64_t size;
+			uint64_t parameter;
+		};
+
+		constexpr uint64_t MAGIC = 0x52544c4649474c41ull; //"ALGIFLTR"
+		constexpr uint32_t VERSION = 1;
+
+		enum class Level {
+			SCALAR,
+			AVX2
+		};
+
+		//the widest instruction set supported by CPU
+		inline Level getLevel() noexcept {
+#if defined(ALGOGIN_FILTER_DISPATCH)
+			static const Level level = [] {
+				__builtin_cpu_init();
+				return __builtin_cpu_supports("avx2") ? Level::AVX2 : Level::SCALAR;
+			}();
+			return level;
+#else
+			return Level::SCALAR;
+#endif
+		}
+
+		template <class T>
+		ALGOGIN_ERROR dump(const std::filesystem::path& path, uint32_t kind, uint64_t parameter, const std::vector<T>& data) {
+			std::ofstream file{ path, std::ios::binary };
+			if (file.is_open() == false)
+				return ALGOGIN_ERROR::UNKNOWN_ERROR;
+
+			Header header = { MAGIC, VERSION, kind, data.size(), parameter };
+			file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+			file.write(reinterpret_cast<const char*>(data.data()), data.size() * sizeof(T));
+			return file.good() ? ALGOGIN_ERROR::OK : ALGOGIN_ERROR::UNKNOWN_ERROR;
+		}
+
+		template <class T>
+		ALGOGIN_ERROR load(const std::filesystem::path& path, uint32_t kind, uint64_t& parameter, std::vector<T>& data) {
+			if (std::filesystem::exists(path) == false)
+				return ALGOGIN_ERROR::NOT_FOUND;
+
+			std::ifstream file{ path, std::ios::binary };
+			Header header;
+			file.read(reinterpret_cast<char*>(&header), sizeof(Header));
+			//size is compared by division, so corrupted header can't overflow it
+			uint64_t fileSize = std::filesystem::file_size(path);
+			if (file.good() == false || header.magic != MAGIC || header.version != VERSION || header.kind != kind ||
+				fileSize < sizeof(Header) || (fileSize - sizeof(Header)) % sizeof(T) != 0 || header.size != (fileSize - sizeof(Header)) / sizeof(T))
+				return ALGOGIN_ERROR::UNKNOWN_ERROR;
+
+			data.resize(header.size);
+			file.read(reinterpret_cast<char*>(data.data()), data.size() * sizeof(T));
+			parameter = header.parameter;
+			return file.good() ? ALGOGIN_ERROR::OK : ALGOGIN_ERROR::UNKNOWN_ERROR;
+		}
+
+		//split [0, size) into equal parts and process every part in own thread
+		template <class F>
+		void parallelFor(size_t size, int threads, F&& body) {
+			if (threads <= 0)
+				threads = std::max(1u, std::thread::hardware_concurrency());
+			threads = static_cast<int>(std::max<size_t>(1, std::min<size_t>(threads, size / 1024)));
+
+			std::vector<std::thread> workers;
+			for (int t = 0; t < threads; t++) {
+				workers.emplace_back([&, t] {
+					for (size_t i = size * t / threads; i < size * (t + 1) / threads; i++)
+						body(i);
+				});
+			}
+			for (auto& worker : workers)
+				worker.join();
+		}
+	}
+
+	//Blocked Bloom filter: every key sets 8 bits inside one 32-byte block (one bit per 32-bit word),
+	//so query touches one cache line and all 8 words are checked by one SIMD operation (AVX2, chosen at runtime)
+	//or unrolled loop.
+	//False positive rate is about 1% for 10 bits per key.
+	template <class Comparable, class Hasher = Hash<Comparable>>
+	class BloomFilter {
+	private:
+		static constexpr uint32_t KIND = 1;
+		static constexpr int WORDS = 8;
+
+		struct alignas(32) Block {
+			uint32_t words[WORDS];
+		};
+
+		//odd constants, every one selects bit in own word
+		static constexpr uint32_t SALT[WORDS] = { 0x47b6137bu, 0x44974d91u, 0x8824ad5bu, 0xa2b7289du, 0x705495c7u, 0x2df1424bu, 0x9efc4947u, 0x5c6bfb31u };
+
+		std::vector<Block> _blocks;
+		filter::Level _level = filter::getLevel();
+		Hasher _hasher;
+
+		static Block _getMask(uint32_t hash) noexcept {
+			Block mask;
+			for (int i = 0; i < WORDS; i++)
+				mask.words[i] = 1u << ((hash * SALT[i]) >> 27);
+			return mask;
+		}
+
+		Block& _getBlock(uint64_t hash) noexcept {
+			return _blocks[((hash >> 32) * _blocks.size()) >> 32];
+		}
+
+		const Block& _getBlock(uint64_t hash) const noexcept {
+			return _blocks[((hash >> 32) * _blocks.size()) >> 32];
+		}
+
+		template <class K>
+		bool _contains(const K& key) const noexcept {
+			if (_blocks.empty())
+				return false;
+
+			uint64_t hash = _hasher(key);
+			const Block& block = _getBlock(hash);
+#if defined(ALGOGIN_FILTER_DISPATCH)
+			if (_level == filter::Level::AVX2)
+				return _containsAvx2(static_cast<uint32_t>(hash), block);
+#endif
+			Block mask = _getMask(static_cast<uint32_t>(hash));
+			uint32_t missing = 0;
+			for (int i = 0; i < WORDS; i++)
+				missing |= mask.words[i] & ~block.words[i];
+			return missing == 0;
+		}
+
+#if defined(ALGOGIN_FILTER_DISPATCH)
+		//vectors don't cross function boundary, so the kernel can be called from code compiled without AVX2
+		__attribute__((target("avx2"))) static bool _containsAvx2(uint32_t hash, const Block& block) noexcept {
+			const __m256i salt = _mm256_setr_epi32(SALT[0], SALT[1], SALT[2], SALT[3], SALT[4], SALT[5], SALT[6], SALT[7]);
+			__m256i bits = _mm256_srli_epi32(_mm256_mullo_epi32(_mm256_set1_epi32(hash), salt), 27);
+			__m256i mask = _mm256_sllv_epi32(_mm256_set1_epi32(1), bits);
+			__m256i words = _mm256_load_si256(reinterpret_cast<const __m256i*>(block.words));
+			//all bits of mask are set in block
+			return _mm256_testc_si256(words, mask);
+		}
+#endif
+	public:
+		//elements - expected number of keys
+		BloomFilter(size_t elements = 0, double bitsPerKey = 10) {
+			size_t blocks = static_cast<size_t>(std::ceil(elements * bitsPerKey / (WORDS * 32)));
+			_blocks.resize(std::max<size_t>(1, blocks));
+		}
+
+		~BloomFilter() = default;
+		BloomFilter(const BloomFilter&) = default;
+		BloomFilter(BloomFilter&&) noexcept = default;
+		BloomFilter& operator=(const BloomFilter&) = default;
+		BloomFilter& operator=(BloomFilter&&) noexcept = default;
+
+		ALGOGIN_ERROR insert(const Comparable& key) noexcept {
+			uint64_t hash = _hasher(key);
+			Block& block = _getBlock(hash);
+			Block mask = _getMask(static_cast<uint32_t>(hash));
+			for (int i = 0; i < WORDS; i++)
+				block.words[i] |= mask.words[i];
+
+			return ALGOGIN_ERROR::OK;
+		}
+
+		//insert all keys from range, threads set bits with atomic or, so result is the same as for sequential insert
+		template <std::ranges::random_access_range Range>
+		ALGOGIN_ERROR build(const Range& range, int threads = 0) {
+			auto begin = std::ranges::begin(range);
+			filter::parallelFor(std::ranges::size(range), threads, [this, begin](size_t i) {
+				uint64_t hash = _hasher(begin[i]);
+				Block& block = _getBlock(hash);
+				Block mask = _getMask(static_cast<uint32_t>(hash));
+				for (int word = 0; word < WORDS; word++)
+					std::atomic_ref<uint32_t>(block.words[word]).fetch_or(mask.words[word], std::memory_order_relaxed);
+			});
+
+			return ALGOGIN_ERROR::OK;
+		}
+
+		//false means key is definitely absent, true means key is probably present
+		bool contains(const Comparable& key) const noexcept {
+			return _contains(key);
+		}
+
+		template <class K> requires TransparentHash<Hasher> && (!std::is_same_v<std::remove_cvref_t<K>, Comparable>)
+		bool contains(const K& key) const noexcept {
+			return _contains(key);
+		}
+
+		size_t getBits() const noexcept {
+			return _blocks.size() * WORDS * 32;
+		}
+
+		//instruction set of contains, the widest supported by CPU by default; wider than supported one is ignored
+		void setLevel(filter::Level level) noexcept {
+			_level = std::min(level, filter::getLevel());
+		}
+
+		filter::Level getLevel() const noexcept {
+			return _level;
+		}
+
+		ALGOGIN_ERROR dump(const std::filesystem::path& path) const {
+			return filter::dump(path, KIND, 0, _blocks);
+		}
+
+		ALGOGIN_ERROR load(const std::filesystem::path& path) {
+			uint64_t parameter;
+			std::vector<Block> blocks;
+			auto error = filter::load(path, KIND, parameter, blocks);
+			if (error != ALGOGIN_ERROR::OK)
+				return error;
+			//filter always has at least one block
+			if (blocks.empty())
+				return ALGOGIN_ERROR::UNKNOWN_ERROR;
+
+			_blocks = std::move(blocks);
+			return ALGOGIN_ERROR::OK;
+		}
+	};
+
+	//Cuckoo filter: bucket keeps 4 16-bit fingerprints, key can be in one of 2 buckets, alternative bucket is computed
+	//from fingerprint only (partial-key cuckoo hashing), so fingerprints can be moved without original keys.
+	//Unlike Bloom filter supports remove. Bucket is checked for fingerprint with one 64-bit SWAR comparison.
+	template <class Comparable, class Hasher = Hash<Comparable>>
+	class CuckooFilter {
+	private:
+		static constexpr uint32_t KIND = 2;
+		static constexpr int WAYS = 4;
+		static constexpr int MAX_KICKS = 500;
+		static constexpr double MAX_LOAD = 0.95;
+
+		//every bucket is uint64_t: 4 fingerprints by 16 bits, 0 - empty slot
+		std::vector<uint64_t> _buckets;
+		uint64_t _mask = 0;
+		size_t _size = 0;
+		//fingerprint which couldn't be placed, filter is full when it's set
+		uint16_t _victimFingerprint = 0;
+		uint64_t _victimIndex = 0;
+		uint64_t _random = 0x9e3779b97f4a7c15ull;
+		Hasher _hasher;
+
+		static uint16_t _getFingerprint(uint64_t hash) noexcept {
+			uint16_t fingerprint = static_cast<uint16_t>(hash >> 48);
+			return fingerprint == 0 ? 1 : fingerprint;
+		}
+
+		uint64_t _getAlternative(uint64_t index, uint16_t fingerprint) const noexcept {
+			return (index ^ hashing::mix(fingerprint)) & _mask;
+		}
+
+		//returns number of slot + 1 with fingerprint, 0 if there is no such
+		static int _findSlot(uint64_t bucket, uint16_t fingerprint) noexcept {
+			//slots equal to fingerprint become zero, find zero 16-bit lane
+			uint64_t difference = bucket ^ (fingerprint * 0x0001000100010001ull);
+			uint64_t zero = (difference - 0x0001000100010001ull) & ~difference & 0x8000800080008000ull;
+			return zero ? std::countr_zero(zero) / 16 + 1 : 0;
+		}
+
+		static uint16_t _getSlot(uint64_t bucket, int slot) noexcept {
+			return static_cast<uint16_t>(bucket >> (slot * 16));
+		}
+
+		static void _setSlot(uint64_t& bucket, int slot, uint16_t fingerprint) noexcept {
+			bucket = (bucket & ~(0xffffull << (slot * 16))) | (static_cast<uint64_t>(fingerprint) << (slot * 16));
+		}
+
+		bool _placeFree(uint64_t index, uint16_t fingerprint) noexcept {
+			int slot = _findSlot(_buckets[index], 0);
+			if (slot == 0)
+				return false;
+
+			_setSlot(_buckets[index], slot - 1, fingerprint);
+			return true;
+		}
+
+		ALGOGIN_ERROR _insert(uint64_t index, uint16_t fingerprint) noexcept {
+			if (_victimFingerprint)
+				return ALGOGIN_ERROR::REJECTED;
+
+			uint64_t alternative = _getAlternative(index, fingerprint);
+			if (_placeFree(index, fingerprint) || _placeFree(alternative, fingerprint)) {
+				_size++;
+				return ALGOGIN_ERROR::OK;
+			}
+
+			if (_random & 1)
+				index = alternative;
+			for (int kick = 0; kick < MAX_KICKS; kick++) {
+				_random ^= _random << 13;
+				_random ^= _random >> 7;
+				_random ^= _random << 17;
+				int slot = _random % WAYS;
+				uint16_t victim = _getSlot(_buckets[index], slot);
+				_setSlot(_buckets[index], slot, fingerprint);
+				fingerprint = victim;
+				index = _getAlternative(index, fingerprint);
+				if (_placeFree(index, fingerprint)) {
+					_size++;
+					return ALGOGIN_ERROR::OK;
+				}
+			}
+
+			//inserted key is in table, but some other fingerprint is kicked out, keep it aside to avoid false negative
+			_victimFingerprint = fingerprint;
+			_victimIndex = index;
+			_size++;
+			return ALGOGIN_ERROR::OK;
+		}
+
+		template <class K>
+		bool _contains(const K& key) const noexcept {
+			if (_buckets.empty())
+				return false;
+
+			uint64_t hash = _hasher(key);
+			uint16_t fingerprint = _getFingerprint(hash);
+			uint64_t index = hash & _mask;
+			uint64_t alternative = _getAlternative(index, fingerprint);
+			if (_findSlot(_buckets[index], fingerprint) || _findSlot(_buckets[alternative], fingerprint))
+				return true;
+
+			return _victimFingerprint == fingerprint && (_victimIndex == index || _victimIndex == alternative);
+		}
+	public:
+		//elements - expected number of keys
+		CuckooFilter(size_t elements = 0) {
+			uint64_t buckets = std::bit_ceil(std::max<uint64_t>(2, static_cast<uint64_t>(std::ceil(elements / (WAYS * MAX_LOAD)))));
+			_buckets.resize(buckets);
+			_mask = buckets - 1;
+		}
+
+		~CuckooFilter() = default;
+		CuckooFilter(const CuckooFilter&) = default;
+		CuckooFilter(CuckooFilter&&) noexcept = default;
+		CuckooFilter& operator=(const CuckooFilter&) = default;
+		CuckooFilter& operator=(CuckooFilter&&) noexcept = default;
+
+		//returns REJECTED if filter is full
+		ALGOGIN_ERROR insert(const Comparable& key) noexcept {
+			uint64_t hash = _hasher(key);
+			return _insert(hash & _mask, _getFingerprint(hash));
+		}
+
+		//keys are hashed in parallel, fingerprints are placed sequentially because kicks can touch any bucket
+		template <std::ranges::random_access_range Range>
+		ALGOGIN_ERROR build(const Range& range, int threads = 0) {
+			std::vector<uint64_t> hashes(std::ranges::size(range));
+			auto begin = std::ranges::begin(range);
+			filter::parallelFor(hashes.size(), threads, [this, &hashes, begin](size_t i) {
+				hashes[i] = _hasher(begin[i]);
+			});
+
+			for (auto hash : hashes) {
+				auto error = _insert(hash & _mask, _getFingerprint(hash));
+				if (error != ALGOGIN_ERROR::OK)
+					return error;
+			}
+
+			return ALGOGIN_ERROR::OK;
+		}
+
+		bool contains(const Comparable& key) const noexcept {
+			return _contains(key);
+		}
+
+		template <class K> requires TransparentHash<Hasher> && (!std::is_same_v<std::remove_cvref_t<K>, Comparable>)
+		bool contains(const K& key) const noexcept {
+			return _contains(key);
+		}
+
+		//key must be inserted before, otherwise fingerprint of another key may be removed
+		ALGOGIN_ERROR remove(const Comparable& key) noexcept {
+			uint64_t hash = _hasher(key);
+			uint16_t fingerprint = _getFingerprint(hash);
+			uint64_t index = hash & _mask;
+			for (uint64_t bucket : { index, _getAlternative(index, fingerprint) }) {
+				int slot = _findSlot(_buckets[bucket], fingerprint);
+				if (slot) {
+					_setSlot(_buckets[bucket], slot - 1, 0);
+					_size--;
+					//there is free slot now, try to place victim back
+					if (_victimFingerprint) {
+						uint16_t victim = std::exchange(_victimFingerprint, 0);
+						_size--;
+						_insert(_victimIndex, victim);
+					}
+					return ALGOGIN_ERROR::OK;
+				}
+			}
+
+			if (_victimFingerprint == fingerprint && (_victimIndex == index || _victimIndex == _getAlternative(index, fingerprint))) {
+				_victimFingerprint = 0;
+				_size--;
+				return ALGOGIN_ERROR::OK;
+			}
+
+			return ALGOGIN_ERROR::NOT_FOUND;
+		}
+
+		int getSize() const noexcept {
+			return static_cast<int>(_size);
+		}
+
+		ALGOGIN_ERROR dump(const std::filesystem::path& path) const {
+			//victim is stored as the last bucket
+			auto data = _buckets;
+			data.push_back(_victimIndex << 16 | _victimFingerprint);
+			data.push_back(_size);
+			return filter::dump(path, KIND, 0, data);
+		}
+
+		ALGOGIN_ERROR load(const std::filesystem::path& path) {
+			uint64_t parameter;
+			std::vector<uint64_t> data;
+			auto error = filter::load(path, KIND, parameter, data);
+			if (error != ALGOGIN_ERROR::OK)
+				return error;
+			if (data.size() < 4 || std::has_single_bit(data.size() - 2) == false)
+				return ALGOGIN_ERROR::UNKNOWN_ERROR;
+
+			_size = data.back();
+			data.pop_back();
+			_victimFingerprint = static_cast<uint16_t>(data.back());
+			_victimIndex = data.back() >> 16;
+			data.pop_back();
+			_buckets = std::move(data);
+			_mask = _buckets.size() - 1;
+			return ALGOGIN_ERROR::OK;
+		}
+	};
+}
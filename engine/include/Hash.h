@@ -0,0 +1,153 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <functional>
+#include <concepts>
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+namespace algogin {
+	//Helpers for 64-bit hashing (wyhash-style: everything is folded by 64x64->128 bit multiplication)
+	namespace hashing {
+		constexpr uint64_t SECRET0 = 0xa0761d6478bd642full;
+		constexpr uint64_t SECRET1 = 0xe7037ed1a0b428dbull;
+		constexpr uint64_t SECRET2 = 0x8ebc6af09c88c6e3ull;
+
+		//multiply a and b as 128 bit number and return both halves
+		inline void multiply(uint64_t& a, uint64_t& b) noexcept {
+#if defined(__SIZEOF_INT128__)
+			__uint128_t result = static_cast<__uint128_t>(a) * b;
+			a = static_cast<uint64_t>(result);
+			b = static_cast<uint64_t>(result >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+			a = _umul128(a, b, &b);
+#else
+			uint64_t ha = a >> 32, hb = b >> 32, la = static_cast<uint32_t>(a), lb = static_cast<uint32_t>(b);
+			uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+			uint64_t t = rl + (rm0 << 32);
+			uint64_t carry = t < rl;
+			uint64_t low = t + (rm1 << 32);
+			carry += low < t;
+			a = low;
+			b = rh + (rm0 >> 32) + (rm1 >> 32) + carry;
+#endif
+		}
+
+		//fold 128 bit product into 64 bits
+		inline uint64_t mix(uint64_t a, uint64_t b) noexcept {
+			multiply(a, b);
+			return a ^ b;
+		}
+
+		//finalizer for values which fit 64 bits, every input bit affects every output bit
+		inline uint64_t mix(uint64_t value) noexcept {
+			return mix(value ^ SECRET0, SECRET1);
+		}
+
+		inline uint64_t read8(const uint8_t* p) noexcept {
+			uint64_t value;
+			std::memcpy(&value, p, sizeof(value));
+			return value;
+		}
+
+		inline uint64_t read4(const uint8_t* p) noexcept {
+			uint32_t value;
+			std::memcpy(&value, p, sizeof(value));
+			return value;
+		}
+
+		//hash of arbitrary byte sequence, consumes 16 bytes per multiplication
+		inline uint64_t bytes(const void* data, size_t size, uint64_t seed = 0) noexcept {
+			const uint8_t* p = static_cast<const uint8_t*>(data);
+			seed ^= mix(seed ^ SECRET0, SECRET1);
+			uint64_t a = 0, b = 0;
+			if (size <= 16) {
+				if (size >= 4) {
+					//two overlapping reads cover 4-16 bytes without branches per byte
+					size_t shift = (size >> 3) << 2;
+					a = (read4(p) << 32) | read4(p + shift);
+					b = (read4(p + size - 4) << 32) | read4(p + size - 4 - shift);
+				}
+				else if (size > 0) {
+					a = (static_cast<uint64_t>(p[0]) << 16) | (static_cast<uint64_t>(p[size >> 1]) << 8) | p[size - 1];
+				}
+			}
+			else {
+				size_t left = size;
+				if (left > 48) {
+					//three independent lanes to hide multiplication latency on long keys
+					uint64_t seed1 = seed, seed2 = seed;
+					do {
+						seed = mix(read8(p) ^ SECRET1, read8(p + 8) ^ seed);
+						seed1 = mix(read8(p + 16) ^ SECRET2, read8(p + 24) ^ seed1);
+						seed2 = mix(read8(p + 32) ^ SECRET0, read8(p + 40) ^ seed2);
+						p += 48;
+						left -= 48;
+					} while (left > 48);
+					seed ^= seed1 ^ seed2;
+				}
+				while (left > 16) {
+					seed = mix(read8(p) ^ SECRET1, read8(p + 8) ^ seed);
+					p += 16;
+					left -= 16;
+				}
+				//last 16 bytes, may overlap with already consumed ones
+				a = read8(p + left - 16);
+				b = read8(p + left - 8);
+			}
+			a ^= SECRET1;
+			b ^= seed;
+			multiply(a, b);
+			return mix(a ^ SECRET0 ^ size, b ^ SECRET1);
+		}
+	}
+
+	//Default hasher for hash based containers, returns well-mixed 64 bit value
+	//integers, enums and pointers are mixed directly, trivially copyable types without padding are hashed as bytes,
+	//other types fall back to std::hash
+	template <class T>
+	struct Hash {
+		uint64_t operator()(const T& key) const noexcept {
+			if constexpr (std::is_integral_v<T> || std::is_enum_v<T>) {
+				return hashing::mix(static_cast<uint64_t>(key));
+			}
+			else if constexpr (std::is_pointer_v<T>) {
+				return hashing::mix(reinterpret_cast<uintptr_t>(key));
+			}
+			else if constexpr (std::is_floating_point_v<T>) {
+				//0.0 and -0.0 are equal so they must have the same hash
+				if (key == T{})
+					return hashing::mix(0);
+				return hashing::bytes(&key, sizeof(T));
+			}
+			else if constexpr (std::is_trivially_copyable_v<T> && std::has_unique_object_representations_v<T>) {
+				return hashing::bytes(&key, sizeof(T));
+			}
+			else {
+				return hashing::mix(static_cast<uint64_t>(std::hash<T>{}(key)));
+			}
+		}
+	};
+
+	//string hashers are transparent: lookups can be done by std::string_view or string literal without std::string creation
+	template <>
+	struct Hash<std::string> {
+		using is_transparent = void;
+
+		uint64_t operator()(std::string_view key) const noexcept {
+			return hashing::bytes(key.data(), key.size());
+		}
+	};
+
+	template <>
+	struct Hash<std::string_view> : Hash<std::string> {
+	};
+
+	//hasher accepts not only key type itself but any type comparable with key (e.g. std::string_view for std::string)
+	template <class Hasher>
+	concept TransparentHash = requires { typename Hasher::is_transparent; };
+}
@@ -0,0 +1,33 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include "Common.h"
+
+namespace algogin {
+	//Read-only memory mapping of the whole file, used to query flat containers in place without deserialization
+	class MappedFile {
+	private:
+		const uint8_t* _data = nullptr;
+		size_t _size = 0;
+#if defined(_WIN32)
+		void* _file = nullptr;
+		void* _mapping = nullptr;
+#else
+		int _file = -1;
+#endif
+	public:
+		MappedFile() = default;
+		~MappedFile();
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+		MappedFile(MappedFile&& file) noexcept;
+		MappedFile& operator=(MappedFile&& file) noexcept;
+
+		ALGOGIN_ERROR open(const std::filesystem::path& path);
+		void close() noexcept;
+
+		const uint8_t* getData() const noexcept;
+		size_t getSize() const noexcept;
+	};
+}
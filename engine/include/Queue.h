@@ -1,114 +1,2427 @@
 #pragma once
 #include "Common.h"
 #include <vector>
-#include <functional>
 #include <optional>
+#include <tuple>
+#include <utility>
+#include <type_traits>
+#include <algorithm>
+#include <bit>
+#include <limits>
+#include <concepts>
+#include <ranges>
+#include <span>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+//AVX2 kernels are compiled with target attributes and chosen at runtime if CPU supports them
+#define ALGOGIN_QUEUE_DISPATCH
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || defined(ALGOGIN_QUEUE_DISPATCH)
+#include <immintrin.h>
+#endif
 
 namespace algogin {
+	enum class HeapLayout {
+		//priority and value are stored together
+		INTERLEAVED,
+		//priorities are stored in own array, so comparisons during sift don't load values to cache
+		SPLIT
+	};
 
-	template <class Comparable, class V>
-	class PriorityQueue {
-	private:
-		struct Heap {
+	namespace queue {
+		//instruction set used by findMinimum and findAbove, SSE2 is a baseline of x86-64 and is used without runtime check
+		enum class Level {
+			SCALAR,
+			SSE2,
+			AVX2
+		};
+
+		//the best level supported by CPU, detected once
+		inline Level getLevel() noexcept {
+#if defined(ALGOGIN_QUEUE_DISPATCH)
+			static const Level level = [] {
+				__builtin_cpu_init();
+				if (__builtin_cpu_supports("avx2"))
+					return Level::AVX2;
+#if defined(__SSE2__)
+				return Level::SSE2;
+#else
+				return __builtin_cpu_supports("sse2") ? Level::SSE2 : Level::SCALAR;
+#endif
+			}();
+			return level;
+#elif defined(_M_X64)
+			return Level::SSE2;
+#else
+			return Level::SCALAR;
+#endif
+		}
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(ALGOGIN_QUEUE_DISPATCH)
+		//kernels return index of the first minimum or -1 if there is NaN among floats
+#if defined(ALGOGIN_QUEUE_DISPATCH)
+		__attribute__((target("sse2")))
+#endif
+		inline int findMinimum4Sse2(const float* priorities) noexcept {
+			__m128 values = _mm_loadu_ps(priorities);
+			__m128 minimum = _mm_min_ps(values, _mm_shuffle_ps(values, values, _MM_SHUFFLE(2, 3, 0, 1)));
+			minimum = _mm_min_ps(minimum, _mm_shuffle_ps(minimum, minimum, _MM_SHUFFLE(1, 0, 3, 2)));
+			//min skips NaN, so order of scalar comparison can't be reproduced
+			if (_mm_movemask_ps(_mm_cmpunord_ps(values, values)))
+				return -1;
+			return std::countr_zero(static_cast<unsigned>(_mm_movemask_ps(_mm_cmpeq_ps(values, minimum))));
+		}
+
+		//SSE2 has no min for int32, it's blended from comparison
+#if defined(ALGOGIN_QUEUE_DISPATCH)
+		__attribute__((target("sse2")))
+#endif
+		inline int findMinimum4Sse2(const int32_t* priorities) noexcept {
+			auto min = [](__m128i first, __m128i second) {
+				__m128i greater = _mm_cmpgt_epi32(first, second);
+				return _mm_or_si128(_mm_and_si128(greater, second), _mm_andnot_si128(greater, first));
+			};
+			__m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(priorities));
+			__m128i minimum = min(values, _mm_shuffle_epi32(values, _MM_SHUFFLE(2, 3, 0, 1)));
+			minimum = min(minimum, _mm_shuffle_epi32(minimum, _MM_SHUFFLE(1, 0, 3, 2)));
+			int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(values, minimum)));
+			return std::countr_zero(static_cast<unsigned>(mask));
+		}
+#endif
+
+#if defined(ALGOGIN_QUEUE_DISPATCH)
+		__attribute__((target("avx2"))) inline int findMinimum4Avx2(const int32_t* priorities) noexcept {
+			__m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(priorities));
+			__m128i minimum = _mm_min_epi32(values, _mm_shuffle_epi32(values, _MM_SHUFFLE(2, 3, 0, 1)));
+			minimum = _mm_min_epi32(minimum, _mm_shuffle_epi32(minimum, _MM_SHUFFLE(1, 0, 3, 2)));
+			int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(values, minimum)));
+			return std::countr_zero(static_cast<unsigned>(mask));
+		}
+
+		__attribute__((target("avx2"))) inline int findMinimum8Avx2(const float* priorities) noexcept {
+			__m256 values = _mm256_loadu_ps(priorities);
+			__m256 minimum = _mm256_min_ps(values, _mm256_permute2f128_ps(values, values, 1));
+			minimum = _mm256_min_ps(minimum, _mm256_shuffle_ps(minimum, minimum, _MM_SHUFFLE(2, 3, 0, 1)));
+			minimum = _mm256_min_ps(minimum, _mm256_shuffle_ps(minimum, minimum, _MM_SHUFFLE(1, 0, 3, 2)));
+			if (_mm256_movemask_ps(_mm256_cmp_ps(values, values, _CMP_UNORD_Q)))
+				return -1;
+			return std::countr_zero(static_cast<unsigned>(_mm256_movemask_ps(_mm256_cmp_ps(values, minimum, _CMP_EQ_OQ))));
+		}
+
+		__attribute__((target("avx2"))) inline int findMinimum8Avx2(const int32_t* priorities) noexcept {
+			__m256i values = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(priorities));
+			__m256i minimum = _mm256_min_epi32(values, _mm256_permute2x128_si256(values, values, 1));
+			minimum = _mm256_min_epi32(minimum, _mm256_shuffle_epi32(minimum, _MM_SHUFFLE(2, 3, 0, 1)));
+			minimum = _mm256_min_epi32(minimum, _mm256_shuffle_epi32(minimum, _MM_SHUFFLE(1, 0, 3, 2)));
+			int mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(values, minimum)));
+			return std::countr_zero(static_cast<unsigned>(mask));
+		}
+
+		//handles multiple of 8 priorities, returns number of found indexes
+		template <class T>
+		__attribute__((target("avx2"))) size_t findAboveAvx2(const T* priorities, size_t count, T threshold, uint32_t* indexes) noexcept {
+			size_t found = 0;
+			for (size_t i = 0; i + 8 <= count; i += 8) {
+				unsigned mask;
+				if constexpr (std::is_same_v<T, int32_t>)
+					mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(
+						_mm256_loadu_si256(reinterpret_cast<const __m256i*>(priorities + i)), _mm256_set1_epi32(threshold))));
+				else
+					mask = _mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(priorities + i), _mm256_set1_ps(threshold), _CMP_GT_OQ));
+				for (; mask; mask &= mask - 1)
+					indexes[found++] = static_cast<uint32_t>(i + std::countr_zero(mask));
+			}
+			return found;
+		}
+#endif
+
+		//index of the minimum among Arity contiguous priorities, the first one wins if there are equal priorities;
+		//level above the one supported by CPU is lowered
+		template <int Arity, class T>
+		int findMinimum(const T* priorities, Level level = getLevel()) noexcept {
+			constexpr bool vectorized = (std::is_same_v<T, float> || std::is_same_v<T, int32_t>) && (Arity == 4 || Arity == 8);
+			if constexpr (vectorized) {
+				level = std::min(level, getLevel());
+				int minimum = -1;
+#if defined(ALGOGIN_QUEUE_DISPATCH)
+				if (level == Level::AVX2) {
+					if constexpr (Arity == 8)
+						minimum = findMinimum8Avx2(priorities);
+					else if constexpr (std::is_same_v<T, int32_t>)
+						minimum = findMinimum4Avx2(priorities);
+					else
+						minimum = findMinimum4Sse2(priorities);
+				}
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || defined(ALGOGIN_QUEUE_DISPATCH)
+				if constexpr (Arity == 4) {
+					if (level == Level::SSE2)
+						minimum = findMinimum4Sse2(priorities);
+				}
+#endif
+				//minimum isn't found for NaN, fall back to scalar comparison
+				if (minimum >= 0)
+					return minimum;
+			}
+			//branchless scalar version, compiler turns it into conditional moves
+			int minimum = 0;
+			for (int i = 1; i < Arity; i++)
+				minimum = priorities[i] < priorities[minimum] ? i : minimum;
+			return minimum;
+		}
+
+		//writes indexes of priorities bigger than threshold, returns their number; int32 and float are compared by SIMD
+		template <class T>
+		size_t findAbove(const T* priorities, size_t count, T threshold, uint32_t* indexes, Level level = getLevel()) noexcept {
+			size_t found = 0;
+			size_t i = 0;
+			if constexpr (std::is_same_v<T, int32_t> || std::is_same_v<T, float>) {
+				level = std::min(level, getLevel());
+#if defined(ALGOGIN_QUEUE_DISPATCH)
+				if (level == Level::AVX2) {
+					found = findAboveAvx2(priorities, count, threshold, indexes);
+					i = count / 8 * 8;
+				}
+#endif
+#if defined(__SSE2__) || defined(_M_X64)
+				//SSE2 kernel is left inline, it also handles tail after AVX2
+				if (level != Level::SCALAR) {
+					if constexpr (std::is_same_v<T, int32_t>) {
+						__m128i bound = _mm_set1_epi32(threshold);
+						for (; i + 4 <= count; i += 4) {
+							__m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(priorities + i));
+							unsigned mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(values, bound)));
+							for (; mask; mask &= mask - 1)
+								indexes[found++] = static_cast<uint32_t>(i + std::countr_zero(mask));
+						}
+					}
+					else {
+						__m128 bound = _mm_set1_ps(threshold);
+						for (; i + 4 <= count; i += 4) {
+							unsigned mask = _mm_movemask_ps(_mm_cmpgt_ps(_mm_loadu_ps(priorities + i), bound));
+							for (; mask; mask &= mask - 1)
+								indexes[found++] = static_cast<uint32_t>(i + std::countr_zero(mask));
+						}
+					}
+				}
+#endif
+			}
+			//branchless scalar version: index is always written, counter moves only for accepted priority
+			for (; i < count; i++) {
+				indexes[found] = static_cast<uint32_t>(i);
+				found += threshold < priorities[i];
+			}
+			return found;
+		}
+
+		//stable reference to element of queue
+		struct Handle {
+			int id = -1;
+			//distinguishes handle of erased element from handle of new element which reuses the same id
+			uint32_t generation = 0;
+		};
+
+		template <class Comparable, class V>
+		struct Element {
 			Comparable priority;
 			V value;
+			int id;
+		};
+
+		template <class Comparable, class V, HeapLayout Layout>
+		struct Storage;
+
+		template <class Comparable, class V>
+		struct Storage<Comparable, V, HeapLayout::INTERLEAVED> {
+			std::vector<Element<Comparable, V>> heap;
+
+			int size() const noexcept { return static_cast<int>(heap.size()); }
+			const Comparable& priority(int index) const noexcept { return heap[index].priority; }
+			Comparable& priority(int index) noexcept { return heap[index].priority; }
+			const V& value(int index) const noexcept { return heap[index].value; }
+			V& value(int index) noexcept { return heap[index].value; }
+			int id(int index) const noexcept { return heap[index].id; }
+			Element<Comparable, V> take(int index) noexcept { return std::move(heap[index]); }
+			void put(int index, Element<Comparable, V>&& element) noexcept { heap[index] = std::move(element); }
+			void move(int to, int from) noexcept { heap[to] = std::move(heap[from]); }
+			void pushBack(Element<Comparable, V>&& element) { heap.push_back(std::move(element)); }
+			void popBack() noexcept { heap.pop_back(); }
+			void clear() noexcept { heap.clear(); }
+			void reserve(size_t size) { heap.reserve(size); }
+		};
+
+		template <class Comparable, class V>
+		struct Storage<Comparable, V, HeapLayout::SPLIT> {
+			struct Item {
+				V value;
+				int id;
+			};
+
+			std::vector<Comparable> priorities;
+			std::vector<Item> items;
+
+			int size() const noexcept { return static_cast<int>(priorities.size()); }
+			const Comparable& priority(int index) const noexcept { return priorities[index]; }
+			Comparable& priority(int index) noexcept { return priorities[index]; }
+			const V& value(int index) const noexcept { return items[index].value; }
+			V& value(int index) noexcept { return items[index].value; }
+			int id(int index) const noexcept { return items[index].id; }
+
+			Element<Comparable, V> take(int index) noexcept {
+				return { std::move(priorities[index]), std::move(items[index].value), items[index].id };
+			}
+
+			void put(int index, Element<Comparable, V>&& element) noexcept {
+				priorities[index] = std::move(element.priority);
+				items[index] = { std::move(element.value), element.id };
+			}
+
+			void move(int to, int from) noexcept {
+				priorities[to] = std::move(priorities[from]);
+				items[to] = std::move(items[from]);
+			}
+
+			void pushBack(Element<Comparable, V>&& element) {
+				priorities.push_back(std::move(element.priority));
+				items.push_back({ std::move(element.value), element.id });
+			}
+
+			void popBack() noexcept {
+				priorities.pop_back();
+				items.pop_back();
+			}
+
+			void clear() noexcept {
+				priorities.clear();
+				items.clear();
+			}
+
+			void reserve(size_t size) {
+				priorities.reserve(size);
+				items.reserve(size);
+			}
 		};
+	}
 
-		std::vector<Heap> _heap;
+	//Min-heap with Arity children per node (binary by default). 4-ary and 8-ary heaps are twice/three times lower,
+	//and with split layout all children priorities are in one or two cache lines, so sift-down does fewer cache misses
+	//and minimum of children is found by one SIMD operation for float/int32 priorities.
+	//Every inserted element gets stable handle which stays valid while element is in queue,
+	//handles allow to change priority or erase element in O(log n): queue keeps position of every element in heap
+	//and updates it on every move during sift-up and sift-down.
+	template <class Comparable, class V, int Arity = 2, HeapLayout Layout = HeapLayout::INTERLEAVED>
+	class PriorityQueue {
+		static_assert(Arity >= 2, "heap node must have at least 2 children");
 	public:
-		PriorityQueue() = default;
-		~PriorityQueue() = default;
+		using Handle = queue::Handle;
+	private:
+		using Element = queue::Element<Comparable, V>;
+
+		struct Slot {
+			//index in heap, -1 if element isn't in queue
+			int position = -1;
+			uint32_t generation = 0;
+		};
 
-		PriorityQueue(const PriorityQueue& queue) noexcept {
-			for (int i = 0; i < queue._heap.size(); i++) {
-				_heap.push_back({ .priority = queue._heap[i].priority, .value = queue._heap[i].value });
+		queue::Storage<Comparable, V, Layout> _heap;
+		std::vector<Slot> _slots;
+		std::vector<int> _freeSlots;
+
+		//Track = false skips position index updates, caller has to restore positions itself
+		template <bool Track = true>
+		void _place(int index, Element&& element) noexcept {
+			if constexpr (Track)
+				_slots[element.id].position = index;
+			_heap.put(index, std::move(element));
+		}
+
+		template <bool Track = true>
+		void _move(int to, int from) noexcept {
+			if constexpr (Track)
+				_slots[_heap.id(from)].position = to;
+			_heap.move(to, from);
+		}
+
+		//child with the smallest priority among count children starting from first
+		int _findMinimumChild(int first, int count) const noexcept {
+			if constexpr (Layout == HeapLayout::SPLIT && std::is_arithmetic_v<Comparable>) {
+				if (count == Arity)
+					return first + queue::findMinimum<Arity>(&_heap.priority(first));
+			}
+
+			int minimum = first;
+			for (int i = first + 1; i < first + count; i++) {
+				if (_heap.priority(i) < _heap.priority(minimum))
+					minimum = i;
 			}
+			return minimum;
 		}
 
-		PriorityQueue(PriorityQueue&& queue) noexcept {
-			*this = std::move(queue);
+		//moves element up while it's less than parent, "hole" is moved instead of swaps
+		void _siftUp(int index) noexcept {
+			Element element = _heap.take(index);
+			while (index > 0) {
+				int parentIndex = (index - 1) / Arity;
+				if ((_heap.priority(parentIndex) > element.priority) == false)
+					break;
+
+				_move(index, parentIndex);
+				index = parentIndex;
+			}
+			_place(index, std::move(element));
 		}
 
-		PriorityQueue& operator=(const PriorityQueue& queue) noexcept {
-			_heap.clear();
+		//moves element down while it's bigger than the smallest child
+		template <bool Track = true>
+		void _siftDown(int index) noexcept {
+			Element element = _heap.take(index);
+			int size = _heap.size();
+			while (true) {
+				int first = index * Arity + 1;
+				if (first >= size)
+					break;
+				int childMinimum = _findMinimumChild(first, std::min(Arity, size - first));
+				if ((element.priority > _heap.priority(childMinimum)) == false)
+					break;
 
-			for (int i = 0; i < queue._heap.size(); i++) {
-				_heap.push_back({ .priority = queue._heap[i].priority, .value = queue._heap[i].value });
+				_move<Track>(index, childMinimum);
+				index = childMinimum;
 			}
+			_place<Track>(index, std::move(element));
+		}
 
-			return *this;
+		//puts the last element to the index and restores heap property
+		void _removeAt(int index) noexcept {
+			_releaseSlot(_heap.id(index));
+			int last = _heap.size() - 1;
+			if (index != last) {
+				_heap.move(index, last);
+				_heap.popBack();
+				if (index > 0 && _heap.priority((index - 1) / Arity) > _heap.priority(index))
+					_siftUp(index);
+				else
+					_siftDown(index);
+			}
+			else {
+				_heap.popBack();
+			}
+		}
+
+		int _acquireSlot() {
+			if (_freeSlots.empty() == false) {
+				int id = _freeSlots.back();
+				_freeSlots.pop_back();
+				return id;
+			}
+
+			_slots.push_back(Slot());
+			return static_cast<int>(_slots.size()) - 1;
+		}
+
+		void _releaseSlot(int id) {
+			_slots[id].position = -1;
+			_slots[id].generation++;
+			_freeSlots.push_back(id);
+		}
+
+		//returns -1 if handle doesn't point to element in queue
+		int _getPosition(Handle handle) const noexcept {
+			if (handle.id < 0 || handle.id >= _slots.size() || _slots[handle.id].generation != handle.generation)
+				return -1;
+
+			return _slots[handle.id].position;
+		}
+		//appends element to the end of the heap without restoring heap property
+		int _append(Comparable&& priority, V&& value) {
+			int id = _acquireSlot();
+			_slots[id].position = _heap.size();
+			_heap.pushBack(Element{ .priority = std::move(priority), .value = std::move(value), .id = id });
+			return id;
+		}
+
+		//appends all elements of range, heap property is restored by Floyd's bottom-up heapify in O(n) if many elements
+		//are added, otherwise every new element is sifted up in O(log n)
+		template <class Range>
+		void _appendRange(Range&& range, std::vector<Handle>* handles) {
+			int oldSize = _heap.size();
+			//exact reserve for small batches would break geometric growth of vector
+			if constexpr (std::ranges::sized_range<Range>) {
+				if (std::ranges::size(range) >= oldSize)
+					_heap.reserve(oldSize + std::ranges::size(range));
+			}
+			for (auto&& elem : range) {
+				//elements of rvalue range are moved
+				if constexpr (std::is_rvalue_reference_v<Range&&>)
+					_append(std::move(std::get<0>(elem)), std::move(std::get<1>(elem)));
+				else
+					_append(Comparable(std::get<0>(elem)), V(std::get<1>(elem)));
+			}
+
+			int size = _heap.size();
+			if (handles) {
+				for (int i = oldSize; i < size; i++)
+					handles->push_back(Handle{ .id = _heap.id(i), .generation = _slots[_heap.id(i)].generation });
+			}
+
+			if (size > 1 && size - oldSize >= oldSize) {
+				//positions are restored in one pass after heapify instead of on every move
+				for (int i = (size - 2) / Arity; i >= 0; i--)
+					_siftDown<false>(i);
+				for (int i = 0; i < size; i++)
+					_slots[_heap.id(i)].position = i;
+			}
+			else {
+				for (int i = oldSize; i < size; i++)
+					_siftUp(i);
+			}
+		}
+	public:
+		PriorityQueue() = default;
+
+		//builds queue from range of (priority, value) pairs in O(n)
+		template <std::ranges::input_range Range> requires (!std::is_same_v<std::remove_cvref_t<Range>, PriorityQueue>)
+		explicit PriorityQueue(Range&& range) {
+			_appendRange(std::forward<Range>(range), nullptr);
+		}
+
+		~PriorityQueue() = default;
+		PriorityQueue(const PriorityQueue& queue) = default;
+
+		PriorityQueue(PriorityQueue&& queue) noexcept {
+			*this = std::move(queue);
 		}
 
+		PriorityQueue& operator=(const PriorityQueue& queue) = default;
+
 		PriorityQueue& operator=(PriorityQueue&& queue) noexcept {
 			_heap = std::move(queue._heap);
+			_slots = std::move(queue._slots);
+			_freeSlots = std::move(queue._freeSlots);
 			queue._heap.clear();
+			queue._slots.clear();
+			queue._freeSlots.clear();
 
 			return *this;
 		}
 
-		ALGOGIN_ERROR insert(Comparable priority, V value) {
-			//first we insert element to the end of the heap
-			_heap.push_back(Heap{ .priority = priority, .value = value });
+		Handle insert(Comparable priority, V value) {
+			//first we insert element to the end of the heap, then move it up
+			int id = _append(std::move(priority), std::move(value));
+			_siftUp(_heap.size() - 1);
 
-			int index = _heap.size() - 1;
-			int parentIndex = (index - 1) / 2;
+			return Handle{ .id = id, .generation = _slots[id].generation };
+		}
 
-			//now we should swap this element with parent node if the element less than parent + repeat recursively
-			while (parentIndex != index && _heap[parentIndex].priority > _heap[index].priority) {
-				//swap parent and current elements
-				std::swap(_heap[parentIndex], _heap[index]);
+		//value is constructed from arguments
+		template <class... Args>
+		Handle emplace(Comparable priority, Args&&... args) {
+			return insert(std::move(priority), V(std::forward<Args>(args)...));
+		}
 
-				index = parentIndex;
-				parentIndex = (index - 1) / 2;
-			}
+		//inserts range of (priority, value) pairs, returns handles in order of range
+		template <std::ranges::input_range Range>
+		std::vector<Handle> insertBulk(Range&& range) {
+			std::vector<Handle> handles;
+			_appendRange(std::forward<Range>(range), &handles);
+			return handles;
+		}
+
+		//returns NOT_FOUND if element isn't in queue, REJECTED if new priority is bigger than current one
+		ALGOGIN_ERROR decreaseKey(Handle handle, Comparable priority) {
+			int index = _getPosition(handle);
+			if (index < 0)
+				return ALGOGIN_ERROR::NOT_FOUND;
+			if (priority > _heap.priority(index))
+				return ALGOGIN_ERROR::REJECTED;
+
+			_heap.priority(index) = std::move(priority);
+			_siftUp(index);
+
+			return ALGOGIN_ERROR::OK;
+		}
+
+		//sets any priority, element is moved up or down
+		ALGOGIN_ERROR update(Handle handle, Comparable priority) {
+			int index = _getPosition(handle);
+			if (index < 0)
+				return ALGOGIN_ERROR::NOT_FOUND;
+
+			bool increased = priority > _heap.priority(index);
+			_heap.priority(index) = std::move(priority);
+			if (increased)
+				_siftDown(index);
+			else
+				_siftUp(index);
+
+			return ALGOGIN_ERROR::OK;
+		}
 
+		ALGOGIN_ERROR erase(Handle handle) {
+			int index = _getPosition(handle);
+			if (index < 0)
+				return ALGOGIN_ERROR::NOT_FOUND;
+
+			_removeAt(index);
 			return ALGOGIN_ERROR::OK;
 		}
 
+		bool contains(Handle handle) const noexcept {
+			return _getPosition(handle) >= 0;
+		}
+
+		int getSize() const noexcept {
+			return _heap.size();
+		}
+
 		std::vector<std::tuple<Comparable, V>> traversal(TraversalMode mode) {
 			std::vector<std::tuple<Comparable, V>> result;
-			for (auto elem : _heap) {
-				result.push_back({elem.priority, elem.value});
+			for (int i = 0; i < _heap.size(); i++) {
+				result.push_back({ _heap.priority(i), _heap.value(i) });
 			}
 
 			return result;
 		}
 
+		//minimum element without removal, references are valid until queue is modified
+		std::optional<std::tuple<const Comparable&, const V&>> top() const noexcept {
+			if (_heap.size() == 0)
+				return std::nullopt;
+
+			return std::tuple<const Comparable&, const V&>{ _heap.priority(0), _heap.value(0) };
+		}
+
+		//removes minimum element and moves it to output arguments, returns NOT_FOUND if queue is empty
+		ALGOGIN_ERROR popInto(Comparable& priority, V& value) {
+			if (_heap.size() == 0)
+				return ALGOGIN_ERROR::NOT_FOUND;
+
+			priority = std::move(_heap.priority(0));
+			value = std::move(_heap.value(0));
+			_removeAt(0);
+
+			return ALGOGIN_ERROR::OK;
+		}
+
+		ALGOGIN_ERROR popInto(V& value) {
+			if (_heap.size() == 0)
+				return ALGOGIN_ERROR::NOT_FOUND;
+
+			value = std::move(_heap.value(0));
+			_removeAt(0);
+
+			return ALGOGIN_ERROR::OK;
+		}
+
 		std::optional<std::tuple<Comparable, V>> getMinimum() {
 			if (_heap.size() == 0)
 				return std::nullopt;
 
-			std::tuple<Comparable, V> result = { _heap[0].priority, _heap[0].value };
+			std::tuple<Comparable, V> result = { std::move(_heap.priority(0)), std::move(_heap.value(0)) };
+			_removeAt(0);
 
-			//first we have to swap minimum element with the last element		
-			std::swap(_heap[0], _heap[_heap.size() - 1]);
-			//remove last element
-			_heap.pop_back();
-			//heapify (if parent bigger than child then need to swap with the smallest child)
-			int index = 0;
-			std::function findMinimumChild = [&heap = _heap](int index) -> int {
-				int leftChild = index * 2 + 1;
-				int rightChild = index * 2 + 2;
-				int childMinimum = -1;
-				if (leftChild < heap.size()) {
-					childMinimum = leftChild;
+			return result;
+		}
+	};
+
+	namespace queue {
+		//Elements distributed between buckets (vectors) with position index for handles, used by monotone queues.
+		//Element is removed from bucket by moving the last element of bucket to its place.
+		template <class Comparable, class V>
+		struct Buckets {
+			struct Location {
+				int bucket = -1;
+				int index = -1;
+				uint32_t generation = 0;
+			};
+
+			std::vector<std::vector<Element<Comparable, V>>> buckets;
+			std::vector<Location> slots;
+			std::vector<int> freeSlots;
+			int size = 0;
+
+			Handle add(int bucket, Comparable&& priority, V&& value) {
+				int id;
+				if (freeSlots.empty() == false) {
+					id = freeSlots.back();
+					freeSlots.pop_back();
 				}
-				if (rightChild < heap.size() && heap[rightChild].priority < heap[leftChild].priority) {
-					childMinimum = rightChild;
+				else {
+					id = static_cast<int>(slots.size());
+					slots.push_back(Location());
 				}
 
-				return childMinimum;
-			};
+				push(bucket, Element<Comparable, V>{ .priority = std::move(priority), .value = std::move(value), .id = id });
+				size++;
+				return Handle{ .id = id, .generation = slots[id].generation };
+			}
 
-			int childMinimum = findMinimumChild(index);
-			while (childMinimum > 0 && _heap[index].priority > _heap[childMinimum].priority) {
-				std::swap(_heap[index], _heap[childMinimum]);
+			void push(int bucket, Element<Comparable, V>&& element) {
+				slots[element.id].bucket = bucket;
+				slots[element.id].index = static_cast<int>(buckets[bucket].size());
+				buckets[bucket].push_back(std::move(element));
+			}
 
-				index = childMinimum;
-				childMinimum = findMinimumChild(index);
+			//removes element from bucket, its id stays reserved
+			Element<Comparable, V> take(int bucket, int index) noexcept {
+				auto& elements = buckets[bucket];
+				Element<Comparable, V> element = std::move(elements[index]);
+				if (index != elements.size() - 1) {
+					elements[index] = std::move(elements.back());
+					slots[elements[index].id].index = index;
+				}
+				elements.pop_back();
+				return element;
+			}
+
+			void release(int id) {
+				slots[id].bucket = -1;
+				slots[id].generation++;
+				freeSlots.push_back(id);
+				size--;
+			}
+
+			//nullptr if handle doesn't point to element in queue
+			const Location* find(Handle handle) const noexcept {
+				if (handle.id < 0 || handle.id >= slots.size() || slots[handle.id].generation != handle.generation ||
+					slots[handle.id].bucket < 0)
+					return nullptr;
+
+				return &slots[handle.id];
+			}
+
+			void clear() noexcept {
+				for (auto& bucket : buckets)
+					bucket.clear();
+				slots.clear();
+				freeSlots.clear();
+				size = 0;
+			}
+		};
+	}
+
+	//Radix heap for unsigned integral priorities which never decrease below the last extracted minimum
+	//(event times, Dijkstra distances). Bucket i keeps elements which differ from the last minimum in bit i - 1 as
+	//the highest, so element moves only to lower buckets and is redistributed at most digits times:
+	//insert is O(1), getMinimum is amortized O(log C) with cheap bit operations instead of comparisons.
+	//Interface is the same as PriorityQueue; priority below the last minimum is rejected (insert returns invalid handle).
+	template <class Comparable, class V>
+	class RadixHeap {
+		static_assert(std::unsigned_integral<Comparable>, "radix heap requires unsigned integral priorities");
+	public:
+		using Handle = queue::Handle;
+	private:
+		static constexpr int BUCKETS = std::numeric_limits<Comparable>::digits + 1;
+
+		mutable queue::Buckets<Comparable, V> _buckets;
+		mutable Comparable _last = 0;
+
+		int _getBucket(Comparable priority) const noexcept {
+			return std::bit_width(static_cast<Comparable>(priority ^ _last));
+		}
+
+		//moves the smallest elements to bucket 0 if it's empty
+		void _refill() const {
+			if (_buckets.buckets[0].empty() == false || _buckets.size == 0)
+				return;
+
+			int bucket = 1;
+			while (_buckets.buckets[bucket].empty())
+				bucket++;
+
+			auto& elements = _buckets.buckets[bucket];
+			_last = std::min_element(elements.begin(), elements.end(), [](auto& left, auto& right) {
+				return left.priority < right.priority;
+			})->priority;
+			//all elements go to lower buckets because they share bits above bucket with new minimum
+			while (elements.empty() == false) {
+				auto element = std::move(elements.back());
+				elements.pop_back();
+				_buckets.push(_getBucket(element.priority), std::move(element));
+			}
+		}
+
+		ALGOGIN_ERROR _move(Handle handle, Comparable priority, bool decreaseOnly) {
+			auto location = _buckets.find(handle);
+			if (location == nullptr)
+				return ALGOGIN_ERROR::NOT_FOUND;
+			auto& current = _buckets.buckets[location->bucket][location->index];
+			if (priority < _last || (decreaseOnly && priority > current.priority))
+				return ALGOGIN_ERROR::REJECTED;
+
+			auto element = _buckets.take(location->bucket, location->index);
+			element.priority = priority;
+			_buckets.push(_getBucket(priority), std::move(element));
+
+			return ALGOGIN_ERROR::OK;
+		}
+	public:
+		RadixHeap() {
+			_buckets.buckets.resize(BUCKETS);
+		}
+
+		template <std::ranges::input_range Range> requires (!std::is_same_v<std::remove_cvref_t<Range>, RadixHeap>)
+		explicit RadixHeap(Range&& range) : RadixHeap() {
+			insertBulk(std::forward<Range>(range));
+		}
+
+		~RadixHeap() = default;
+		RadixHeap(const RadixHeap&) = default;
+		RadixHeap& operator=(const RadixHeap&) = default;
+
+		RadixHeap(RadixHeap&& queue) noexcept {
+			*this = std::move(queue);
+		}
+
+		RadixHeap& operator=(RadixHeap&& queue) noexcept {
+			_buckets = std::move(queue._buckets);
+			_last = std::exchange(queue._last, 0);
+			queue._buckets.buckets.assign(BUCKETS, {});
+			queue._buckets.clear();
+
+			return *this;
+		}
+
+		//returns invalid handle if priority is less than the last extracted minimum
+		Handle insert(Comparable priority, V value) {
+			if (priority < _last)
+				return Handle();
+
+			int bucket = _getBucket(priority);
+			return _buckets.add(bucket, std::move(priority), std::move(value));
+		}
+
+		template <class... Args>
+		Handle emplace(Comparable priority, Args&&... args) {
+			return insert(priority, V(std::forward<Args>(args)...));
+		}
+
+		template <std::ranges::input_range Range>
+		std::vector<Handle> insertBulk(Range&& range) {
+			std::vector<Handle> handles;
+			for (auto&& elem : range) {
+				if constexpr (std::is_rvalue_reference_v<Range&&>)
+					handles.push_back(insert(std::get<0>(elem), std::move(std::get<1>(elem))));
+				else
+					handles.push_back(insert(std::get<0>(elem), std::get<1>(elem)));
+			}
+
+			return handles;
+		}
+
+		//returns NOT_FOUND if element isn't in queue, REJECTED if new priority is bigger than current one or
+		//less than the last extracted minimum
+		ALGOGIN_ERROR decreaseKey(Handle handle, Comparable priority) {
+			return _move(handle, priority, true);
+		}
+
+		ALGOGIN_ERROR update(Handle handle, Comparable priority) {
+			return _move(handle, priority, false);
+		}
+
+		ALGOGIN_ERROR erase(Handle handle) {
+			auto location = _buckets.find(handle);
+			if (location == nullptr)
+				return ALGOGIN_ERROR::NOT_FOUND;
+
+			_buckets.take(location->bucket, location->index);
+			_buckets.release(handle.id);
+			return ALGOGIN_ERROR::OK;
+		}
+
+		bool contains(Handle handle) const noexcept {
+			return _buckets.find(handle) != nullptr;
+		}
+
+		int getSize() const noexcept {
+			return _buckets.size;
+		}
+
+		std::vector<std::tuple<Comparable, V>> traversal(TraversalMode mode) {
+			std::vector<std::tuple<Comparable, V>> result;
+			for (auto& bucket : _buckets.buckets) {
+				for (auto& elem : bucket)
+					result.push_back({ elem.priority, elem.value });
 			}
 
 			return result;
 		}
+
+		std::optional<std::tuple<const Comparable&, const V&>> top() const {
+			if (_buckets.size == 0)
+				return std::nullopt;
+
+			_refill();
+			auto& element = _buckets.buckets[0].back();
+			return std::tuple<const Comparable&, const V&>{ element.priority, element.value };
+		}
+
+		ALGOGIN_ERROR popInto(Comparable& priority, V& value) {
+			if (_buckets.size == 0)
+				return ALGOGIN_ERROR::NOT_FOUND;
+
+			_refill();
+			auto element = _buckets.take(0, static_cast<int>(_buckets.buckets[0].size()) - 1);
+			_buckets.release(element.id);
+			priority = element.priority;
+			value = std::move(element.value);
+
+			return ALGOGIN_ERROR::OK;
+		}
+
+		ALGOGIN_ERROR popInto(V& value) {
+			Comparable priority;
+			return popInto(priority, value);
+		}
+
+		std::optional<std::tuple<Comparable, V>> getMinimum() {
+			if (_buckets.size == 0)
+				return std::nullopt;
+
+			_refill();
+			auto element = _buckets.take(0, static_cast<int>(_buckets.buckets[0].size()) - 1);
+			_buckets.release(element.id);
+			return std::tuple<Comparable, V>{ element.priority, std::move(element.value) };
+		}
+	};
+
+	//Bucket queue (Dial's algorithm) for integral priorities from window [last minimum, last minimum + range]:
+	//one bucket per priority in circular array, insert and remove are O(1), getMinimum scans empty buckets,
+	//which is amortized O(1) if priorities grow by small steps. Suits small ranges (e.g. graphs with small edge weights).
+	//Interface is the same as PriorityQueue; priority out of window is rejected (insert returns invalid handle).
+	template <class Comparable, class V>
+	class BucketQueue {
+		static_assert(std::integral<Comparable>, "bucket queue requires integral priorities");
+	public:
+		using Handle = queue::Handle;
+	private:
+		mutable queue::Buckets<Comparable, V> _buckets;
+		mutable Comparable _last = 0;
+		Comparable _range;
+		size_t _mask;
+
+		int _getBucket(Comparable priority) const noexcept {
+			return static_cast<int>(static_cast<size_t>(priority) & _mask);
+		}
+
+		//moves cursor to the first non-empty bucket, all priorities are in window so bucket keeps equal priorities
+		void _refill() const noexcept {
+			while (_buckets.buckets[_getBucket(_last)].empty())
+				_last++;
+		}
+
+		bool _inWindow(Comparable priority) const noexcept {
+			return priority >= _last && priority - _last <= _range;
+		}
+
+		ALGOGIN_ERROR _move(Handle handle, Comparable priority, bool decreaseOnly) {
+			auto location = _buckets.find(handle);
+			if (location == nullptr)
+				return ALGOGIN_ERROR::NOT_FOUND;
+			auto& current = _buckets.buckets[location->bucket][location->index];
+			if (_inWindow(priority) == false || (decreaseOnly && priority > current.priority))
+				return ALGOGIN_ERROR::REJECTED;
+
+			auto element = _buckets.take(location->bucket, location->index);
+			element.priority = priority;
+			_buckets.push(_getBucket(priority), std::move(element));
+
+			return ALGOGIN_ERROR::OK;
+		}
+	public:
+		//range - maximum difference between any priority in queue and the last extracted minimum
+		BucketQueue(Comparable range = 1 << 16) : _range(range) {
+			size_t buckets = std::bit_ceil(static_cast<size_t>(range) + 1);
+			_buckets.buckets.resize(buckets);
+			_mask = buckets - 1;
+		}
+
+		~BucketQueue() = default;
+		BucketQueue(const BucketQueue&) = default;
+		BucketQueue& operator=(const BucketQueue&) = default;
+
+		BucketQueue(BucketQueue&& queue) noexcept {
+			*this = std::move(queue);
+		}
+
+		BucketQueue& operator=(BucketQueue&& queue) noexcept {
+			_buckets = std::move(queue._buckets);
+			_last = std::exchange(queue._last, 0);
+			_range = queue._range;
+			_mask = queue._mask;
+			queue._buckets.buckets.assign(_mask + 1, {});
+			queue._buckets.clear();
+
+			return *this;
+		}
+
+		//returns invalid handle if priority is out of window
+		Handle insert(Comparable priority, V value) {
+			if (_inWindow(priority) == false)
+				return Handle();
+
+			int bucket = _getBucket(priority);
+			return _buckets.add(bucket, std::move(priority), std::move(value));
+		}
+
+		template <class... Args>
+		Handle emplace(Comparable priority, Args&&... args) {
+			return insert(priority, V(std::forward<Args>(args)...));
+		}
+
+		template <std::ranges::input_range Range>
+		std::vector<Handle> insertBulk(Range&& range) {
+			std::vector<Handle> handles;
+			for (auto&& elem : range) {
+				if constexpr (std::is_rvalue_reference_v<Range&&>)
+					handles.push_back(insert(std::get<0>(elem), std::move(std::get<1>(elem))));
+				else
+					handles.push_back(insert(std::get<0>(elem), std::get<1>(elem)));
+			}
+
+			return handles;
+		}
+
+		ALGOGIN_ERROR decreaseKey(Handle handle, Comparable priority) {
+			return _move(handle, priority, true);
+		}
+
+		ALGOGIN_ERROR update(Handle handle, Comparable priority) {
+			return _move(handle, priority, false);
+		}
+
+		ALGOGIN_ERROR erase(Handle handle) {
+			auto location = _buckets.find(handle);
+			if (location == nullptr)
+				return ALGOGIN_ERROR::NOT_FOUND;
+
+			_buckets.take(location->bucket, location->index);
+			_buckets.release(handle.id);
+			return ALGOGIN_ERROR::OK;
+		}
+
+		bool contains(Handle handle) const noexcept {
+			return _buckets.find(handle) != nullptr;
+		}
+
+		int getSize() const noexcept {
+			return _buckets.size;
+		}
+
+		std::vector<std::tuple<Comparable, V>> traversal(TraversalMode mode) {
+			std::vector<std::tuple<Comparable, V>> result;
+			for (auto& bucket : _buckets.buckets) {
+				for (auto& elem : bucket)
+					result.push_back({ elem.priority, elem.value });
+			}
+
+			return result;
+		}
+
+		std::optional<std::tuple<const Comparable&, const V&>> top() const {
+			if (_buckets.size == 0)
+				return std::nullopt;
+
+			_refill();
+			auto& element = _buckets.buckets[_getBucket(_last)].back();
+			return std::tuple<const Comparable&, const V&>{ element.priority, element.value };
+		}
+
+		ALGOGIN_ERROR popInto(Comparable& priority, V& value) {
+			if (_buckets.size == 0)
+				return ALGOGIN_ERROR::NOT_FOUND;
+
+			_refill();
+			int bucket = _getBucket(_last);
+			auto element = _buckets.take(bucket, static_cast<int>(_buckets.buckets[bucket].size()) - 1);
+			_buckets.release(element.id);
+			priority = element.priority;
+			value = std::move(element.value);
+
+			return ALGOGIN_ERROR::OK;
+		}
+
+		ALGOGIN_ERROR popInto(V& value) {
+			Comparable priority;
+			return popInto(priority, value);
+		}
+
+		std::optional<std::tuple<Comparable, V>> getMinimum() {
+			if (_buckets.size == 0)
+				return std::nullopt;
+
+			_refill();
+			int bucket = _getBucket(_last);
+			auto element = _buckets.take(bucket, static_cast<int>(_buckets.buckets[bucket].size()) - 1);
+			_buckets.release(element.id);
+			return std::tuple<Comparable, V>{ element.priority, std::move(element.value) };
+		}
+	};
+
+	//priority queue for priorities which never go below the last extracted minimum:
+	//radix heap for unsigned integral priorities, binary heap for others
+	template <class Comparable, class V>
+	using MonotonePriorityQueue = std::conditional_t<std::unsigned_integral<Comparable>, RadixHeap<Comparable, V>, PriorityQueue<Comparable, V>>;
+
+	//Hierarchical timer wheel: Levels wheels of 2^SlotBits slots, level l keeps timers which expire in the current
+	//range of 2^(SlotBits * (l + 1)) ticks but not in the current range of level l - 1. Every slot is intrusive doubly
+	//linked list, so schedule and cancel are O(1). When time crosses the boundary of level l range, timers of the next
+	//slot of level l are cascaded to lower levels, every timer is moved at most Levels times. Level 0 slot holds timers
+	//of one tick, they expire together as a batch.
+	template <class V, int SlotBits = 8, int Levels = 8>
+	class TimerWheel {
+		static_assert(SlotBits >= 1 && SlotBits < 31, "slot count must fit to int");
+		static_assert(SlotBits * Levels >= 64, "wheel must cover 64-bit time");
+		//range of every level is shifted by level * SlotBits, shift by 64 or more is undefined
+		static_assert(SlotBits * (Levels - 1) < 64, "last level must start below 64 bits");
+	public:
+		using Handle = queue::Handle;
+	private:
+		static constexpr int SLOTS = 1 << SlotBits;
+		static constexpr uint64_t MASK = SLOTS - 1;
+
+		struct Timer {
+			uint64_t expiration = 0;
+			//tick when timer fires: expiration or the next tick if expiration was in the past
+			uint64_t tick = 0;
+			std::optional<V> value;
+			int previous = -1;
+			int next = -1;
+			//index of list, -1 if timer is free
+			int slot = -1;
+			uint32_t generation = 0;
+		};
+
+		std::vector<Timer> _timers;
+		std::vector<int> _freeTimers;
+		std::vector<int> _heads = std::vector<int>(SLOTS * Levels, -1);
+		//number of timers on every level, used to skip empty ticks
+		int _counts[Levels] = {};
+		uint64_t _now = 0;
+		int _size = 0;
+
+		//level is defined by the highest bit where tick differs from current time
+		int _getSlot(uint64_t tick) const noexcept {
+			if (tick == _now)
+				return static_cast<int>(tick & MASK);
+			int level = (std::bit_width(tick ^ _now) - 1) / SlotBits;
+			return level * SLOTS + static_cast<int>((tick >> (level * SlotBits)) & MASK);
+		}
+
+		void _link(int id, int slot) noexcept {
+			auto& timer = _timers[id];
+			timer.slot = slot;
+			timer.previous = -1;
+			timer.next = _heads[slot];
+			if (timer.next >= 0)
+				_timers[timer.next].previous = id;
+			_heads[slot] = id;
+			_counts[slot / SLOTS]++;
+		}
+
+		void _unlink(int id) noexcept {
+			auto& timer = _timers[id];
+			if (timer.previous >= 0)
+				_timers[timer.previous].next = timer.next;
+			else
+				_heads[timer.slot] = timer.next;
+			if (timer.next >= 0)
+				_timers[timer.next].previous = timer.previous;
+			_counts[timer.slot / SLOTS]--;
+		}
+
+		void _release(int id) {
+			auto& timer = _timers[id];
+			timer.slot = -1;
+			timer.value.reset();
+			timer.generation++;
+			_freeTimers.push_back(id);
+			_size--;
+		}
+
+		//timers of level slot which time has reached are moved to lower levels
+		void _cascade() {
+			for (int level = 1; level < Levels; level++) {
+				if ((_now & ((1ull << (level * SlotBits)) - 1)) != 0)
+					break;
+
+				int slot = level * SLOTS + static_cast<int>((_now >> (level * SlotBits)) & MASK);
+				int id = std::exchange(_heads[slot], -1);
+				while (id >= 0) {
+					int next = _timers[id].next;
+					_counts[level]--;
+					_link(id, _getSlot(_timers[id].tick));
+					id = next;
+				}
+			}
+		}
+	public:
+		//now - initial time in ticks
+		TimerWheel(uint64_t now = 0) : _now(now) {
+		}
+
+		~TimerWheel() = default;
+		TimerWheel(const TimerWheel&) = default;
+		TimerWheel& operator=(const TimerWheel&) = default;
+
+		TimerWheel(TimerWheel&& wheel) noexcept {
+			*this = std::move(wheel);
+		}
+
+		TimerWheel& operator=(TimerWheel&& wheel) noexcept {
+			_timers = std::move(wheel._timers);
+			_freeTimers = std::move(wheel._freeTimers);
+			_heads = std::exchange(wheel._heads, std::vector<int>(SLOTS * Levels, -1));
+			std::copy(std::begin(wheel._counts), std::end(wheel._counts), std::begin(_counts));
+			std::fill(std::begin(wheel._counts), std::end(wheel._counts), 0);
+			_now = wheel._now;
+			_size = std::exchange(wheel._size, 0);
+			wheel._timers.clear();
+			wheel._freeTimers.clear();
+
+			return *this;
+		}
+
+		//timer expires when time reaches expiration (if it's already in the past - on the next tick)
+		Handle schedule(uint64_t expiration, V value) {
+			int id;
+			if (_freeTimers.empty() == false) {
+				id = _freeTimers.back();
+				_freeTimers.pop_back();
+			}
+			else {
+				id = static_cast<int>(_timers.size());
+				_timers.push_back(Timer());
+			}
+
+			_timers[id].expiration = expiration;
+			_timers[id].tick = std::max(expiration, _now + 1);
+			_timers[id].value = std::move(value);
+			_link(id, _getSlot(_timers[id].tick));
+			_size++;
+
+			return Handle{ .id = id, .generation = _timers[id].generation };
+		}
+
+		ALGOGIN_ERROR cancel(Handle handle) {
+			if (contains(handle) == false)
+				return ALGOGIN_ERROR::NOT_FOUND;
+
+			_unlink(handle.id);
+			_release(handle.id);
+			return ALGOGIN_ERROR::OK;
+		}
+
+		bool contains(Handle handle) const noexcept {
+			return handle.id >= 0 && handle.id < _timers.size() && _timers[handle.id].generation == handle.generation &&
+				_timers[handle.id].slot >= 0;
+		}
+
+		//moves time to now, for every expired timer callback(expiration, value) is called in order of ticks;
+		//callback can schedule and cancel timers. Returns number of expired timers
+		template <class F>
+		int advance(uint64_t now, F&& callback) {
+			int expired = 0;
+			while (_now < now) {
+				if (_size == 0) {
+					_now = now;
+					break;
+				}
+				//levels below the lowest non-empty one have nothing to fire until the end of its current range
+				int level = 0;
+				while (_counts[level] == 0)
+					level++;
+				if (level > 0)
+					_now = std::min<uint64_t>(now - 1, _now | ((1ull << (level * SlotBits)) - 1));
+
+				_now++;
+				_cascade();
+				int slot = static_cast<int>(_now & MASK);
+				while (_heads[slot] >= 0) {
+					int id = _heads[slot];
+					_unlink(id);
+					uint64_t expiration = _timers[id].expiration;
+					V value = std::move(_timers[id].value.value());
+					_release(id);
+					callback(expiration, value);
+					expired++;
+				}
+			}
+
+			return expired;
+		}
+
+		uint64_t getTime() const noexcept {
+			return _now;
+		}
+
+		int getSize() const noexcept {
+			return _size;
+		}
+	};
+
+	//Pairing heap: multiway tree where every node is not bigger than its children, insert and meld just link two roots
+	//(O(1)), decreaseKey cuts subtree and links it to the root (O(1)), getMinimum pairs children of root in two passes
+	//(amortized O(log n)). Nodes are allocated from chunks owned by heap, meld moves chunks of other heap to this one
+	//in O(1) per chunk, so nodes never move and handles stay valid after meld (they belong to the heap which got the elements).
+	template <class Comparable, class V>
+	class PairingHeap {
+	private:
+		struct Chunk;
+
+		struct Node {
+			std::optional<std::pair<Comparable, V>> element;
+			Node* child = nullptr;
+			Node* sibling = nullptr;
+			//parent for the first child, left sibling for others
+			Node* previous = nullptr;
+			Chunk* chunk = nullptr;
+			uint32_t generation = 0;
+		};
+
+		static constexpr int CHUNK = 1024;
+
+		struct Chunk {
+			Node nodes[CHUNK];
+			Chunk* next = nullptr;
+			//id of heap which owns nodes, handles of other heaps are rejected
+			uint64_t owner = 0;
+		};
+	public:
+		//handle of other heap is rejected as NOT_FOUND; handle must not outlive heap which owns its element
+		struct Handle {
+			Node* node = nullptr;
+			uint32_t generation = 0;
+		};
+	private:
+		Node* _root = nullptr;
+		int _size = 0;
+		Chunk* _chunks = nullptr;
+		Chunk* _lastChunk = nullptr;
+		//free nodes are linked by sibling
+		Node* _free = nullptr;
+		Node* _lastFree = nullptr;
+		//number of used nodes in the first chunk, nodes of other chunks are used or in free list
+		int _chunkUsed = CHUNK;
+		uint64_t _id = _nextId();
+
+		static uint64_t _nextId() noexcept {
+			static std::atomic<uint64_t> ids = 0;
+			return ++ids;
+		}
+
+		static const Comparable& _priority(const Node* node) noexcept {
+			return node->element->first;
+		}
+
+		Node* _allocate() {
+			if (_free) {
+				Node* node = _free;
+				_free = node->sibling;
+				if (_free == nullptr)
+					_lastFree = nullptr;
+				node->sibling = nullptr;
+				return node;
+			}
+
+			if (_chunkUsed == CHUNK) {
+				Chunk* chunk = new Chunk();
+				chunk->owner = _id;
+				for (Node& node : chunk->nodes)
+					node.chunk = chunk;
+				chunk->next = _chunks;
+				_chunks = chunk;
+				if (_lastChunk == nullptr)
+					_lastChunk = chunk;
+				_chunkUsed = 0;
+			}
+			return &_chunks->nodes[_chunkUsed++];
+		}
+
+		void _release(Node* node) noexcept {
+			node->element.reset();
+			node->generation++;
+			node->child = node->previous = nullptr;
+			node->sibling = _free;
+			_free = node;
+			if (_lastFree == nullptr)
+				_lastFree = node;
+		}
+
+		//both nodes are roots, the bigger one becomes the first child of the smaller one
+		static Node* _link(Node* first, Node* second) noexcept {
+			if (_priority(second) < _priority(first))
+				std::swap(first, second);
+
+			second->sibling = first->child;
+			if (first->child)
+				first->child->previous = second;
+			second->previous = first;
+			first->child = second;
+			return first;
+		}
+
+		//two-pass pairing of siblings list: link pairs left to right, then accumulate them right to left
+		static Node* _combine(Node* first) noexcept {
+			if (first == nullptr)
+				return nullptr;
+
+			//pairs are stacked through sibling pointer
+			Node* pairs = nullptr;
+			while (first) {
+				Node* left = first;
+				Node* right = left->sibling;
+				first = right ? right->sibling : nullptr;
+				left->sibling = left->previous = nullptr;
+				Node* merged = left;
+				if (right) {
+					right->sibling = right->previous = nullptr;
+					merged = _link(left, right);
+				}
+				merged->sibling = pairs;
+				pairs = merged;
+			}
+
+			Node* root = pairs;
+			pairs = pairs->sibling;
+			root->sibling = nullptr;
+			while (pairs) {
+				Node* next = pairs->sibling;
+				pairs->sibling = nullptr;
+				root = _link(root, pairs);
+				pairs = next;
+			}
+			root->previous = nullptr;
+			return root;
+		}
+
+		//detaches subtree of not root node from its parent
+		static void _cut(Node* node) noexcept {
+			if (node->previous->child == node)
+				node->previous->child = node->sibling;
+			else
+				node->previous->sibling = node->sibling;
+			if (node->sibling)
+				node->sibling->previous = node->previous;
+			node->sibling = node->previous = nullptr;
+		}
+
+		//removes node from tree, its children are merged back, node itself isn't released
+		void _detach(Node* node) noexcept {
+			if (node == _root) {
+				_root = _combine(node->child);
+			}
+			else {
+				_cut(node);
+				Node* children = _combine(node->child);
+				if (children)
+					_root = _link(_root, children);
+			}
+			node->child = nullptr;
+		}
+
+		bool _isValid(Handle handle) const noexcept {
+			return handle.node && handle.node->chunk->owner == _id && handle.node->generation == handle.generation &&
+				handle.node->element.has_value();
+		}
+
+		void _destroy() noexcept {
+			while (_chunks) {
+				Chunk* next = _chunks->next;
+				delete _chunks;
+				_chunks = next;
+			}
+			_lastChunk = nullptr;
+			_root = _free = _lastFree = nullptr;
+			_size = 0;
+			_chunkUsed = CHUNK;
+		}
+	public:
+		PairingHeap() = default;
+
+		template <std::ranges::input_range Range> requires (!std::is_same_v<std::remove_cvref_t<Range>, PairingHeap>)
+		explicit PairingHeap(Range&& range) {
+			insertBulk(std::forward<Range>(range));
+		}
+
+		~PairingHeap() {
+			_destroy();
+		}
+
+		//copy has new nodes, handles of source aren't valid for it
+		PairingHeap(const PairingHeap& heap) {
+			*this = heap;
+		}
+
+		PairingHeap(PairingHeap&& heap) noexcept {
+			*this = std::move(heap);
+		}
+
+		PairingHeap& operator=(const PairingHeap& heap) {
+			if (this == &heap)
+				return *this;
+
+			_destroy();
+			std::vector<const Node*> stack;
+			if (heap._root)
+				stack.push_back(heap._root);
+			while (stack.empty() == false) {
+				const Node* node = stack.back();
+				stack.pop_back();
+				insert(node->element->first, node->element->second);
+				for (Node* child = node->child; child; child = child->sibling)
+					stack.push_back(child);
+			}
+
+			return *this;
+		}
+
+		PairingHeap& operator=(PairingHeap&& heap) noexcept {
+			if (this == &heap)
+				return *this;
+
+			_destroy();
+			_root = std::exchange(heap._root, nullptr);
+			_size = std::exchange(heap._size, 0);
+			_chunks = std::exchange(heap._chunks, nullptr);
+			_lastChunk = std::exchange(heap._lastChunk, nullptr);
+			_free = std::exchange(heap._free, nullptr);
+			_lastFree = std::exchange(heap._lastFree, nullptr);
+			_chunkUsed = std::exchange(heap._chunkUsed, CHUNK);
+			//chunks keep their owner, so handles follow elements and heap gets new id
+			_id = std::exchange(heap._id, _nextId());
+
+			return *this;
+		}
+
+		Handle insert(Comparable priority, V value) {
+			Node* node = _allocate();
+			node->element.emplace(std::move(priority), std::move(value));
+			_root = _root ? _link(_root, node) : node;
+			_size++;
+
+			return Handle{ .node = node, .generation = node->generation };
+		}
+
+		template <class... Args>
+		Handle emplace(Comparable priority, Args&&... args) {
+			return insert(std::move(priority), V(std::forward<Args>(args)...));
+		}
+
+		template <std::ranges::input_range Range>
+		std::vector<Handle> insertBulk(Range&& range) {
+			std::vector<Handle> handles;
+			for (auto&& elem : range) {
+				if constexpr (std::is_rvalue_reference_v<Range&&>)
+					handles.push_back(insert(std::move(std::get<0>(elem)), std::move(std::get<1>(elem))));
+				else
+					handles.push_back(insert(std::get<0>(elem), std::get<1>(elem)));
+			}
+
+			return handles;
+		}
+
+		//moves all elements of heap to this one in O(1) per chunk of heap, heap becomes empty
+		ALGOGIN_ERROR meld(PairingHeap& heap) noexcept {
+			if (this == &heap || heap._root == nullptr)
+				return ALGOGIN_ERROR::OK;
+
+			for (Chunk* chunk = heap._chunks; chunk; chunk = chunk->next)
+				chunk->owner = _id;
+
+			_root = _root ? _link(_root, heap._root) : heap._root;
+			_size += heap._size;
+			//chunks of other heap are appended after own chunks, so the first chunk (partially used) stays the same
+			if (_chunks) {
+				_lastChunk->next = heap._chunks;
+			}
+			else {
+				_chunks = heap._chunks;
+				_chunkUsed = heap._chunkUsed;
+			}
+			_lastChunk = heap._lastChunk;
+			//unused tail of the first chunk of other heap becomes free nodes
+			if (_chunks != heap._chunks) {
+				for (int i = heap._chunkUsed; i < CHUNK; i++)
+					_release(&heap._chunks->nodes[i]);
+			}
+			if (heap._free) {
+				if (_lastFree)
+					_lastFree->sibling = heap._free;
+				else
+					_free = heap._free;
+				_lastFree = heap._lastFree;
+			}
+
+			heap._chunks = heap._lastChunk = nullptr;
+			heap._root = heap._free = heap._lastFree = nullptr;
+			heap._size = 0;
+			heap._chunkUsed = CHUNK;
+			return ALGOGIN_ERROR::OK;
+		}
+
+		//returns NOT_FOUND if element isn't in heap, REJECTED if new priority is bigger than current one
+		ALGOGIN_ERROR decreaseKey(Handle handle, Comparable priority) {
+			if (_isValid(handle) == false)
+				return ALGOGIN_ERROR::NOT_FOUND;
+			Node* node = handle.node;
+			if (priority > _priority(node))
+				return ALGOGIN_ERROR::REJECTED;
+
+			node->element->first = std::move(priority);
+			if (node != _root) {
+				_cut(node);
+				_root = _link(_root, node);
+			}
+
+			return ALGOGIN_ERROR::OK;
+		}
+
+		ALGOGIN_ERROR update(Handle handle, Comparable priority) {
+			if (_isValid(handle) == false)
+				return ALGOGIN_ERROR::NOT_FOUND;
+			if ((priority > _priority(handle.node)) == false)
+				return decreaseKey(handle, std::move(priority));
+
+			//bigger priority can break order with children: node is detached and linked back as single node
+			Node* node = handle.node;
+			_detach(node);
+			node->element->first = std::move(priority);
+			_root = _root ? _link(_root, node) : node;
+
+			return ALGOGIN_ERROR::OK;
+		}
+
+		ALGOGIN_ERROR erase(Handle handle) {
+			if (_isValid(handle) == false)
+				return ALGOGIN_ERROR::NOT_FOUND;
+
+			_detach(handle.node);
+			_release(handle.node);
+			_size--;
+			return ALGOGIN_ERROR::OK;
+		}
+
+		bool contains(Handle handle) const noexcept {
+			return _isValid(handle);
+		}
+
+		int getSize() const noexcept {
+			return _size;
+		}
+
+		std::vector<std::tuple<Comparable, V>> traversal(TraversalMode mode) {
+			std::vector<std::tuple<Comparable, V>> result;
+			std::vector<const Node*> queue;
+			if (_root)
+				queue.push_back(_root);
+			for (int i = 0; i < queue.size(); i++) {
+				result.push_back({ queue[i]->element->first, queue[i]->element->second });
+				for (Node* child = queue[i]->child; child; child = child->sibling)
+					queue.push_back(child);
+			}
+
+			return result;
+		}
+
+		//minimum element without removal, references are valid until heap is modified
+		std::optional<std::tuple<const Comparable&, const V&>> top() const noexcept {
+			if (_root == nullptr)
+				return std::nullopt;
+
+			return std::tuple<const Comparable&, const V&>{ _root->element->first, _root->element->second };
+		}
+
+		ALGOGIN_ERROR popInto(Comparable& priority, V& value) {
+			if (_root == nullptr)
+				return ALGOGIN_ERROR::NOT_FOUND;
+
+			priority = std::move(_root->element->first);
+			value = std::move(_root->element->second);
+			Node* root = _root;
+			_detach(root);
+			_release(root);
+			_size--;
+
+			return ALGOGIN_ERROR::OK;
+		}
+
+		ALGOGIN_ERROR popInto(V& value) {
+			if (_root == nullptr)
+				return ALGOGIN_ERROR::NOT_FOUND;
+
+			value = std::move(_root->element->second);
+			Node* root = _root;
+			_detach(root);
+			_release(root);
+			_size--;
+
+			return ALGOGIN_ERROR::OK;
+		}
+
+		std::optional<std::tuple<Comparable, V>> getMinimum() {
+			if (_root == nullptr)
+				return std::nullopt;
+
+			std::tuple<Comparable, V> result = { std::move(_root->element->first), std::move(_root->element->second) };
+			Node* root = _root;
+			_detach(root);
+			_release(root);
+			_size--;
+
+			return result;
+		}
+	};
+
+	//Fixed-capacity selector of Capacity elements with the biggest priorities: min-heap of kept elements, its root is
+	//threshold, so candidate which isn't bigger than threshold is rejected by one comparison without touching heap.
+	//Priorities and values are stored separately, sift compares only priorities.
+	template <class Comparable, class V>
+	class TopK {
+	private:
+		std::vector<Comparable> _priorities;
+		std::vector<V> _values;
+		int _capacity = 0;
+
+		void _siftUp(int index) {
+			Comparable priority = std::move(_priorities[index]);
+			V value = std::move(_values[index]);
+			while (index > 0) {
+				int parent = (index - 1) / 2;
+				if ((priority < _priorities[parent]) == false)
+					break;
+				_priorities[index] = std::move(_priorities[parent]);
+				_values[index] = std::move(_values[parent]);
+				index = parent;
+			}
+			_priorities[index] = std::move(priority);
+			_values[index] = std::move(value);
+		}
+
+		//root is replaced by new element which is moved down to its place
+		void _replaceRoot(Comparable priority, V value) {
+			int size = static_cast<int>(_priorities.size());
+			int index = 0;
+			while (true) {
+				int child = index * 2 + 1;
+				if (child >= size)
+					break;
+				if (child + 1 < size && _priorities[child + 1] < _priorities[child])
+					child++;
+				if ((_priorities[child] < priority) == false)
+					break;
+				_priorities[index] = std::move(_priorities[child]);
+				_values[index] = std::move(_values[child]);
+				index = child;
+			}
+			_priorities[index] = std::move(priority);
+			_values[index] = std::move(value);
+		}
+	public:
+		TopK(int capacity = 1) : _capacity(std::max(1, capacity)) {
+			_priorities.reserve(_capacity);
+			_values.reserve(_capacity);
+		}
+
+		//returns REJECTED if selector is full and priority isn't bigger than threshold
+		ALGOGIN_ERROR offer(Comparable priority, V value) {
+			if (_priorities.size() < _capacity) {
+				_priorities.push_back(std::move(priority));
+				_values.push_back(std::move(value));
+				_siftUp(static_cast<int>(_priorities.size()) - 1);
+				return ALGOGIN_ERROR::OK;
+			}
+
+			if ((_priorities.front() < priority) == false)
+				return ALGOGIN_ERROR::REJECTED;
+
+			_replaceRoot(std::move(priority), std::move(value));
+			return ALGOGIN_ERROR::OK;
+		}
+
+		//offers pairs priorities[i], values[i], returns number of accepted elements. When selector is full candidates are
+		//filtered against threshold by chunks (SIMD for int32 and float), survivors are offered one by one
+		size_t offerBatch(std::span<const Comparable> priorities, std::span<const V> values) {
+			size_t count = std::min(priorities.size(), values.size());
+			size_t accepted = 0;
+			size_t i = 0;
+			for (; i < count && _priorities.size() < _capacity; i++)
+				accepted += offer(priorities[i], values[i]) == ALGOGIN_ERROR::OK;
+
+			constexpr size_t CHUNK = 256;
+			uint32_t indexes[CHUNK];
+			for (; i < count; i += CHUNK) {
+				size_t size = std::min(CHUNK, count - i);
+				size_t found = queue::findAbove(priorities.data() + i, size, _priorities.front(), indexes);
+				//threshold grows inside chunk, so survivors are checked again
+				for (size_t j = 0; j < found; j++)
+					accepted += offer(priorities[i + indexes[j]], values[i + indexes[j]]) == ALGOGIN_ERROR::OK;
+			}
+
+			return accepted;
+		}
+
+		//adds partial result of other selector (e.g. from worker thread)
+		ALGOGIN_ERROR merge(const TopK& other) {
+			//selector already contains its own elements
+			if (this == &other)
+				return ALGOGIN_ERROR::OK;
+
+			offerBatch(other._priorities, other._values);
+			return ALGOGIN_ERROR::OK;
+		}
+
+		ALGOGIN_ERROR merge(TopK&& other) {
+			if (this == &other)
+				return ALGOGIN_ERROR::OK;
+
+			for (int i = 0; i < other._priorities.size(); i++)
+				offer(std::move(other._priorities[i]), std::move(other._values[i]));
+			other.clear();
+			return ALGOGIN_ERROR::OK;
+		}
+
+		//the smallest kept priority, empty until selector is full (any candidate is accepted then)
+		std::optional<Comparable> getThreshold() const {
+			if (_priorities.size() < _capacity)
+				return std::nullopt;
+
+			return _priorities.front();
+		}
+
+		int getSize() const noexcept {
+			return static_cast<int>(_priorities.size());
+		}
+
+		int getCapacity() const noexcept {
+			return _capacity;
+		}
+
+		void clear() noexcept {
+			_priorities.clear();
+			_values.clear();
+		}
+
+		std::vector<std::tuple<Comparable, V>> traversal(TraversalMode mode) {
+			std::vector<std::tuple<Comparable, V>> result;
+			for (int i = 0; i < _priorities.size(); i++)
+				result.push_back({ _priorities[i], _values[i] });
+
+			return result;
+		}
+
+		//kept elements from the biggest priority to the smallest one
+		std::vector<std::tuple<Comparable, V>> getSorted() const {
+			std::vector<std::tuple<Comparable, V>> result;
+			for (int i = 0; i < _priorities.size(); i++)
+				result.push_back({ _priorities[i], _values[i] });
+			std::sort(result.begin(), result.end(), [](const auto& left, const auto& right) {
+				return std::get<0>(right) < std::get<0>(left);
+			});
+
+			return result;
+		}
+	};
+
+	//Concurrent relaxed priority queue (MultiQueue): c * threads independently locked heaps, insert goes to random heap,
+	//delete locks the better of two random heaps, so threads rarely contend. Returned element isn't always the minimum,
+	//but its expected rank is O(c * threads * buffer). Every thread works through own Worker which additionally buffers
+	//up to buffer inserted and deleted elements to take lock once per batch. Relaxation is configured by factor and buffer:
+	//factor = 1, buffer = 1 is the most precise, bigger values give higher throughput.
+	//Priorities are read without lock for two-choice comparison, so Comparable must be trivially copyable.
+	template <class Comparable, class V>
+	requires std::is_trivially_copyable_v<Comparable>
+	class MultiQueue {
+	private:
+		struct alignas(64) Queue {
+			std::mutex mutex;
+			PriorityQueue<Comparable, V, 4> heap;
+			//copy of heap minimum for comparison without lock
+			std::atomic<Comparable> top;
+			std::atomic<bool> empty = true;
+		};
+
+		std::vector<std::unique_ptr<Queue>> _queues;
+		int _bufferSize;
+		std::atomic<int64_t> _size = 0;
+
+		static uint64_t _random(uint64_t& state) noexcept {
+			state ^= state << 13;
+			state ^= state >> 7;
+			state ^= state << 17;
+			return state;
+		}
+
+		static void _updateTop(Queue& queue) noexcept {
+			auto top = queue.heap.top();
+			if (top)
+				queue.top.store(std::get<0>(top.value()), std::memory_order_relaxed);
+			queue.empty.store(top.has_value() == false, std::memory_order_relaxed);
+		}
+
+		//locks random heap, try_lock avoids waiting for busy heap
+		Queue& _lockRandom(uint64_t& state) noexcept {
+			while (true) {
+				Queue& queue = *_queues[_random(state) % _queues.size()];
+				if (queue.mutex.try_lock())
+					return queue;
+			}
+		}
+
+		template <class Range>
+		void _push(uint64_t& state, Range&& elements) {
+			Queue& queue = _lockRandom(state);
+			queue.heap.insertBulk(std::forward<Range>(elements));
+			_updateTop(queue);
+			queue.mutex.unlock();
+		}
+
+		//moves up to count minimal elements of the better of two random heaps to output (in ascending order),
+		//returns false if all heaps are empty
+		bool _pop(uint64_t& state, int count, std::vector<std::tuple<Comparable, V>>& output) {
+			int misses = 0;
+			while (true) {
+				Queue* first = _queues[_random(state) % _queues.size()].get();
+				Queue* second = _queues[_random(state) % _queues.size()].get();
+				bool firstEmpty = first->empty.load(std::memory_order_relaxed);
+				bool secondEmpty = second->empty.load(std::memory_order_relaxed);
+				if (firstEmpty && secondEmpty) {
+					//queue may be almost empty, check every heap before reporting emptiness
+					if (++misses < 4)
+						continue;
+					misses = 0;
+					first = nullptr;
+					for (auto& queue : _queues) {
+						if (queue->empty.load(std::memory_order_relaxed) == false) {
+							first = queue.get();
+							break;
+						}
+					}
+					if (first == nullptr)
+						return false;
+				}
+				else if (firstEmpty || (secondEmpty == false &&
+					second->top.load(std::memory_order_relaxed) < first->top.load(std::memory_order_relaxed))) {
+					first = second;
+				}
+
+				if (first->mutex.try_lock() == false)
+					continue;
+				//heap could be emptied by another thread after check
+				for (int i = 0; i < count; i++) {
+					auto minimum = first->heap.getMinimum();
+					if (minimum.has_value() == false)
+						break;
+					output.push_back(std::move(minimum.value()));
+				}
+				_updateTop(*first);
+				first->mutex.unlock();
+				if (output.empty() == false)
+					return true;
+			}
+		}
+	public:
+		//per-thread access point, keeps random state and insertion/deletion buffers, must not be shared between threads
+		class Worker {
+		private:
+			MultiQueue* _queue;
+			uint64_t _state;
+			std::vector<std::tuple<Comparable, V>> _insertion;
+			//deleted elements in descending order, the smallest one is the last
+			std::vector<std::tuple<Comparable, V>> _deletion;
+		public:
+			Worker(MultiQueue& queue, uint64_t seed) : _queue(&queue), _state(seed * 0x9e3779b97f4a7c15ull + 1) {
+			}
+
+			Worker(const Worker&) = delete;
+			Worker& operator=(const Worker&) = delete;
+
+			Worker(Worker&& worker) noexcept : _queue(worker._queue), _state(worker._state),
+				_insertion(std::move(worker._insertion)), _deletion(std::move(worker._deletion)) {
+				worker._queue = nullptr;
+			}
+
+			~Worker() {
+				flush();
+			}
+
+			ALGOGIN_ERROR insert(Comparable priority, V value) {
+				_insertion.push_back({ priority, std::move(value) });
+				_queue->_size.fetch_add(1, std::memory_order_relaxed);
+				if (_insertion.size() >= _queue->_bufferSize) {
+					_queue->_push(_state, std::move(_insertion));
+					_insertion.clear();
+				}
+
+				return ALGOGIN_ERROR::OK;
+			}
+
+			//approximate minimum, nullopt if queue is empty
+			std::optional<std::tuple<Comparable, V>> getMinimum() {
+				if (_deletion.empty()) {
+					if (_queue->_pop(_state, _queue->_bufferSize, _deletion))
+						std::reverse(_deletion.begin(), _deletion.end());
+				}
+
+				//own buffered inserts take part too, so element is never hidden from its own thread
+				auto best = std::min_element(_insertion.begin(), _insertion.end(), [](auto& left, auto& right) {
+					return std::get<0>(left) < std::get<0>(right);
+				});
+				std::optional<std::tuple<Comparable, V>> result;
+				if (best != _insertion.end() && (_deletion.empty() || std::get<0>(*best) < std::get<0>(_deletion.back()))) {
+					result = std::move(*best);
+					*best = std::move(_insertion.back());
+					_insertion.pop_back();
+				}
+				else if (_deletion.empty() == false) {
+					result = std::move(_deletion.back());
+					_deletion.pop_back();
+				}
+				else {
+					return std::nullopt;
+				}
+
+				_queue->_size.fetch_sub(1, std::memory_order_relaxed);
+				return result;
+			}
+
+			//returns buffered elements to shared heaps so other threads can see them
+			void flush() {
+				if (_queue == nullptr)
+					return;
+				if (_insertion.empty() == false)
+					_queue->_push(_state, std::move(_insertion));
+				if (_deletion.empty() == false)
+					_queue->_push(_state, std::move(_deletion));
+				_insertion.clear();
+				_deletion.clear();
+			}
+		};
+
+		//threads - expected number of threads (0 - hardware concurrency), factor - heaps per thread,
+		//buffer - number of elements which thread inserts or deletes by one lock
+		MultiQueue(int threads = 0, int factor = 2, int buffer = 8) : _bufferSize(std::max(1, buffer)) {
+			if (threads <= 0)
+				threads = std::max(1u, std::thread::hardware_concurrency());
+			int queues = std::max(2, threads * std::max(1, factor));
+			for (int i = 0; i < queues; i++)
+				_queues.push_back(std::make_unique<Queue>());
+		}
+
+		MultiQueue(const MultiQueue&) = delete;
+		MultiQueue& operator=(const MultiQueue&) = delete;
+		~MultiQueue() = default;
+
+		Worker getWorker(uint64_t seed) {
+			return Worker(*this, seed);
+		}
+
+		//number of elements including buffered by workers
+		int64_t getSize() const noexcept {
+			return _size.load(std::memory_order_relaxed);
+		}
+	};
+
+	struct ExternalQueueOptions {
+		//bytes of RAM: half for insertion heap, half for block buffers of runs
+		size_t memory = 64 << 20;
+		//bytes read or written by one I/O operation
+		size_t blockSize = 1 << 20;
+		//directory for run files (empty - system temporary directory)
+		std::filesystem::path directory;
+	};
+
+	//External-memory priority queue: new elements go to in-memory heap, when heap exceeds its half of memory budget
+	//it's sorted in place and written to file as sorted run. Minimum is the smaller one of heap top and winner of
+	//loser tree over run heads; runs are read block by block, so disk is accessed only sequentially.
+	//Runs have levels like in LSM trees: fanIn runs of one level are merged to one run of the next level, so every
+	//record is rewritten once per level. If block buffers of runs still don't fit to the other half of budget,
+	//all runs are merged to one.
+	template <class Comparable, class V>
+	class ExternalPriorityQueue {
+		static_assert(std::is_trivially_copyable_v<Comparable> && std::is_trivially_copyable_v<V>, "elements are written to files as raw bytes");
+	private:
+		struct Record {
+			Comparable priority;
+			V value;
+		};
+
+		struct Run {
+			std::filesystem::path path;
+			std::ifstream file;
+			std::vector<Record> block;
+			size_t position = 0;
+			//records which aren't read from file yet
+			uint64_t remaining = 0;
+			//number of records in file and index of the first record of block
+			uint64_t total = 0;
+			uint64_t blockStart = 0;
+			//number of merges which produced the run, runs of one level have similar sizes
+			int level = 0;
+		};
+
+		ExternalQueueOptions _options;
+		//min-heap by std heap algorithms: spill sorts it in place without second copy of elements
+		std::vector<Record> _heap;
+		std::vector<Run> _runs;
+		//_tree[0] - run with minimum head, other nodes - losers of matches, run i is leaf i + number of runs
+		std::vector<int> _tree;
+		size_t _heapCapacity = 0;
+		size_t _blockRecords = 0;
+		size_t _maxRuns = 0;
+		size_t _fanIn = 0;
+		uint64_t _size = 0;
+		uint64_t _prefix = 0;
+		uint64_t _files = 0;
+
+		static bool _greater(const Record& left, const Record& right) noexcept {
+			return right.priority < left.priority;
+		}
+
+		//exhausted run loses to any other one
+		bool _less(int first, int second) const noexcept {
+			auto& left = _runs[first];
+			auto& right = _runs[second];
+			if (left.position == left.block.size())
+				return false;
+			if (right.position == right.block.size())
+				return true;
+			return left.block[left.position].priority < right.block[right.position].priority;
+		}
+
+		int _build(int node) {
+			int runs = static_cast<int>(_runs.size());
+			if (node >= runs)
+				return node - runs;
+
+			int winner = _build(node * 2);
+			int loser = _build(node * 2 + 1);
+			if (_less(loser, winner))
+				std::swap(winner, loser);
+			_tree[node] = loser;
+			return winner;
+		}
+
+		void _rebuild() {
+			_tree.assign(std::max<size_t>(1, _runs.size()), 0);
+			if (_runs.empty() == false)
+				_tree[0] = _build(1);
+		}
+
+		//head of run changed: replay matches on the path from its leaf to root
+		void _replay(int run) noexcept {
+			int winner = run;
+			for (size_t node = (run + _runs.size()) / 2; node > 0; node /= 2) {
+				if (_less(_tree[node], winner))
+					std::swap(_tree[node], winner);
+			}
+			_tree[0] = winner;
+		}
+
+		ALGOGIN_ERROR _read(Run& run) {
+			size_t count = static_cast<size_t>(std::min<uint64_t>(run.remaining, _blockRecords));
+			run.blockStart = run.total - run.remaining;
+			run.block.resize(count);
+			run.file.read(reinterpret_cast<char*>(run.block.data()), count * sizeof(Record));
+			run.remaining -= count;
+			run.position = 0;
+			return run.file.good() ? ALGOGIN_ERROR::OK : ALGOGIN_ERROR::UNKNOWN_ERROR;
+		}
+
+		//moves head of winner run to the next record, returns false if run is exhausted
+		bool _next(ALGOGIN_ERROR& error) {
+			int winner = _tree[0];
+			auto& run = _runs[winner];
+			if (++run.position == run.block.size() && run.remaining > 0)
+				error = _read(run);
+			_replay(winner);
+			return run.position < run.block.size();
+		}
+
+		void _remove(Run& run) noexcept {
+			run.file.close();
+			std::error_code code;
+			std::filesystem::remove(run.path, code);
+		}
+
+		//writes count records produced by next() to new run file block by block and opens it for reading
+		template <class F>
+		ALGOGIN_ERROR _write(uint64_t count, F&& next, Run& run) {
+			run.path = _options.directory / ("algogin_queue_" + std::to_string(_prefix) + "_" + std::to_string(_files++) + ".run");
+			{
+				std::ofstream file{ run.path, std::ios::binary };
+				if (file.is_open() == false)
+					return ALGOGIN_ERROR::UNKNOWN_ERROR;
+
+				run.block.reserve(_blockRecords);
+				for (uint64_t i = 0; i < count; i++) {
+					run.block.push_back(next());
+					if (run.block.size() == _blockRecords || i + 1 == count) {
+						file.write(reinterpret_cast<const char*>(run.block.data()), run.block.size() * sizeof(Record));
+						run.block.clear();
+					}
+				}
+				if (file.good() == false) {
+					_remove(run);
+					return ALGOGIN_ERROR::UNKNOWN_ERROR;
+				}
+			}
+
+			run.file.open(run.path, std::ios::binary);
+			run.total = count;
+			run.remaining = count;
+			if (run.file.is_open() == false || _read(run) != ALGOGIN_ERROR::OK) {
+				_remove(run);
+				return ALGOGIN_ERROR::UNKNOWN_ERROR;
+			}
+
+			return ALGOGIN_ERROR::OK;
+		}
+
+		//returns run to the block starting at record blockStart, used to undo reads of failed merge
+		ALGOGIN_ERROR _seek(Run& run, uint64_t blockStart, size_t position) {
+			run.file.clear();
+			run.file.seekg(blockStart * sizeof(Record));
+			run.remaining = run.total - blockStart;
+			auto error = _read(run);
+			run.position = position;
+			return error;
+		}
+
+		//runs for which selected() is true are replaced by one run of given level with the same records.
+		//Inputs are replaced only after merged file is complete: if merge fails, they are returned to saved positions
+		template <class F>
+		ALGOGIN_ERROR _merge(F&& selected, int level) {
+			//loser tree is rebuilt over merged runs only, the other ones wait aside
+			std::vector<Run> inputs, rest;
+			for (auto& run : _runs)
+				(selected(run) ? inputs : rest).push_back(std::move(run));
+			_runs = std::move(inputs);
+			_rebuild();
+
+			std::vector<std::tuple<uint64_t, size_t>> cursors;
+			for (auto& run : _runs)
+				cursors.push_back({ run.blockStart, run.position });
+
+			uint64_t count = 0;
+			for (auto& run : _runs)
+				count += run.block.size() - run.position + run.remaining;
+
+			Run merged;
+			merged.level = level;
+			ALGOGIN_ERROR error = ALGOGIN_ERROR::OK;
+			ALGOGIN_ERROR written = _write(count, [&] {
+				auto& run = _runs[_tree[0]];
+				Record record = run.block[run.position];
+				_next(error);
+				return record;
+			}, merged);
+			if (written != ALGOGIN_ERROR::OK || error != ALGOGIN_ERROR::OK) {
+				if (written == ALGOGIN_ERROR::OK)
+					_remove(merged);
+				for (size_t i = 0; i < _runs.size(); i++)
+					_seek(_runs[i], std::get<0>(cursors[i]), std::get<1>(cursors[i]));
+				std::move(_runs.begin(), _runs.end(), std::back_inserter(rest));
+				_runs = std::move(rest);
+				_rebuild();
+				return ALGOGIN_ERROR::UNKNOWN_ERROR;
+			}
+
+			for (auto& run : _runs)
+				_remove(run);
+			_runs = std::move(rest);
+			_runs.push_back(std::move(merged));
+			_rebuild();
+			return ALGOGIN_ERROR::OK;
+		}
+
+		ALGOGIN_ERROR _spill() {
+			//sorting of heap array is much cheaper than popping elements one by one, sort_heap by greater
+			//gives descending order, so records are written from the end
+			std::sort_heap(_heap.begin(), _heap.end(), _greater);
+			size_t position = _heap.size();
+			Run run;
+			ALGOGIN_ERROR error = _write(_heap.size(), [&] {
+				return _heap[--position];
+			}, run);
+			if (error != ALGOGIN_ERROR::OK) {
+				std::make_heap(_heap.begin(), _heap.end(), _greater);
+				return error;
+			}
+
+			_heap.clear();
+			_runs.push_back(std::move(run));
+			_rebuild();
+
+			//merges cascade while the next level collects fanIn runs
+			for (int level = 0;; level++) {
+				auto onLevel = [level](const Run& run) { return run.level == level; };
+				if (std::count_if(_runs.begin(), _runs.end(), onLevel) < static_cast<ptrdiff_t>(_fanIn))
+					break;
+				if (_merge(onLevel, level + 1) != ALGOGIN_ERROR::OK)
+					return ALGOGIN_ERROR::UNKNOWN_ERROR;
+			}
+
+			if (_runs.size() > _maxRuns) {
+				int level = 0;
+				for (auto& run : _runs)
+					level = std::max(level, run.level + 1);
+				return _merge([](const Run&) { return true; }, level);
+			}
+			return ALGOGIN_ERROR::OK;
+		}
+
+		bool _isRunMinimum() const noexcept {
+			if (_runs.empty())
+				return false;
+			if (_heap.empty())
+				return true;
+
+			auto& run = _runs[_tree[0]];
+			return run.block[run.position].priority < _heap.front().priority;
+		}
+
+		//removes minimum head from runs, exhausted run is deleted
+		ALGOGIN_ERROR _popRun() {
+			ALGOGIN_ERROR error = ALGOGIN_ERROR::OK;
+			int winner = _tree[0];
+			if (_next(error) == false) {
+				_remove(_runs[winner]);
+				_runs.erase(_runs.begin() + winner);
+				_rebuild();
+			}
+
+			_size--;
+			return error;
+		}
+
+		void _clear() noexcept {
+			for (auto& run : _runs)
+				_remove(run);
+			_runs.clear();
+			_tree.clear();
+			_heap.clear();
+			_size = 0;
+		}
+	public:
+		ExternalPriorityQueue(ExternalQueueOptions options = {}) : _options(std::move(options)) {
+			if (_options.directory.empty())
+				_options.directory = std::filesystem::temp_directory_path();
+			_heapCapacity = std::max<size_t>(1, _options.memory / 2 / sizeof(Record));
+			_blockRecords = std::max<size_t>(1, _options.blockSize / sizeof(Record));
+			_maxRuns = std::max<size_t>(2, _options.memory / 2 / (_blockRecords * sizeof(Record)));
+			//about 4 levels fit to memory before all runs have to be merged
+			_fanIn = std::max<size_t>(2, _maxRuns / 4);
+			//run files of different queues must not collide
+			std::random_device device;
+			_prefix = (static_cast<uint64_t>(device()) << 32) | device();
+		}
+
+		~ExternalPriorityQueue() {
+			_clear();
+		}
+
+		ExternalPriorityQueue(const ExternalPriorityQueue&) = delete;
+		ExternalPriorityQueue& operator=(const ExternalPriorityQueue&) = delete;
+
+		ExternalPriorityQueue(ExternalPriorityQueue&& queue) noexcept {
+			*this = std::move(queue);
+		}
+
+		ExternalPriorityQueue& operator=(ExternalPriorityQueue&& queue) noexcept {
+			if (this == &queue)
+				return *this;
+
+			_clear();
+			_options = std::move(queue._options);
+			_heap = std::move(queue._heap);
+			_runs = std::move(queue._runs);
+			_tree = std::move(queue._tree);
+			_heapCapacity = queue._heapCapacity;
+			_blockRecords = queue._blockRecords;
+			_maxRuns = queue._maxRuns;
+			_fanIn = queue._fanIn;
+			_size = std::exchange(queue._size, 0);
+			_prefix = queue._prefix;
+			_files = queue._files;
+			queue._heap.clear();
+			queue._runs.clear();
+			queue._tree.clear();
+
+			return *this;
+		}
+
+		//returns UNKNOWN_ERROR if heap can't be written to disk or runs can't be merged; no element is lost then:
+		//heap which isn't written stays in memory, runs which aren't merged stay on disk and are merged by later spills
+		ALGOGIN_ERROR insert(Comparable priority, V value) {
+			//heap takes its half of budget at once, growth by reallocation would need twice more for a moment
+			if (_heap.capacity() < _heapCapacity)
+				_heap.reserve(_heapCapacity);
+			_heap.push_back({ std::move(priority), std::move(value) });
+			std::push_heap(_heap.begin(), _heap.end(), _greater);
+			_size++;
+			if (_heap.size() >= _heapCapacity)
+				return _spill();
+
+			return ALGOGIN_ERROR::OK;
+		}
+
+		std::optional<std::tuple<Comparable, V>> top() const {
+			if (_isRunMinimum()) {
+				auto& record = _runs[_tree[0]].block[_runs[_tree[0]].position];
+				return std::tuple<Comparable, V>{ record.priority, record.value };
+			}
+			if (_heap.empty())
+				return std::nullopt;
+
+			return std::tuple<Comparable, V>{ _heap.front().priority, _heap.front().value };
+		}
+
+		//returns NOT_FOUND if queue is empty, UNKNOWN_ERROR if the next block of run can't be read
+		ALGOGIN_ERROR popInto(Comparable& priority, V& value) {
+			if (_isRunMinimum()) {
+				auto& record = _runs[_tree[0]].block[_runs[_tree[0]].position];
+				priority = record.priority;
+				value = record.value;
+				return _popRun();
+			}
+			if (_heap.empty())
+				return ALGOGIN_ERROR::NOT_FOUND;
+
+			std::pop_heap(_heap.begin(), _heap.end(), _greater);
+			priority = _heap.back().priority;
+			value = _heap.back().value;
+			_heap.pop_back();
+			_size--;
+			return ALGOGIN_ERROR::OK;
+		}
+
+		ALGOGIN_ERROR popInto(V& value) {
+			Comparable priority;
+			return popInto(priority, value);
+		}
+
+		std::optional<std::tuple<Comparable, V>> getMinimum() {
+			std::tuple<Comparable, V> result;
+			if (popInto(std::get<0>(result), std::get<1>(result)) == ALGOGIN_ERROR::NOT_FOUND)
+				return std::nullopt;
+
+			return result;
+		}
+
+		uint64_t getSize() const noexcept {
+			return _size;
+		}
+
+		//number of sorted runs on disk
+		int getRuns() const noexcept {
+			return static_cast<int>(_runs.size());
+		}
 	};
-}
\ No newline at end of file
+}
@@ -1,159 +1,1379 @@
 #pragma once
+#include "ThreadPool.h"
+#include "SortingNetwork.h"
 #include <vector>
+#include <algorithm>
+#include <bit>
+#include <functional>
+#include <iterator>
+#include <span>
+#include <utility>
+#include <concepts>
+#include <cstdint>
+#include <type_traits>
+
+//keys which can be sorted by digits: integers and IEEE floats, they are mapped to unsigned integers with the same order
+template <class T>
+concept RadixSortable = (std::integral<T> && std::same_as<T, bool> == false && sizeof(T) <= 8) ||
+						(std::floating_point<T> && (sizeof(T) == 4 || sizeof(T) == 8));
 
 class Sorting {
 private:
-	template <class T>
-	int _partition(std::vector<T>& input, int start, int end) {
-		int i = start - 1;
-		//choose anchor element
-		T anchor = input[end - 1];
-		for (int j = start; j < end - 1; j++) {
-			//swap element i with j if element j less than anchor
-			if (input[j] < anchor) {
-				i++;
-				std::swap(input[j], input[i]);
+	//ranges not longer than this are finished by insertion sort
+	static constexpr int INSERTION_THRESHOLD = 24;
+	//ranges longer than this use median of three medians (ninther) as pivot
+	static constexpr int NINTHER_THRESHOLD = 128;
+	//ranges of int32, int64 and float in default order not longer than this are finished by SIMD sorting network
+	static constexpr int NETWORK_THRESHOLD = algogin::network::MAX_SIZE;
+
+	//default order of elements without projection, recursive sorts recognize it by type
+	struct NaturalLess {
+		template <class T>
+		bool operator()(const T& left, const T& right) const {
+			return left < right;
+		}
+	};
+
+	//network isn't stable, it can reorder only indistinguishable equal elements: integers, but not -0.0 and 0.0
+	template <class Iterator, class Compare, bool Stable = false>
+	static constexpr bool _isNetworkSortable() {
+		using T = std::iter_value_t<Iterator>;
+		return std::is_same_v<Compare, NaturalLess> && std::contiguous_iterator<Iterator> && algogin::network::NetworkSortable<T> &&
+			   (Stable == false || std::integral<T>);
+	}
+
+	template <class Iterator, class Compare, bool Stable = false>
+	static constexpr std::ptrdiff_t _getBaseSize() {
+		return _isNetworkSortable<Iterator, Compare, Stable>() ? NETWORK_THRESHOLD : INSERTION_THRESHOLD;
+	}
+
+	//base case of recursive sorts
+	template <bool Stable = false, class Iterator, class Compare>
+	void _sortBase(Iterator first, Iterator last, Compare& less) {
+		if constexpr (_isNetworkSortable<Iterator, Compare, Stable>())
+			algogin::network::sort(std::to_address(first), static_cast<int>(last - first));
+		else
+			_insertionSort(first, last, less);
+	}
+
+	//shifts elements right instead of swapping, every element is moved once per position
+	template <class Iterator, class Compare>
+	void _insertionSort(Iterator first, Iterator last, Compare& less) {
+		if (first == last)
+			return;
+
+		for (Iterator i = first + 1; i != last; ++i) {
+			if (less(*i, *(i - 1)) == false)
+				continue;
+
+			auto element = std::move(*i);
+			Iterator j = i;
+			do {
+				*j = std::move(*(j - 1));
+				--j;
+			} while (j != first && less(element, *(j - 1)));
+			*j = std::move(element);
+		}
+	}
+
+	template <class Iterator, class Compare>
+	void _siftDown(Iterator first, std::ptrdiff_t index, std::ptrdiff_t size, Compare& less) {
+		auto element = std::move(first[index]);
+		while (true) {
+			std::ptrdiff_t child = index * 2 + 1;
+			if (child >= size)
+				break;
+			if (child + 1 < size && less(first[child], first[child + 1]))
+				child++;
+			if (less(element, first[child]) == false)
+				break;
+			first[index] = std::move(first[child]);
+			index = child;
+		}
+		first[index] = std::move(element);
+	}
+
+	//fallback of quick sort: O(n log n) for any input
+	template <class Iterator, class Compare>
+	void _heapSort(Iterator first, Iterator last, Compare& less) {
+		std::ptrdiff_t size = last - first;
+		for (std::ptrdiff_t i = size / 2 - 1; i >= 0; i--)
+			_siftDown(first, i, size, less);
+		for (std::ptrdiff_t i = size - 1; i > 0; i--) {
+			std::iter_swap(first, first + i);
+			_siftDown(first, 0, i, less);
+		}
+	}
+
+	//puts median of three elements to the second position
+	template <class Iterator, class Compare>
+	void _sortThree(Iterator a, Iterator b, Iterator c, Compare& less) {
+		if (less(*b, *a))
+			std::iter_swap(a, b);
+		if (less(*c, *b)) {
+			std::iter_swap(b, c);
+			if (less(*b, *a))
+				std::iter_swap(a, b);
+		}
+	}
+
+	//moves pivot to the first position: median of first, middle and last elements or ninther for long ranges,
+	//so sorted, reverse sorted and organ-pipe inputs are split evenly
+	template <class Iterator, class Compare>
+	void _choosePivot(Iterator first, Iterator last, Compare& less) {
+		std::ptrdiff_t size = last - first;
+		Iterator middle = first + size / 2;
+		if (size > NINTHER_THRESHOLD) {
+			std::ptrdiff_t step = size / 8;
+			_sortThree(first, first + step, first + step * 2, less);
+			_sortThree(middle - step, middle, middle + step, less);
+			_sortThree(last - 1 - step * 2, last - 1 - step, last - 1, less);
+			_sortThree(first + step, middle, last - 1 - step, less);
+		}
+		else {
+			_sortThree(first, middle, last - 1, less);
+		}
+		std::iter_swap(first, middle);
+	}
+
+	//three-way partition around the first element: [first, equal) less than pivot, [equal, greater) equal to pivot,
+	//[greater, last) greater than pivot, so duplicates of pivot are excluded from recursion.
+	//Pivot is kept aside, its slot is a gap between less and equal elements
+	template <class Iterator, class Compare>
+	std::pair<Iterator, Iterator> _partition(Iterator first, Iterator last, Compare& less) {
+		auto pivot = std::move(*first);
+		Iterator equal = first;
+		Iterator current = first + 1;
+		Iterator greater = last;
+		while (current != greater) {
+			if (less(*current, pivot)) {
+				//element goes to the gap, the first equal element (if any) goes to its place, gap moves right
+				*equal = std::move(*current);
+				++equal;
+				if (equal != current)
+					*current = std::move(*equal);
+				++current;
+			}
+			else if (less(pivot, *current)) {
+				--greater;
+				std::iter_swap(current, greater);
+			}
+			else {
+				++current;
 			}
-			//if element bigger do nothing
 		}
-		//place anchor to correct place (end of section with elements less than anchor)
-		i++;
-		std::swap(input[end - 1], input[i]);
-		return i;
+		//the gap is filled by pivot
+		*equal = std::move(pivot);
+		return { equal, greater };
 	}
 
-	template <class T>
-	void _quickSort(std::vector<T>& input, int start, int end) {
-		//end exclusive
-		if (end - start > 1) {
-			int anchorIndex = _partition(input, start, end);
+	//introsort: quick sort while recursion depth is below 2 log n, heap sort after it.
+	//Recursion goes to the smaller part and the loop continues with the bigger one, so stack depth is O(log n)
+	template <class Iterator, class Compare>
+	void _quickSort(Iterator first, Iterator last, int depth, Compare& less) {
+		while (last - first > _getBaseSize<Iterator, Compare>()) {
+			if (depth == 0) {
+				_heapSort(first, last, less);
+				return;
+			}
+			depth--;
 
-			//elements less than anchor
-			_quickSort(input, start, anchorIndex);
-			//elements greater than anchor
-			_quickSort(input, anchorIndex + 1, end);
+			_choosePivot(first, last, less);
+			auto [equal, greater] = _partition(first, last, less);
+			if (equal - first < last - greater) {
+				_quickSort(first, equal, depth, less);
+				first = greater;
+			}
+			else {
+				_quickSort(greater, last, depth, less);
+				last = equal;
+			}
 		}
+		_sortBase(first, last, less);
 	}
 
-	template <class T>
-	void _merge(std::vector<T>& input, int start, int midpoint, int end) {
-		std::vector<T> left(input.begin() + start, input.begin() + midpoint + 1);
-		int endID = end + 1;
-		if (endID > input.size())
-			endID = input.size();
-
-		std::vector<T> right(input.begin() + midpoint + 1, input.begin() + endID);
-		int indexLeft = 0, indexRight = 0;
-		int index = start;
+	//merge of parts longer than this is split between threads
+	static constexpr std::ptrdiff_t PARALLEL_THRESHOLD = 1 << 16;
+
+	//merges sorted [left, leftEnd) and [right, rightEnd) to output, equal elements of the left part go first
+	template <class Left, class Right, class Output, class Compare>
+	void _mergeInto(Left left, Left leftEnd, Right right, Right rightEnd, Output output, Compare& less) {
 		//sorting: choose first element from left and right (they are sorted) and compare. Move least one to resulting array.
 		//do until both arrays have elements
-		while (indexLeft < left.size() && indexRight < right.size()) {
-			if (left[indexLeft] < right[indexRight]) {
-				input[index] = left[indexLeft];
-				indexLeft++;
+		while (left != leftEnd && right != rightEnd) {
+			if (less(*right, *left)) {
+				*output = std::move(*right);
+				++right;
 			}
 			else {
-				input[index] = right[indexRight];
-				indexRight++;
+				*output = std::move(*left);
+				++left;
 			}
 
-			index++;
+			++output;
 		}
 
 		//move elements from array with size > 0 (there is only one array left with size > 0)
-		while (indexRight < right.size()) {
-			input[index] = right[indexRight];
-			indexRight++;
-			index++;
+		output = std::move(left, leftEnd, output);
+		std::move(right, rightEnd, output);
+	}
+
+	//number of elements of left part among the first rank elements of merged output (co-rank), found by binary search
+	template <class Left, class Right, class Compare>
+	std::ptrdiff_t _coRank(std::ptrdiff_t rank, Left left, std::ptrdiff_t leftSize, Right right, std::ptrdiff_t rightSize, Compare& less) {
+		std::ptrdiff_t low = std::max<std::ptrdiff_t>(0, rank - rightSize);
+		std::ptrdiff_t high = std::min(rank, leftSize);
+		while (true) {
+			std::ptrdiff_t i = low + (high - low) / 2;
+			std::ptrdiff_t j = rank - i;
+			//left[i - 1] has to go after right[j]: too many elements from left
+			if (i > 0 && j < rightSize && less(right[j], left[i - 1]))
+				high = i - 1;
+			//right[j - 1] isn't less than left[i], so left[i] goes first: too few elements from left
+			else if (j > 0 && i < leftSize && less(right[j - 1], left[i]) == false)
+				low = i + 1;
+			else
+				return i;
 		}
+	}
 
-		while (indexLeft < left.size()) {
-			input[index] = left[indexLeft];
-			indexLeft++;
-			index++;
+	//output is split to equal pieces, co-rank gives parts of both inputs for every piece, pieces are merged in parallel
+	template <class Left, class Right, class Output, class Compare>
+	void _parallelMerge(Left left, std::ptrdiff_t leftSize, Right right, std::ptrdiff_t rightSize, Output output, algogin::ThreadPool* pool, Compare& less) {
+		std::ptrdiff_t size = leftSize + rightSize;
+		if (pool == nullptr || size < PARALLEL_THRESHOLD) {
+			_mergeInto(left, left + leftSize, right, right + rightSize, output, less);
+			return;
+		}
+
+		std::ptrdiff_t pieces = std::min<std::ptrdiff_t>(pool->getThreads() + 1, size / (PARALLEL_THRESHOLD / 2));
+		algogin::ThreadPool::Group group;
+		for (std::ptrdiff_t piece = 0; piece < pieces; piece++) {
+			auto mergePiece = [=, this, &less] {
+				std::ptrdiff_t begin = size * piece / pieces, end = size * (piece + 1) / pieces;
+				std::ptrdiff_t leftBegin = _coRank(begin, left, leftSize, right, rightSize, less);
+				std::ptrdiff_t leftEnd = _coRank(end, left, leftSize, right, rightSize, less);
+				_mergeInto(left + leftBegin, left + leftEnd, right + (begin - leftBegin), right + (end - leftEnd), output + begin, less);
+			};
+			if (piece + 1 < pieces)
+				pool->run(group, mergePiece);
+			else
+				mergePiece();
+		}
+		pool->wait(group);
+	}
+
+	//stable merge sort with one buffer: elements are in source, result is written to target if toTarget or to source.
+	//Halves are sorted to the other array, so merge of every level reads one array and writes another without copies.
+	//Halves are sorted in parallel if pool is set
+	template <class Source, class Target, class Compare>
+	void _mergeSort(Source source, Target target, std::ptrdiff_t size, bool toTarget, algogin::ThreadPool* pool, Compare& less) {
+		if (size <= _getBaseSize<Source, Compare, true>()) {
+			_sortBase<true>(source, source + size, less);
+			if (toTarget)
+				std::move(source, source + size, target);
+			return;
+		}
+
+		std::ptrdiff_t half = size / 2;
+		if (pool && size >= PARALLEL_THRESHOLD) {
+			pool->invoke([&] { _mergeSort(source, target, half, !toTarget, pool, less); },
+						 [&] { _mergeSort(source + half, target + half, size - half, !toTarget, pool, less); });
+		}
+		else {
+			_mergeSort(source, target, half, !toTarget, pool, less);
+			_mergeSort(source + half, target + half, size - half, !toTarget, pool, less);
 		}
+
+		if (toTarget)
+			_parallelMerge(source, half, source + half, size - half, target, pool, less);
+		else
+			_parallelMerge(target, half, target + half, size - half, source, pool, less);
+	}
+
+	//elements are moved to buffer and sorted back to [first, last)
+	template <class Iterator, class Compare>
+	void _mergeSort(Iterator first, Iterator last, algogin::ThreadPool* pool, Compare& less) {
+		std::vector<std::iter_value_t<Iterator>> buffer(std::make_move_iterator(first), std::make_move_iterator(last));
+		_mergeSort(buffer.begin(), first, last - first, true, pool, less);
 	}
 
+	//ranges not longer than this are sorted by introsort instead of sample sort
+	static constexpr std::ptrdiff_t SAMPLE_SORT_BASE = 4096;
+	static constexpr int MAX_BUCKETS = 256;
+
+	//Splitters in implicit binary search tree (node i has children 2i and 2i + 1), bucket of element is found by
+	//log(buckets) steps without branches: i = 2i + (splitter < element). If the sample has duplicate splitters,
+	//every bucket gets a pair bucket for elements equal to its upper splitter, such buckets are already sorted
 	template <class T>
-	void _mergeSort(std::vector<T>& input, int start, int end) {
-		if (start < end) {
-			int midpoint = (start + end) / 2;
-			_mergeSort(input, start, midpoint);
-			_mergeSort(input, midpoint+1, end);
-			_merge(input, start, midpoint, end);
+	struct SampleClassifier {
+		std::vector<T> tree;
+		std::vector<T> splitters;
+		int log = 0;
+		int buckets = 0;
+		bool equalBuckets = false;
+
+		template <class Compare>
+		SampleClassifier(std::vector<T> sorted, Compare& less) {
+			auto last = std::unique(sorted.begin(), sorted.end(), [&less](const T& left, const T& right) { return less(left, right) == false; });
+			equalBuckets = last != sorted.end();
+			sorted.erase(last, sorted.end());
+			buckets = static_cast<int>(std::bit_ceil(sorted.size() + 1));
+			log = std::countr_zero(static_cast<unsigned>(buckets));
+			//missing splitters repeat the last one, buckets after it stay empty
+			while (sorted.size() < buckets - 1)
+				sorted.push_back(sorted.back());
+
+			//node i on depth d is the (2 * (i - 2^d) + 1)-th of 2^(d + 1) parts of sorted splitters
+			tree.push_back(sorted.front());
+			for (int i = 1; i < buckets; i++) {
+				int depth = std::bit_width(static_cast<unsigned>(i)) - 1;
+				tree.push_back(sorted[((2 * (i - (1 << depth)) + 1) << (log - depth - 1)) - 1]);
+			}
+			splitters = std::move(sorted);
+		}
+
+		int getBuckets() const noexcept {
+			return equalBuckets ? buckets * 2 : buckets;
+		}
+
+		bool isEqualBucket(int bucket) const noexcept {
+			return equalBuckets && bucket % 2 == 1;
+		}
+
+		//elements of bucket b are bigger than splitter b - 1 and not bigger than splitter b
+		template <class Compare>
+		int classify(const T& element, Compare& less) const {
+			size_t index = 1;
+			for (int level = 0; level < log; level++)
+				index = 2 * index + less(tree[index], element);
+			int bucket = static_cast<int>(index) - buckets;
+			if (equalBuckets == false)
+				return bucket;
+			return 2 * bucket + (bucket < buckets - 1 && less(element, splitters[bucket]) == false);
+		}
+
+		//several elements are classified together, so independent tree descents overlap
+		template <class Iterator, class Compare>
+		void classify(Iterator first, std::ptrdiff_t size, int* result, Compare& less) const {
+			constexpr int UNROLL = 4;
+			std::ptrdiff_t i = 0;
+			if (equalBuckets == false) {
+				for (; i + UNROLL <= size; i += UNROLL) {
+					size_t index[UNROLL];
+					for (int u = 0; u < UNROLL; u++)
+						index[u] = 1;
+					for (int level = 0; level < log; level++) {
+						for (int u = 0; u < UNROLL; u++)
+							index[u] = 2 * index[u] + less(tree[index[u]], first[i + u]);
+					}
+					for (int u = 0; u < UNROLL; u++)
+						result[i + u] = static_cast<int>(index[u]) - buckets;
+				}
+			}
+			for (; i < size; i++)
+				result[i] = classify(first[i], less);
+		}
+	};
+
+	//Parallel in-place super scalar sample sort (IPS4o): elements are distributed to buckets by splitters from sample.
+	//1. Every thread classifies own stripe to per-bucket buffers of one block, full block is written back to the
+	//   beginning of stripe, so stripe becomes sequence of full blocks. Holes between stripes are filled by blocks
+	//   from the end of range.
+	//2. Blocks are permuted to their bucket regions by swaps through one block buffer.
+	//3. Bucket borders aren't aligned to blocks: elements written over border and partial buffers are moved to
+	//   the free places of their buckets.
+	//Auxiliary memory is O(buckets * block) per thread. Buckets are sorted recursively, big ones as tasks of pool
+	template <class Iterator, class Compare>
+	void _sampleSort(Iterator first, Iterator last, algogin::ThreadPool* pool, Compare& less) {
+		using T = std::iter_value_t<Iterator>;
+		std::ptrdiff_t size = last - first;
+		if (size <= SAMPLE_SORT_BASE) {
+			_quickSort(first, last, 2 * std::bit_width(static_cast<size_t>(size)), less);
+			return;
+		}
+
+		//random sample is moved to the beginning of range and sorted, splitters are taken from it evenly
+		int targetBuckets = static_cast<int>(std::min<size_t>(MAX_BUCKETS, std::bit_ceil(static_cast<size_t>(size / (SAMPLE_SORT_BASE / 4)))));
+		std::ptrdiff_t oversampling = std::max(1, static_cast<int>(std::bit_width(static_cast<size_t>(size))) / 5);
+		std::ptrdiff_t sampleSize = std::min(size, targetBuckets * oversampling);
+		uint64_t random = static_cast<uint64_t>(size);
+		for (std::ptrdiff_t i = 0; i < sampleSize; i++) {
+			random = random * 6364136223846793005ull + 1442695040888963407ull;
+			std::iter_swap(first + i, first + i + static_cast<std::ptrdiff_t>((random >> 33) % (size - i)));
+		}
+		_quickSort(first, first + sampleSize, 2 * std::bit_width(static_cast<size_t>(sampleSize)), less);
+		std::vector<T> sample;
+		for (int i = 1; i < targetBuckets; i++)
+			sample.push_back(first[sampleSize * i / targetBuckets]);
+		SampleClassifier<T> classifier(std::move(sample), less);
+		int buckets = classifier.getBuckets();
+
+		const std::ptrdiff_t block = std::max<std::ptrdiff_t>(1, 2048 / sizeof(T));
+		int stripesNumber = 1;
+		if (pool)
+			stripesNumber = static_cast<int>(std::clamp<std::ptrdiff_t>(size / PARALLEL_THRESHOLD, 1, pool->getThreads() + 1));
+
+		struct Stripe {
+			std::ptrdiff_t begin;
+			std::ptrdiff_t end;
+			std::ptrdiff_t write;
+			std::vector<std::vector<T>> buffers;
+			std::vector<std::ptrdiff_t> counts;
+		};
+		std::vector<Stripe> stripes(stripesNumber);
+		for (int t = 0; t < stripesNumber; t++) {
+			stripes[t].begin = t == 0 ? 0 : size * t / stripesNumber / block * block;
+			stripes[t].end = t + 1 == stripesNumber ? size : size * (t + 1) / stripesNumber / block * block;
+		}
+
+		//1. local classification
+		auto classifyStripe = [&](Stripe& stripe) {
+			stripe.buffers.resize(buckets);
+			for (auto& buffer : stripe.buffers)
+				buffer.reserve(block);
+			stripe.counts.assign(buckets, 0);
+			stripe.write = stripe.begin;
+			constexpr std::ptrdiff_t BATCH = 256;
+			int result[BATCH];
+			for (std::ptrdiff_t read = stripe.begin; read < stripe.end; read += BATCH) {
+				std::ptrdiff_t batch = std::min(BATCH, stripe.end - read);
+				classifier.classify(first + read, batch, result, less);
+				for (std::ptrdiff_t i = 0; i < batch; i++) {
+					auto& buffer = stripe.buffers[result[i]];
+					stripe.counts[result[i]]++;
+					buffer.push_back(std::move(first[read + i]));
+					//write position never passes read position: every written element is already read
+					if (buffer.size() == block) {
+						std::move(buffer.begin(), buffer.end(), first + stripe.write);
+						stripe.write += block;
+						buffer.clear();
+					}
+				}
+			}
+		};
+		if (stripesNumber > 1) {
+			algogin::ThreadPool::Group group;
+			for (int t = 1; t < stripesNumber; t++)
+				pool->run(group, [&, t] { classifyStripe(stripes[t]); });
+			classifyStripe(stripes[0]);
+			pool->wait(group);
+		}
+		else {
+			classifyStripe(stripes[0]);
+		}
+
+		//full blocks from the end fill empty blocks of stripes, so all full blocks are in [0, fullEnd)
+		std::ptrdiff_t fullEnd = 0;
+		for (auto& stripe : stripes)
+			fullEnd += stripe.write - stripe.begin;
+		int source = stripesNumber - 1;
+		std::ptrdiff_t sourceBlock = stripes[source].write;
+		for (auto& stripe : stripes) {
+			for (std::ptrdiff_t hole = stripe.write; hole < stripe.end && hole < fullEnd; hole += block) {
+				while (sourceBlock <= stripes[source].begin || sourceBlock - block < fullEnd) {
+					source--;
+					sourceBlock = stripes[source].write;
+				}
+				sourceBlock -= block;
+				std::move(first + sourceBlock, first + sourceBlock + block, first + hole);
+			}
+		}
+
+		//2. block permutation: bucket b owns blocks which start in [aligned start of b, aligned start of b + 1),
+		//[begin, write) - placed blocks, [write, read] - unprocessed full blocks, after read - empty blocks
+		std::vector<std::ptrdiff_t> starts(buckets + 1, 0), writes(buckets), reads(buckets);
+		for (int b = 0; b < buckets; b++) {
+			starts[b + 1] = starts[b];
+			for (auto& stripe : stripes)
+				starts[b + 1] += stripe.counts[b];
+		}
+		auto alignUp = [block](std::ptrdiff_t position) { return (position + block - 1) / block * block; };
+		for (int b = 0; b < buckets; b++) {
+			writes[b] = alignUp(starts[b]);
+			reads[b] = std::clamp(fullEnd, writes[b], alignUp(starts[b + 1])) - block;
+		}
+
+		std::vector<T> swap, overflow;
+		swap.reserve(block);
+		std::ptrdiff_t overflowPosition = -1;
+		for (int b = 0; b < buckets; b++) {
+			while (reads[b] >= writes[b]) {
+				swap.assign(std::make_move_iterator(first + reads[b]), std::make_move_iterator(first + reads[b] + block));
+				reads[b] -= block;
+				while (true) {
+					int destination = classifier.classify(swap.front(), less);
+					//blocks which are already in their bucket are skipped
+					while (writes[destination] <= reads[destination] && classifier.classify(first[writes[destination]], less) == destination)
+						writes[destination] += block;
+
+					std::ptrdiff_t write = writes[destination];
+					writes[destination] += block;
+					if (write <= reads[destination]) {
+						std::swap_ranges(swap.begin(), swap.end(), first + write);
+						continue;
+					}
+					//the last block can go over the end of range
+					if (write + block > size) {
+						overflow = std::move(swap);
+						overflowPosition = write;
+						swap = std::vector<T>();
+						swap.reserve(block);
+					}
+					else {
+						std::move(swap.begin(), swap.end(), first + write);
+					}
+					break;
+				}
+			}
+		}
+
+		//3. cleanup: places before aligned start and after the last block of bucket are filled by elements
+		//written over the end of bucket, overflow block and partial buffers
+		std::ptrdiff_t overflowMoved = 0;
+		if (overflowPosition >= 0) {
+			overflowMoved = size - overflowPosition;
+			std::move(overflow.begin(), overflow.begin() + overflowMoved, first + overflowPosition);
+		}
+		for (int b = 0; b < buckets; b++) {
+			std::ptrdiff_t begin = starts[b], end = starts[b + 1];
+			std::ptrdiff_t aligned = alignUp(begin), written = writes[b];
+			std::ptrdiff_t destination = begin;
+			auto put = [&](T& element) {
+				if (destination == std::min(aligned, end))
+					destination = std::max(destination, std::min(written, size));
+				first[destination++] = std::move(element);
+			};
+
+			for (std::ptrdiff_t i = std::max(aligned, end); i < std::min(written, size); i++)
+				put(first[i]);
+			if (overflowPosition >= 0 && overflowPosition >= aligned && overflowPosition < written) {
+				for (std::ptrdiff_t i = overflowMoved; i < overflow.size(); i++)
+					put(overflow[i]);
+			}
+			for (auto& stripe : stripes) {
+				for (auto& element : stripe.buffers[b])
+					put(element);
+			}
+		}
+		stripes.clear();
+		overflow.clear();
+
+		//buckets are sorted recursively, equality buckets are already sorted
+		algogin::ThreadPool::Group group;
+		for (int b = 0; b < buckets; b++) {
+			std::ptrdiff_t begin = starts[b], end = starts[b + 1];
+			if (end - begin <= 1 || classifier.isEqualBucket(b))
+				continue;
+
+			auto sortBucket = [=, this, &less] {
+				//the whole range in one bucket: sample sort doesn't make progress, introsort handles such input
+				if (end - begin == size)
+					_quickSort(first + begin, first + end, 2 * std::bit_width(static_cast<size_t>(size)), less);
+				else
+					_sampleSort(first + begin, first + end, pool, less);
+			};
+			if (pool && end - begin >= PARALLEL_THRESHOLD)
+				pool->run(group, sortBucket);
+			else
+				sortBucket();
+		}
+		if (pool)
+			pool->wait(group);
+	}
+
+	//unsigned integer of the same size
+	template <class T>
+	using RadixKey = std::conditional_t<sizeof(T) == 1, uint8_t, std::conditional_t<sizeof(T) == 2, uint16_t,
+					 std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>>>;
+
+	//signed integers: sign bit is flipped, so negative numbers go first.
+	//Floats: sign bit is set for positive numbers, all bits are flipped for negative ones (bigger magnitude - smaller key)
+	template <RadixSortable T>
+	static RadixKey<T> _radixKey(T value) noexcept {
+		using Key = RadixKey<T>;
+		constexpr Key SIGN = Key(1) << (sizeof(T) * 8 - 1);
+		if constexpr (std::floating_point<T>) {
+			Key bits = std::bit_cast<Key>(value);
+			//all ones for negative numbers, sign bit only for positive ones
+			Key flip = static_cast<Key>(Key(0) - (bits >> (sizeof(T) * 8 - 1))) | SIGN;
+			return static_cast<Key>(bits ^ flip);
+		}
+		else if constexpr (std::signed_integral<T>) {
+			return static_cast<Key>(static_cast<Key>(value) ^ SIGN);
+		}
+		else {
+			return static_cast<Key>(value);
+		}
+	}
+
+	//8-bit digits for bytes, 16-bit digits (one pass) for big arrays of 16-bit keys, 11-bit digits for 32 and 64-bit keys:
+	//2048 counters fit to L1 and there are 3 passes instead of 4 for 32-bit keys
+	template <class Key>
+	static int _getDigitBits(std::ptrdiff_t size) noexcept {
+		if constexpr (sizeof(Key) == 1)
+			return 8;
+		else if constexpr (sizeof(Key) == 2)
+			return size >= (1 << 16) ? 16 : 8;
+		else
+			return 11;
+	}
+
+	//body(chunk) for every chunk, chunks except the first one are tasks of pool
+	template <class F>
+	static void _forChunks(algogin::ThreadPool* pool, int chunks, F&& body) {
+		if (chunks == 1) {
+			body(0);
+			return;
+		}
+
+		algogin::ThreadPool::Group group;
+		for (int chunk = 1; chunk < chunks; chunk++)
+			pool->run(group, [&body, chunk] { body(chunk); });
+		body(0);
+		pool->wait(group);
+	}
+
+	//LSD radix sort, stable: every pass distributes elements by one digit from source to target array.
+	//Histograms of all digits are counted in one pass, digits which are the same for all elements are skipped.
+	//Elements are split to chunks, one per thread: every chunk has own histogram, so its elements are scattered to
+	//own ranges of buckets without synchronization. Payload (iterator or nullptr) is moved together with elements
+	template <class Iterator, class Payload, class Projection>
+	void _radixSort(Iterator first, Iterator last, Payload payload, int digitBits, algogin::ThreadPool* pool, Projection& projection) {
+		using T = std::iter_value_t<Iterator>;
+		constexpr bool HAS_PAYLOAD = std::is_same_v<Payload, std::nullptr_t> == false;
+		auto getKey = [&projection](const T& element) { return _radixKey(std::invoke(projection, element)); };
+		using Key = decltype(getKey(*first));
+		std::ptrdiff_t size = last - first;
+		if (size <= 1)
+			return;
+
+		if (digitBits == 0)
+			digitBits = _getDigitBits<Key>(size);
+		const int digits = (static_cast<int>(sizeof(Key)) * 8 + digitBits - 1) / digitBits;
+		const size_t radix = size_t(1) << digitBits;
+		const Key mask = static_cast<Key>(radix - 1);
+		int chunks = 1;
+		if (pool)
+			chunks = static_cast<int>(std::clamp<std::ptrdiff_t>(size / PARALLEL_THRESHOLD, 1, pool->getThreads() + 1));
+		auto chunkBegin = [size, chunks](int chunk) { return size * chunk / chunks; };
+
+		//counts[chunk][digit][bucket]
+		std::vector<std::ptrdiff_t> counts(static_cast<size_t>(chunks) * digits * radix, 0);
+		_forChunks(pool, chunks, [&](int chunk) {
+			std::ptrdiff_t* count = counts.data() + static_cast<size_t>(chunk) * digits * radix;
+			for (std::ptrdiff_t i = chunkBegin(chunk); i < chunkBegin(chunk + 1); i++) {
+				Key key = getKey(first[i]);
+				for (int digit = 0; digit < digits; digit++)
+					count[digit * radix + ((key >> (digit * digitBits)) & mask)]++;
+			}
+		});
+
+		std::vector<int> active;
+		for (int digit = 0; digit < digits; digit++) {
+			bool constant = false;
+			for (size_t bucket = 0; bucket < radix && constant == false; bucket++) {
+				std::ptrdiff_t total = 0;
+				for (int chunk = 0; chunk < chunks; chunk++)
+					total += counts[(static_cast<size_t>(chunk) * digits + digit) * radix + bucket];
+				constant = total == size;
+			}
+			if (constant == false)
+				active.push_back(digit);
+		}
+		if (active.empty())
+			return;
+
+		std::vector<T> buffer(std::make_move_iterator(first), std::make_move_iterator(last));
+		using PayloadValue = std::conditional_t<HAS_PAYLOAD, std::iter_value_t<std::conditional_t<HAS_PAYLOAD, Payload, int*>>, int>;
+		std::vector<PayloadValue> payloadBuffer;
+		if constexpr (HAS_PAYLOAD)
+			payloadBuffer.assign(std::make_move_iterator(payload), std::make_move_iterator(payload + size));
+
+		std::vector<std::ptrdiff_t> offsets(static_cast<size_t>(chunks) * radix);
+		auto pass = [&](auto source, auto sourcePayload, auto target, auto targetPayload, int digit, bool recount) {
+			const int shift = digit * digitBits;
+			//chunk histograms of the first pass are counted before, later passes see elements in new order
+			if (recount) {
+				_forChunks(pool, chunks, [&](int chunk) {
+					std::ptrdiff_t* count = counts.data() + (static_cast<size_t>(chunk) * digits + digit) * radix;
+					std::fill(count, count + radix, 0);
+					for (std::ptrdiff_t i = chunkBegin(chunk); i < chunkBegin(chunk + 1); i++)
+						count[(getKey(source[i]) >> shift) & mask]++;
+				});
+			}
+
+			//bucket-major, chunk-minor prefix sums keep order of chunks inside bucket, so sort stays stable
+			std::ptrdiff_t offset = 0;
+			for (size_t bucket = 0; bucket < radix; bucket++) {
+				for (int chunk = 0; chunk < chunks; chunk++) {
+					offsets[chunk * radix + bucket] = offset;
+					offset += counts[(static_cast<size_t>(chunk) * digits + digit) * radix + bucket];
+				}
+			}
+
+			_forChunks(pool, chunks, [&](int chunk) {
+				std::ptrdiff_t* offset = offsets.data() + chunk * radix;
+				for (std::ptrdiff_t i = chunkBegin(chunk); i < chunkBegin(chunk + 1); i++) {
+					std::ptrdiff_t position = offset[(getKey(source[i]) >> shift) & mask]++;
+					if constexpr (HAS_PAYLOAD)
+						targetPayload[position] = std::move(sourcePayload[i]);
+					target[position] = std::move(source[i]);
+				}
+			});
+		};
+
+		for (int i = 0; i < active.size(); i++) {
+			//with one chunk the global histogram is valid for any order of elements
+			bool recount = i > 0 && chunks > 1;
+			if (i % 2 == 0)
+				pass(buffer.begin(), payloadBuffer.begin(), first, payload, active[i], recount);
+			else
+				pass(first, payload, buffer.begin(), payloadBuffer.begin(), active[i], recount);
+		}
+
+		if (active.size() % 2 == 0) {
+			std::move(buffer.begin(), buffer.end(), first);
+			if constexpr (HAS_PAYLOAD)
+				std::move(payloadBuffer.begin(), payloadBuffer.end(), payload);
 		}
 	}
+
+	//MSD radix sort (American flag sort), in place and not stable: elements are counted by the highest byte,
+	//swapped to their buckets in cycles and every bucket is sorted by the next byte. Small buckets are sorted by introsort
+	template <class Iterator, class Projection>
+	void _msdRadixSort(Iterator first, Iterator last, int shift, Projection& projection) {
+		using T = std::iter_value_t<Iterator>;
+		auto getKey = [&projection](const T& element) { return _radixKey(std::invoke(projection, element)); };
+		std::ptrdiff_t size = last - first;
+		if (size <= 256) {
+			auto less = [&getKey](const T& left, const T& right) { return getKey(left) < getKey(right); };
+			_quickSort(first, last, 2 * static_cast<int>(std::bit_width(static_cast<size_t>(size))), less);
+			return;
+		}
+
+		std::ptrdiff_t counts[256];
+		//byte which is the same for all elements is skipped
+		while (true) {
+			std::fill(counts, counts + 256, 0);
+			for (Iterator i = first; i != last; ++i)
+				counts[(getKey(*i) >> shift) & 0xFF]++;
+			if (*std::max_element(counts, counts + 256) < size)
+				break;
+			if (shift == 0)
+				return;
+			shift -= 8;
+		}
+
+		std::ptrdiff_t heads[256], tails[256];
+		std::ptrdiff_t offset = 0;
+		for (int bucket = 0; bucket < 256; bucket++) {
+			heads[bucket] = offset;
+			offset += counts[bucket];
+			tails[bucket] = offset;
+		}
+
+		for (int bucket = 0; bucket < 256; bucket++) {
+			while (heads[bucket] < tails[bucket]) {
+				auto digit = (getKey(first[heads[bucket]]) >> shift) & 0xFF;
+				if (digit == bucket)
+					heads[bucket]++;
+				else
+					std::iter_swap(first + heads[bucket], first + heads[digit]++);
+			}
+		}
+
+		if (shift == 0)
+			return;
+		std::ptrdiff_t begin = 0;
+		for (int bucket = 0; bucket < 256; bucket++) {
+			if (counts[bucket] > 1)
+				_msdRadixSort(first + begin, first + begin + counts[bucket], shift - 8, projection);
+			begin += counts[bucket];
+		}
+	}
+
+	//runs shorter than this are extended by insertion sort
+	static constexpr std::ptrdiff_t MIN_RUN = 32;
+	//merge switches to galloping after this number of consecutive elements taken from one run
+	static constexpr int MIN_GALLOP = 7;
+
+	//position of key in sorted range: the first element greater than key (Upper) or not less than key.
+	//Exponential search from the start or from the end finds positions close to it in O(log distance)
+	template <bool Upper, bool FromEnd, class Iterator, class T, class Compare>
+	std::ptrdiff_t _gallop(const T& key, Iterator first, std::ptrdiff_t size, Compare& less) {
+		auto before = [&](std::ptrdiff_t i) { return Upper ? less(key, first[i]) == false : less(first[i], key); };
+		//position is in (low, high]
+		std::ptrdiff_t low = -1, high = size, step = 1;
+		if constexpr (FromEnd) {
+			std::ptrdiff_t i = size - 1;
+			while (i >= 0 && before(i) == false) {
+				high = i;
+				i -= step;
+				step *= 2;
+			}
+			low = std::max<std::ptrdiff_t>(i, -1);
+		}
+		else {
+			std::ptrdiff_t i = 0;
+			while (i < size && before(i)) {
+				low = i;
+				i += step;
+				step *= 2;
+			}
+			high = std::min(i, size);
+		}
+
+		low++;
+		while (low < high) {
+			std::ptrdiff_t middle = low + (high - low) / 2;
+			if (before(middle))
+				low = middle + 1;
+			else
+				high = middle;
+		}
+		return low;
+	}
+
+	//left run is moved to buffer and merged with right run from the start.
+	//If one run wins MIN_GALLOP times in a row, merge gallops: the position of the other run's head is found by
+	//exponential search and the whole block before it is moved at once. minGallop adapts to the data
+	template <class Iterator, class Buffer, class Compare>
+	void _mergeLow(Iterator first, Iterator middle, Iterator last, Buffer& buffer, int& minGallop, Compare& less) {
+		buffer.assign(std::make_move_iterator(first), std::make_move_iterator(middle));
+		auto left = buffer.begin(), leftEnd = buffer.end();
+		Iterator right = middle, output = first;
+		//decrements of unfinished galloping round aren't saved to minGallop
+		int gallop = minGallop;
+		*output++ = std::move(*right++);
+		while (right != last) {
+			//one counter of consecutive elements taken from the same run
+			int wins = 0;
+			bool previous = false;
+			while (right != last && left != leftEnd && wins < gallop) {
+				bool fromRight = less(*right, *left);
+				*output++ = std::move(fromRight ? *right : *left);
+				right += fromRight;
+				left += !fromRight;
+				wins = fromRight == previous ? wins + 1 : 1;
+				previous = fromRight;
+			}
+			if (left == leftEnd)
+				return;
+			if (right == last)
+				break;
+
+			//every galloping round makes the next switch easier, leaving after one round makes it harder
+			int leftWins, rightWins;
+			gallop++;
+			do {
+				gallop -= gallop > 1;
+				std::ptrdiff_t count = _gallop<true, false>(*right, left, leftEnd - left, less);
+				output = std::move(left, left + count, output);
+				left += count;
+				leftWins = static_cast<int>(std::min<std::ptrdiff_t>(count, MIN_GALLOP));
+				if (left == leftEnd)
+					return;
+				*output++ = std::move(*right++);
+				if (right == last)
+					break;
+
+				count = _gallop<false, false>(*left, right, last - right, less);
+				output = std::move(right, right + count, output);
+				right += count;
+				rightWins = static_cast<int>(std::min<std::ptrdiff_t>(count, MIN_GALLOP));
+				if (right == last)
+					break;
+				*output++ = std::move(*left++);
+				if (left == leftEnd)
+					return;
+			} while (leftWins >= MIN_GALLOP || rightWins >= MIN_GALLOP);
+			//leaving galloping mode is penalized
+			minGallop = ++gallop;
+		}
+		//right run is finished, the rest of left run goes to the end
+		std::move(left, leftEnd, output);
+	}
+
+	//right run is moved to buffer and merged with left run from the end
+	template <class Iterator, class Buffer, class Compare>
+	void _mergeHigh(Iterator first, Iterator middle, Iterator last, Buffer& buffer, int& minGallop, Compare& less) {
+		buffer.assign(std::make_move_iterator(middle), std::make_move_iterator(last));
+		auto rightBegin = buffer.begin(), right = buffer.end();
+		Iterator left = middle, output = last;
+		int gallop = minGallop;
+		*--output = std::move(*--left);
+		while (left != first) {
+			int wins = 0;
+			bool previous = false;
+			while (left != first && right != rightBegin && wins < gallop) {
+				bool fromLeft = less(*(right - 1), *(left - 1));
+				*--output = std::move(fromLeft ? *(left - 1) : *(right - 1));
+				left -= fromLeft;
+				right -= !fromLeft;
+				wins = fromLeft == previous ? wins + 1 : 1;
+				previous = fromLeft;
+			}
+			if (right == rightBegin)
+				return;
+			if (left == first)
+				break;
+
+			int leftWins, rightWins;
+			gallop++;
+			do {
+				gallop -= gallop > 1;
+				//elements of left run greater than the last element of right run
+				std::ptrdiff_t count = (left - first) - _gallop<true, true>(*(right - 1), first, left - first, less);
+				output = std::move_backward(left - count, left, output);
+				left -= count;
+				leftWins = static_cast<int>(std::min<std::ptrdiff_t>(count, MIN_GALLOP));
+				if (left == first)
+					break;
+				*--output = std::move(*--right);
+				if (right == rightBegin)
+					return;
+
+				//elements of right run not less than the last element of left run
+				count = (right - rightBegin) - _gallop<false, true>(*(left - 1), rightBegin, right - rightBegin, less);
+				output = std::move_backward(right - count, right, output);
+				right -= count;
+				rightWins = static_cast<int>(std::min<std::ptrdiff_t>(count, MIN_GALLOP));
+				if (right == rightBegin)
+					return;
+				*--output = std::move(*--left);
+				if (left == first)
+					break;
+			} while (leftWins >= MIN_GALLOP || rightWins >= MIN_GALLOP);
+			minGallop = ++gallop;
+		}
+		//left run is finished, the rest of right run goes to the start
+		std::move_backward(rightBegin, right, output);
+	}
+
+	//merges adjacent sorted runs in place. Elements which are already in place are skipped by galloping, the shorter
+	//of remaining parts is moved to buffer. If it doesn't fit buffer capacity, the longer part is split at the middle,
+	//the other part at the same key, inner pieces are rotated and both halves are merged recursively
+	template <class Iterator, class Buffer, class Compare>
+	void _mergeRuns(Iterator first, Iterator middle, Iterator last, Buffer& buffer, std::ptrdiff_t capacity, int& minGallop, Compare& less) {
+		first += _gallop<true, false>(*middle, first, middle - first, less);
+		if (first == middle)
+			return;
+		last = middle + _gallop<false, true>(*(middle - 1), middle, last - middle, less);
+		if (middle == last)
+			return;
+
+		std::ptrdiff_t leftSize = middle - first, rightSize = last - middle;
+		if (std::min(leftSize, rightSize) > capacity) {
+			Iterator leftCut, rightCut;
+			if (leftSize >= rightSize) {
+				leftCut = first + leftSize / 2;
+				rightCut = std::lower_bound(middle, last, *leftCut, less);
+			}
+			else {
+				rightCut = middle + rightSize / 2;
+				leftCut = std::upper_bound(first, middle, *rightCut, less);
+			}
+			Iterator newMiddle = std::rotate(leftCut, middle, rightCut);
+			if (first != leftCut && leftCut != newMiddle)
+				_mergeRuns(first, leftCut, newMiddle, buffer, capacity, minGallop, less);
+			if (newMiddle != rightCut && rightCut != last)
+				_mergeRuns(newMiddle, rightCut, last, buffer, capacity, minGallop, less);
+			return;
+		}
+
+		if (leftSize <= rightSize)
+			_mergeLow(first, middle, last, buffer, minGallop, less);
+		else
+			_mergeHigh(first, middle, last, buffer, minGallop, less);
+	}
+
+	//power of the boundary between adjacent runs [begin, begin + leftSize) and [begin + leftSize, ... + rightSize):
+	//the first bit where binary fractions of their midpoints relative to size differ. Merging boundaries in decreasing
+	//order of power gives merge tree close to optimal for run lengths
+	static int _getPower(std::ptrdiff_t begin, std::ptrdiff_t leftSize, std::ptrdiff_t rightSize, std::ptrdiff_t size) noexcept {
+		//doubled midpoints
+		std::ptrdiff_t a = 2 * begin + leftSize;
+		std::ptrdiff_t b = a + leftSize + rightSize;
+		int power = 0;
+		while (true) {
+			power++;
+			if (a >= size) {
+				a -= size;
+				b -= size;
+			}
+			else if (b >= size) {
+				break;
+			}
+			a <<= 1;
+			b <<= 1;
+		}
+		return power;
+	}
+
+	//length of natural run starting at first: non-descending or strictly descending (it's reversed, strictness keeps
+	//stability). Runs shorter than MIN_RUN are extended by insertion sort
+	template <class Iterator, class Compare>
+	std::ptrdiff_t _findRun(Iterator first, Iterator last, Compare& less) {
+		std::ptrdiff_t size = last - first;
+		if (size <= 1)
+			return size;
+
+		std::ptrdiff_t length = 2;
+		if (less(first[1], first[0])) {
+			while (length < size && less(first[length], first[length - 1]))
+				length++;
+			std::reverse(first, first + length);
+		}
+		else {
+			while (length < size && less(first[length], first[length - 1]) == false)
+				length++;
+		}
+
+		if (length < MIN_RUN) {
+			length = std::min(MIN_RUN, size);
+			_insertionSort(first, first + length, less);
+		}
+		return length;
+	}
+
+	//powersort: natural runs are found left to right, every new run gives a boundary with power, runs on stack with
+	//boundaries of higher power are merged before the new one is pushed. Sorted input is one run found in n - 1 comparisons
+	template <class Iterator, class Compare>
+	void _powerSort(Iterator first, Iterator last, Compare& less) {
+		struct Run {
+			std::ptrdiff_t begin;
+			std::ptrdiff_t size;
+			int power;
+		};
+
+		std::ptrdiff_t size = last - first;
+		std::ptrdiff_t length = _findRun(first, last, less);
+		if (length == size)
+			return;
+
+		std::vector<std::iter_value_t<Iterator>> buffer;
+		//merges use buffer of n / 8 elements at most, longer merges are split by rotations
+		std::ptrdiff_t capacity = std::max(MIN_RUN, size / 8);
+		int minGallop = MIN_GALLOP;
+		std::vector<Run> stack;
+		Run current = { 0, length, 0 };
+		while (current.begin + current.size < size) {
+			std::ptrdiff_t begin = current.begin + current.size;
+			Run next = { begin, _findRun(first + begin, last, less), 0 };
+			int power = _getPower(current.begin, current.size, next.size, size);
+			while (stack.empty() == false && stack.back().power > power) {
+				Run& top = stack.back();
+				_mergeRuns(first + top.begin, first + current.begin, first + current.begin + current.size, buffer, capacity, minGallop, less);
+				current = { top.begin, top.size + current.size, 0 };
+				stack.pop_back();
+			}
+			current.power = power;
+			stack.push_back(current);
+			current = next;
+		}
+
+		while (stack.empty() == false) {
+			Run& top = stack.back();
+			_mergeRuns(first + top.begin, first + current.begin, first + current.begin + current.size, buffer, capacity, minGallop, less);
+			current = { top.begin, top.size + current.size, 0 };
+			stack.pop_back();
+		}
+	}
+
+	//comparator applied to projected elements
+	template <class Compare, class Projection>
+	static auto _makeLess(Compare& compare, Projection& projection) {
+		if constexpr ((std::is_same_v<Compare, std::less<>> || std::is_same_v<Compare, std::ranges::less>) &&
+					  std::is_same_v<Projection, std::identity>)
+			return NaturalLess();
+		else
+			return [&compare, &projection](const auto& left, const auto& right) -> bool {
+				return std::invoke(compare, std::invoke(projection, left), std::invoke(projection, right));
+			};
+	}
 public:
 	Sorting() = default;
 	~Sorting() = default;
-	
-	template <class T>
-	std::vector<T> bubbleSort(std::vector<T> input) {
-		std::vector<T> output(input);
 
+	//In-place overloads sort [first, last) or span by compare(projection(a), projection(b)) without copies of input.
+	//By-value overloads sort their argument in place and return it, so rvalue input is moved through without copies.
+
+	template <std::random_access_iterator Iterator, class Compare = std::less<>, class Projection = std::identity>
+		requires std::sortable<Iterator, Compare, Projection>
+	void bubbleSort(Iterator first, Iterator last, Compare compare = {}, Projection projection = {}) {
+		auto less = _makeLess(compare, projection);
 		//early stop to guarantee O(n) if array is sorted
-		for (int i = 1; i < output.size(); i++) {
+		for (auto end = last; end - first > 1; --end) {
 			bool swapped = false;
-			for (int j = 0; j < output.size() - i; j++) {
-				if (output[j] > output[j + 1]) {
-					std::swap(output[j], output[j + 1]);
+			for (auto j = first; j + 1 != end; ++j) {
+				if (less(*(j + 1), *j)) {
+					std::iter_swap(j, j + 1);
 					swapped = true;
 				}
 			}
 			if (swapped == false)
 				break;
 		}
+	}
 
-		return output;
+	template <class T, class Compare = std::less<>, class Projection = std::identity>
+	void bubbleSort(std::span<T> input, Compare compare = {}, Projection projection = {}) {
+		bubbleSort(input.begin(), input.end(), std::move(compare), std::move(projection));
 	}
 
-	template <class T>
-	std::vector<T> selectionSort(std::vector<T> input) {
-		std::vector<T> output(input);
+	template <class T, class Compare = std::less<>, class Projection = std::identity>
+	std::vector<T> bubbleSort(std::vector<T> input, Compare compare = {}, Projection projection = {}) {
+		bubbleSort(input.begin(), input.end(), std::move(compare), std::move(projection));
+		return input;
+	}
 
-		for (int i = 0; i < output.size() - 1; i++) {
-			T minimum = i;
-			for (int j = i + 1; j < output.size(); j++) {
-				if (output[minimum] > output[j])
+	template <std::random_access_iterator Iterator, class Compare = std::less<>, class Projection = std::identity>
+		requires std::sortable<Iterator, Compare, Projection>
+	void selectionSort(Iterator first, Iterator last, Compare compare = {}, Projection projection = {}) {
+		auto less = _makeLess(compare, projection);
+		for (auto i = first; last - i > 1; ++i) {
+			auto minimum = i;
+			for (auto j = i + 1; j != last; ++j) {
+				if (less(*j, *minimum))
 					minimum = j;
 			}
-			std::swap(output[i], output[minimum]);
+			std::iter_swap(i, minimum);
 		}
+	}
 
-		return output;
+	template <class T, class Compare = std::less<>, class Projection = std::identity>
+	void selectionSort(std::span<T> input, Compare compare = {}, Projection projection = {}) {
+		selectionSort(input.begin(), input.end(), std::move(compare), std::move(projection));
 	}
 
-	template <class T>
-	std::vector<T> insertionSort(std::vector<T> input) {
-		std::vector<T> output(input);
-		//we divide array to 2 parts: sorted and unsorted
-		//first element is already sorted so pick starting from second
-		for (int i = 1; i < output.size(); i++) {
-			int j = i;
-			//swap all elements to one element right if current element less than previous one
-			while (j > 0 && output[j] < output[j - 1]) {
-				std::swap(output[j], output[j - 1]);
-				j--;
-			}
-		}
+	template <class T, class Compare = std::less<>, class Projection = std::identity>
+	std::vector<T> selectionSort(std::vector<T> input, Compare compare = {}, Projection projection = {}) {
+		selectionSort(input.begin(), input.end(), std::move(compare), std::move(projection));
+		return input;
+	}
 
-		return output;
+	template <std::random_access_iterator Iterator, class Compare = std::less<>, class Projection = std::identity>
+		requires std::sortable<Iterator, Compare, Projection>
+	void insertionSort(Iterator first, Iterator last, Compare compare = {}, Projection projection = {}) {
+		auto less = _makeLess(compare, projection);
+		//we divide array to 2 parts: sorted and unsorted, every new element is shifted left to its place
+		_insertionSort(first, last, less);
 	}
 
-	template <class T>
-	std::vector<T> mergeSort(std::vector<T> input) {
-		std::vector<T> output(input);
-		_mergeSort(output, 0, output.size());
+	template <class T, class Compare = std::less<>, class Projection = std::identity>
+	void insertionSort(std::span<T> input, Compare compare = {}, Projection projection = {}) {
+		insertionSort(input.begin(), input.end(), std::move(compare), std::move(projection));
+	}
 
-		return output;
+	template <class T, class Compare = std::less<>, class Projection = std::identity>
+	std::vector<T> insertionSort(std::vector<T> input, Compare compare = {}, Projection projection = {}) {
+		insertionSort(input.begin(), input.end(), std::move(compare), std::move(projection));
+		return input;
 	}
 
-	template <class T>
-	std::vector<T> quickSort(std::vector<T> input) {
-		std::vector<T> output(input);
+	//stable
+	template <std::random_access_iterator Iterator, class Compare = std::less<>, class Projection = std::identity>
+		requires std::sortable<Iterator, Compare, Projection>
+	void mergeSort(Iterator first, Iterator last, Compare compare = {}, Projection projection = {}) {
+		auto less = _makeLess(compare, projection);
+		_mergeSort(first, last, nullptr, less);
+	}
+
+	template <class T, class Compare = std::less<>, class Projection = std::identity>
+	void mergeSort(std::span<T> input, Compare compare = {}, Projection projection = {}) {
+		mergeSort(input.begin(), input.end(), std::move(compare), std::move(projection));
+	}
+
+	template <class T, class Compare = std::less<>, class Projection = std::identity>
+	std::vector<T> mergeSort(std::vector<T> input, Compare compare = {}, Projection projection = {}) {
+		mergeSort(input.begin(), input.end(), std::move(compare), std::move(projection));
+		return input;
+	}
+
+	//stable, halves are sorted by tasks of pool and long merges are split between its threads
+	template <std::random_access_iterator Iterator, class Compare = std::less<>, class Projection = std::identity>
+		requires std::sortable<Iterator, Compare, Projection>
+	void parallelMergeSort(Iterator first, Iterator last, algogin::ThreadPool& pool, Compare compare = {}, Projection projection = {}) {
+		auto less = _makeLess(compare, projection);
+		_mergeSort(first, last, &pool, less);
+	}
+
+	template <class T, class Compare = std::less<>, class Projection = std::identity>
+	void parallelMergeSort(std::span<T> input, algogin::ThreadPool& pool, Compare compare = {}, Projection projection = {}) {
+		parallelMergeSort(input.begin(), input.end(), pool, std::move(compare), std::move(projection));
+	}
+
+	template <class T, class Compare = std::less<>, class Projection = std::identity>
+	std::vector<T> parallelMergeSort(std::vector<T> input, algogin::ThreadPool& pool, Compare compare = {}, Projection projection = {}) {
+		parallelMergeSort(input.begin(), input.end(), pool, std::move(compare), std::move(projection));
+		return input;
+	}
+
+	//introsort, O(n log n) in the worst case, not stable
+	template <std::random_access_iterator Iterator, class Compare = std::less<>, class Projection = std::identity>
+		requires std::sortable<Iterator, Compare, Projection>
+	void quickSort(Iterator first, Iterator last, Compare compare = {}, Projection projection = {}) {
+		auto less = _makeLess(compare, projection);
+		_quickSort(first, last, 2 * std::bit_width(static_cast<size_t>(last - first)), less);
+	}
+
+	template <class T, class Compare = std::less<>, class Projection = std::identity>
+	void quickSort(std::span<T> input, Compare compare = {}, Projection projection = {}) {
+		quickSort(input.begin(), input.end(), std::move(compare), std::move(projection));
+	}
+
+	template <class T, class Compare = std::less<>, class Projection = std::identity>
+	std::vector<T> quickSort(std::vector<T> input, Compare compare = {}, Projection projection = {}) {
+		quickSort(input.begin(), input.end(), std::move(compare), std::move(projection));
+		return input;
+	}
+
+	//in-place sample sort, not stable. Value type has to be copyable: splitters are copies of elements
+	template <std::random_access_iterator Iterator, class Compare = std::less<>, class Projection = std::identity>
+		requires std::sortable<Iterator, Compare, Projection> && std::copy_constructible<std::iter_value_t<Iterator>>
+	void sampleSort(Iterator first, Iterator last, Compare compare = {}, Projection projection = {}) {
+		auto less = _makeLess(compare, projection);
+		_sampleSort(first, last, nullptr, less);
+	}
+
+	template <class T, class Compare = std::less<>, class Projection = std::identity>
+	void sampleSort(std::span<T> input, Compare compare = {}, Projection projection = {}) {
+		sampleSort(input.begin(), input.end(), std::move(compare), std::move(projection));
+	}
+
+	template <class T, class Compare = std::less<>, class Projection = std::identity>
+	std::vector<T> sampleSort(std::vector<T> input, Compare compare = {}, Projection projection = {}) {
+		sampleSort(input.begin(), input.end(), std::move(compare), std::move(projection));
+		return input;
+	}
+
+	//stripes are classified by threads of pool, buckets are sorted as tasks of pool
+	template <std::random_access_iterator Iterator, class Compare = std::less<>, class Projection = std::identity>
+		requires std::sortable<Iterator, Compare, Projection> && std::copy_constructible<std::iter_value_t<Iterator>>
+	void parallelSampleSort(Iterator first, Iterator last, algogin::ThreadPool& pool, Compare compare = {}, Projection projection = {}) {
+		auto less = _makeLess(compare, projection);
+		_sampleSort(first, last, &pool, less);
+	}
+
+	template <class T, class Compare = std::less<>, class Projection = std::identity>
+	void parallelSampleSort(std::span<T> input, algogin::ThreadPool& pool, Compare compare = {}, Projection projection = {}) {
+		parallelSampleSort(input.begin(), input.end(), pool, std::move(compare), std::move(projection));
+	}
+
+	template <class T, class Compare = std::less<>, class Projection = std::identity>
+	std::vector<T> parallelSampleSort(std::vector<T> input, algogin::ThreadPool& pool, Compare compare = {}, Projection projection = {}) {
+		parallelSampleSort(input.begin(), input.end(), pool, std::move(compare), std::move(projection));
+		return input;
+	}
+
+	//powersort: stable and adaptive, O(n) for sorted input and O(n + k log n) for sorted input with k inserted elements
+	template <std::random_access_iterator Iterator, class Compare = std::less<>, class Projection = std::identity>
+		requires std::sortable<Iterator, Compare, Projection>
+	void powerSort(Iterator first, Iterator last, Compare compare = {}, Projection projection = {}) {
+		auto less = _makeLess(compare, projection);
+		_powerSort(first, last, less);
+	}
+
+	template <class T, class Compare = std::less<>, class Projection = std::identity>
+	void powerSort(std::span<T> input, Compare compare = {}, Projection projection = {}) {
+		powerSort(input.begin(), input.end(), std::move(compare), std::move(projection));
+	}
+
+	template <class T, class Compare = std::less<>, class Projection = std::identity>
+	std::vector<T> powerSort(std::vector<T> input, Compare compare = {}, Projection projection = {}) {
+		powerSort(input.begin(), input.end(), std::move(compare), std::move(projection));
+		return input;
+	}
+
+	//LSD radix sort, stable, O(n * key bytes). Digit has 8, 11 or 16 bits (0 - chosen by key size)
+	template <int DigitBits = 0, std::random_access_iterator Iterator, class Projection = std::identity>
+		requires RadixSortable<std::remove_cvref_t<std::invoke_result_t<Projection&, std::iter_reference_t<Iterator>>>>
+	void radixSort(Iterator first, Iterator last, Projection projection = {}) {
+		static_assert(DigitBits == 0 || DigitBits == 8 || DigitBits == 11 || DigitBits == 16);
+		_radixSort(first, last, nullptr, DigitBits, nullptr, projection);
+	}
+
+	template <int DigitBits = 0, class T, class Projection = std::identity>
+		requires RadixSortable<std::remove_cvref_t<std::invoke_result_t<Projection&, T&>>>
+	void radixSort(std::span<T> input, Projection projection = {}) {
+		radixSort<DigitBits>(input.begin(), input.end(), std::move(projection));
+	}
+
+	template <int DigitBits = 0, class T, class Projection = std::identity>
+		requires RadixSortable<std::remove_cvref_t<std::invoke_result_t<Projection&, T&>>>
+	std::vector<T> radixSort(std::vector<T> input, Projection projection = {}) {
+		radixSort<DigitBits>(input.begin(), input.end(), std::move(projection));
+		return input;
+	}
 
-		_quickSort(output, 0, output.size());
+	//keys are sorted, values[i] follows keys[i]
+	template <int DigitBits = 0, RadixSortable K, class V>
+	void radixSort(std::span<K> keys, std::span<V> values) {
+		static_assert(DigitBits == 0 || DigitBits == 8 || DigitBits == 11 || DigitBits == 16);
+		std::identity projection;
+		_radixSort(keys.begin(), keys.begin() + std::min(keys.size(), values.size()), values.begin(), DigitBits, nullptr, projection);
+	}
+
+	//LSD radix sort where every thread of pool counts and scatters own chunk of elements
+	template <int DigitBits = 0, std::random_access_iterator Iterator, class Projection = std::identity>
+		requires RadixSortable<std::remove_cvref_t<std::invoke_result_t<Projection&, std::iter_reference_t<Iterator>>>>
+	void parallelRadixSort(Iterator first, Iterator last, algogin::ThreadPool& pool, Projection projection = {}) {
+		static_assert(DigitBits == 0 || DigitBits == 8 || DigitBits == 11 || DigitBits == 16);
+		_radixSort(first, last, nullptr, DigitBits, &pool, projection);
+	}
+
+	template <int DigitBits = 0, class T, class Projection = std::identity>
+		requires RadixSortable<std::remove_cvref_t<std::invoke_result_t<Projection&, T&>>>
+	void parallelRadixSort(std::span<T> input, algogin::ThreadPool& pool, Projection projection = {}) {
+		parallelRadixSort<DigitBits>(input.begin(), input.end(), pool, std::move(projection));
+	}
+
+	template <int DigitBits = 0, RadixSortable K, class V>
+	void parallelRadixSort(std::span<K> keys, std::span<V> values, algogin::ThreadPool& pool) {
+		static_assert(DigitBits == 0 || DigitBits == 8 || DigitBits == 11 || DigitBits == 16);
+		std::identity projection;
+		_radixSort(keys.begin(), keys.begin() + std::min(keys.size(), values.size()), values.begin(), DigitBits, &pool, projection);
+	}
+
+	//MSD radix sort by bytes, in place, not stable
+	template <std::random_access_iterator Iterator, class Projection = std::identity>
+		requires RadixSortable<std::remove_cvref_t<std::invoke_result_t<Projection&, std::iter_reference_t<Iterator>>>>
+	void msdRadixSort(Iterator first, Iterator last, Projection projection = {}) {
+		using Key = std::remove_cvref_t<std::invoke_result_t<Projection&, std::iter_reference_t<Iterator>>>;
+		_msdRadixSort(first, last, static_cast<int>(sizeof(Key)) * 8 - 8, projection);
+	}
+
+	template <class T, class Projection = std::identity>
+		requires RadixSortable<std::remove_cvref_t<std::invoke_result_t<Projection&, T&>>>
+	void msdRadixSort(std::span<T> input, Projection projection = {}) {
+		msdRadixSort(input.begin(), input.end(), std::move(projection));
+	}
+
+	//radix sort for ascending order of radix sortable keys (it's stable), introsort for anything else
+	template <std::random_access_iterator Iterator, class Compare = std::less<>, class Projection = std::identity>
+		requires std::sortable<Iterator, Compare, Projection>
+	void sort(Iterator first, Iterator last, Compare compare = {}, Projection projection = {}) {
+		using Key = std::remove_cvref_t<std::invoke_result_t<Projection&, std::iter_reference_t<Iterator>>>;
+		if constexpr (RadixSortable<Key> && (std::is_same_v<Compare, std::less<>> || std::is_same_v<Compare, std::less<Key>> ||
+											 std::is_same_v<Compare, std::ranges::less>)) {
+			//histograms and buffer don't pay off for short ranges
+			if (last - first > 256) {
+				radixSort(first, last, std::move(projection));
+				return;
+			}
+		}
+		quickSort(first, last, std::move(compare), std::move(projection));
+	}
+
+	template <class T, class Compare = std::less<>, class Projection = std::identity>
+	void sort(std::span<T> input, Compare compare = {}, Projection projection = {}) {
+		sort(input.begin(), input.end(), std::move(compare), std::move(projection));
+	}
 
-		return output;
+	template <class T, class Compare = std::less<>, class Projection = std::identity>
+	std::vector<T> sort(std::vector<T> input, Compare compare = {}, Projection projection = {}) {
+		sort(input.begin(), input.end(), std::move(compare), std::move(projection));
+		return input;
 	}
 };
@@ -0,0 +1,308 @@
+#pragma once
+#include "Common.h"
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+//kernels are compiled for AVX2 and AVX-512 with target attributes, the one supported by CPU is chosen at runtime
+#define ALGOGIN_NETWORK_DISPATCH
+#endif
+
+namespace algogin {
+	namespace network {
+		template <class T>
+		concept NetworkSortable = std::same_as<T, int32_t> || std::same_as<T, float> || std::same_as<T, int64_t>;
+
+		//the longest array sorted by one network
+		constexpr int MAX_SIZE = 256;
+
+		enum class Level {
+			SCALAR,
+			AVX2,
+			AVX512
+		};
+
+		//the widest instruction set supported by CPU
+		inline Level getLevel() noexcept {
+#if defined(ALGOGIN_NETWORK_DISPATCH)
+			static const Level level = [] {
+				__builtin_cpu_init();
+				if (__builtin_cpu_supports("avx512f"))
+					return Level::AVX512;
+				if (__builtin_cpu_supports("avx2"))
+					return Level::AVX2;
+				return Level::SCALAR;
+			}();
+			return level;
+#else
+			return Level::SCALAR;
+#endif
+		}
+
+#if defined(ALGOGIN_NETWORK_DISPATCH)
+		//Every Ops type is a vector of WIDTH elements: compareExchange puts minimum of two vectors to the first one
+		//(maximum if descending), exchangeLanes compares lane i with lane i ^ distance and keeps maximum in lanes
+		//set in mask. Vectors are passed by reference only, so kernels compiled without AVX don't pass them in registers
+		template <class T>
+		struct Avx2Ops;
+
+		template <>
+		struct Avx2Ops<int32_t> {
+			using Vector = __m256i;
+			static constexpr int WIDTH = 8;
+
+			__attribute__((target("avx2"))) static void load(Vector& vector, const int32_t* data) noexcept {
+				vector = _mm256_load_si256(reinterpret_cast<const __m256i*>(data));
+			}
+			__attribute__((target("avx2"))) static void store(int32_t* data, const Vector& vector) noexcept {
+				_mm256_store_si256(reinterpret_cast<__m256i*>(data), vector);
+			}
+			__attribute__((target("avx2"))) static void compareExchange(Vector& first, Vector& second, bool descending) noexcept {
+				__m256i low = _mm256_min_epi32(first, second);
+				__m256i high = _mm256_max_epi32(first, second);
+				first = descending ? high : low;
+				second = descending ? low : high;
+			}
+			__attribute__((target("avx2"))) static void exchangeLanes(Vector& vector, int distance, uint32_t mask) noexcept {
+				__m256i partner;
+				if (distance == 1)
+					partner = _mm256_shuffle_epi32(vector, _MM_SHUFFLE(2, 3, 0, 1));
+				else if (distance == 2)
+					partner = _mm256_shuffle_epi32(vector, _MM_SHUFFLE(1, 0, 3, 2));
+				else
+					partner = _mm256_permute2x128_si256(vector, vector, 1);
+				const __m256i bits = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+				__m256i high = _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_set1_epi32(mask), bits), bits);
+				vector = _mm256_blendv_epi8(_mm256_min_epi32(vector, partner), _mm256_max_epi32(vector, partner), high);
+			}
+		};
+
+		//AVX2 has no 64-bit min and max, they are made of comparison and blend
+		template <>
+		struct Avx2Ops<int64_t> {
+			using Vector = __m256i;
+			static constexpr int WIDTH = 4;
+
+			__attribute__((target("avx2"))) static void load(Vector& vector, const int64_t* data) noexcept {
+				vector = _mm256_load_si256(reinterpret_cast<const __m256i*>(data));
+			}
+			__attribute__((target("avx2"))) static void store(int64_t* data, const Vector& vector) noexcept {
+				_mm256_store_si256(reinterpret_cast<__m256i*>(data), vector);
+			}
+			__attribute__((target("avx2"))) static void compareExchange(Vector& first, Vector& second, bool descending) noexcept {
+				__m256i greater = _mm256_cmpgt_epi64(first, second);
+				__m256i low = _mm256_blendv_epi8(first, second, greater);
+				__m256i high = _mm256_blendv_epi8(second, first, greater);
+				first = descending ? high : low;
+				second = descending ? low : high;
+			}
+			__attribute__((target("avx2"))) static void exchangeLanes(Vector& vector, int distance, uint32_t mask) noexcept {
+				__m256i partner;
+				if (distance == 1)
+					partner = _mm256_shuffle_epi32(vector, _MM_SHUFFLE(1, 0, 3, 2));
+				else
+					partner = _mm256_permute4x64_epi64(vector, _MM_SHUFFLE(1, 0, 3, 2));
+				__m256i greater = _mm256_cmpgt_epi64(vector, partner);
+				__m256i low = _mm256_blendv_epi8(vector, partner, greater);
+				__m256i high = _mm256_blendv_epi8(partner, vector, greater);
+				const __m256i bits = _mm256_setr_epi64x(1, 2, 4, 8);
+				__m256i takeHigh = _mm256_cmpeq_epi64(_mm256_and_si256(_mm256_set1_epi64x(mask), bits), bits);
+				vector = _mm256_blendv_epi8(low, high, takeHigh);
+			}
+		};
+
+		template <class T>
+		struct Avx512Ops;
+
+		template <>
+		struct Avx512Ops<int32_t> {
+			using Vector = __m512i;
+			static constexpr int WIDTH = 16;
+
+			__attribute__((target("avx512f"))) static void load(Vector& vector, const int32_t* data) noexcept {
+				vector = _mm512_load_si512(data);
+			}
+			__attribute__((target("avx512f"))) static void store(int32_t* data, const Vector& vector) noexcept {
+				_mm512_store_si512(data, vector);
+			}
+			__attribute__((target("avx512f"))) static void compareExchange(Vector& first, Vector& second, bool descending) noexcept {
+				__m512i low = _mm512_min_epi32(first, second);
+				__m512i high = _mm512_max_epi32(first, second);
+				first = descending ? high : low;
+				second = descending ? low : high;
+			}
+			__attribute__((target("avx512f"))) static void exchangeLanes(Vector& vector, int distance, uint32_t mask) noexcept {
+				__m512i partner;
+				if (distance == 1)
+					partner = _mm512_shuffle_epi32(vector, static_cast<_MM_PERM_ENUM>(_MM_SHUFFLE(2, 3, 0, 1)));
+				else if (distance == 2)
+					partner = _mm512_shuffle_epi32(vector, static_cast<_MM_PERM_ENUM>(_MM_SHUFFLE(1, 0, 3, 2)));
+				else if (distance == 4)
+					partner = _mm512_shuffle_i32x4(vector, vector, _MM_SHUFFLE(2, 3, 0, 1));
+				else
+					partner = _mm512_shuffle_i32x4(vector, vector, _MM_SHUFFLE(1, 0, 3, 2));
+				vector = _mm512_mask_blend_epi32(static_cast<__mmask16>(mask), _mm512_min_epi32(vector, partner), _mm512_max_epi32(vector, partner));
+			}
+		};
+
+		template <>
+		struct Avx512Ops<int64_t> {
+			using Vector = __m512i;
+			static constexpr int WIDTH = 8;
+
+			__attribute__((target("avx512f"))) static void load(Vector& vector, const int64_t* data) noexcept {
+				vector = _mm512_load_si512(data);
+			}
+			__attribute__((target("avx512f"))) static void store(int64_t* data, const Vector& vector) noexcept {
+				_mm512_store_si512(data, vector);
+			}
+			__attribute__((target("avx512f"))) static void compareExchange(Vector& first, Vector& second, bool descending) noexcept {
+				__m512i low = _mm512_min_epi64(first, second);
+				__m512i high = _mm512_max_epi64(first, second);
+				first = descending ? high : low;
+				second = descending ? low : high;
+			}
+			__attribute__((target("avx512f"))) static void exchangeLanes(Vector& vector, int distance, uint32_t mask) noexcept {
+				__m512i partner;
+				if (distance == 1)
+					partner = _mm512_shuffle_epi32(vector, static_cast<_MM_PERM_ENUM>(_MM_SHUFFLE(1, 0, 3, 2)));
+				else if (distance == 2)
+					partner = _mm512_shuffle_i64x2(vector, vector, _MM_SHUFFLE(2, 3, 0, 1));
+				else
+					partner = _mm512_shuffle_i64x2(vector, vector, _MM_SHUFFLE(1, 0, 3, 2));
+				vector = _mm512_mask_blend_epi64(static_cast<__mmask8>(mask), _mm512_min_epi64(vector, partner), _mm512_max_epi64(vector, partner));
+			}
+		};
+
+		//lanes of vector whose index has the bit set
+		constexpr uint32_t _getLanes(int bit, int width) noexcept {
+			uint32_t lanes = 0;
+			for (int lane = 0; lane < width; lane++) {
+				if (lane & bit)
+					lanes |= 1u << lane;
+			}
+			return lanes;
+		}
+
+		//bitonic sort of COUNT vectors: for every block size k and distance j elements i and i ^ j are compared,
+		//the one with lower index gets minimum if block i / k is sorted ascending. Distances not shorter than vector
+		//compare whole vectors, shorter distances compare lanes of one vector with its permutation
+		template <class Ops, int COUNT>
+		void _bitonicSort(typename Ops::Vector* vectors) noexcept {
+			constexpr int WIDTH = Ops::WIDTH;
+			constexpr uint32_t ALL = (1u << WIDTH) - 1;
+			for (int k = 2; k <= COUNT * WIDTH; k *= 2) {
+				for (int j = k / 2; j > 0; j /= 2) {
+					if constexpr (COUNT > 1) {
+						if (j >= WIDTH) {
+							int distance = j / WIDTH;
+							for (int i = 0; i < COUNT; i++) {
+								if ((i & distance) == 0)
+									Ops::compareExchange(vectors[i], vectors[i + distance], (i * WIDTH & k) != 0);
+							}
+							continue;
+						}
+					}
+
+					//lane keeps maximum if it's the upper one of the pair in ascending block or the lower one in descending block
+					uint32_t mask = _getLanes(j, WIDTH) ^ (k < WIDTH ? _getLanes(k, WIDTH) : 0);
+					for (int i = 0; i < COUNT; i++)
+						Ops::exchangeLanes(vectors[i], j, k >= WIDTH && (i * WIDTH & k) ? mask ^ ALL : mask);
+				}
+			}
+		}
+
+		//the tail of the last vector is filled by maximum, so it stays at the end
+		template <class Ops, int COUNT, class T>
+		void _sortVectors(T* data, int size) noexcept {
+			alignas(64) T buffer[COUNT * Ops::WIDTH];
+			std::copy(data, data + size, buffer);
+			std::fill(buffer + size, buffer + COUNT * Ops::WIDTH, std::numeric_limits<T>::max());
+
+			typename Ops::Vector vectors[COUNT];
+			for (int i = 0; i < COUNT; i++)
+				Ops::load(vectors[i], buffer + i * Ops::WIDTH);
+			_bitonicSort<Ops, COUNT>(vectors);
+			for (int i = 0; i < COUNT; i++)
+				Ops::store(buffer + i * Ops::WIDTH, vectors[i]);
+			std::copy(buffer, buffer + size, data);
+		}
+
+		//the smallest network which fits size
+		template <class Ops, int COUNT = 1, class T>
+		void _sortBySize(T* data, int size) noexcept {
+			if constexpr (COUNT * Ops::WIDTH < MAX_SIZE) {
+				if (size > COUNT * Ops::WIDTH) {
+					_sortBySize<Ops, COUNT * 2>(data, size);
+					return;
+				}
+			}
+			_sortVectors<Ops, COUNT>(data, size);
+		}
+
+		//flatten inlines the generic kernel together with Ops, so the whole network is compiled for the target
+		template <class T>
+		__attribute__((target("avx2"), flatten)) void _sortAvx2(T* data, int size) noexcept {
+			_sortBySize<Avx2Ops<T>>(data, size);
+		}
+
+		template <class T>
+		__attribute__((target("avx512f"), flatten)) void _sortAvx512(T* data, int size) noexcept {
+			_sortBySize<Avx512Ops<T>>(data, size);
+		}
+#endif
+
+		//insertion sort is the fastest scalar sort of such short arrays, NaN elements are kept
+		template <class T>
+		void _insertionSort(T* data, int size) noexcept {
+			for (int i = 1; i < size; i++) {
+				T element = data[i];
+				int j = i;
+				for (; j > 0 && element < data[j - 1]; j--)
+					data[j] = data[j - 1];
+				data[j] = element;
+			}
+		}
+
+		//float bits as signed integer with the same order: bits of negative numbers except sign are flipped.
+		//The mapping is its own inverse. Unlike float min/max it keeps -0.0 and 0.0 apart (-0.0 goes first)
+		inline int32_t _getFloatKey(int32_t bits) noexcept {
+			return bits ^ ((bits >> 31) & 0x7FFFFFFF);
+		}
+
+		//sorts up to MAX_SIZE elements in ascending order by sorting network of the widest instruction set supported
+		//by CPU and not wider than level, insertion sort without SIMD. Networks sort floats by integer keys, so every
+		//element is kept bit for bit: -0.0 goes before 0.0, NaN goes to the start or the end depending on its sign
+		template <NetworkSortable T>
+		ALGOGIN_ERROR sort(T* data, int size, Level level = Level::AVX512) noexcept {
+			if (size < 0 || size > MAX_SIZE)
+				return ALGOGIN_ERROR::OUT_OF_BOUNDS;
+
+			level = std::min(level, getLevel());
+#if defined(ALGOGIN_NETWORK_DISPATCH)
+			if (level != Level::SCALAR && size > 1) {
+				if constexpr (std::floating_point<T>) {
+					int32_t keys[MAX_SIZE];
+					for (int i = 0; i < size; i++)
+						keys[i] = _getFloatKey(std::bit_cast<int32_t>(data[i]));
+					sort(keys, size, level);
+					for (int i = 0; i < size; i++)
+						data[i] = std::bit_cast<float>(_getFloatKey(keys[i]));
+				}
+				else if (level == Level::AVX512) {
+					_sortAvx512(data, size);
+				}
+				else {
+					_sortAvx2(data, size);
+				}
+				return ALGOGIN_ERROR::OK;
+			}
+#endif
+			_insertionSort(data, size);
+			return ALGOGIN_ERROR::OK;
+		}
+	}
+}
@@ -0,0 +1,161 @@
+#pragma once
+#include "Common.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace algogin {
+	//Fork-join thread pool with work stealing: every worker has own deque, new tasks are pushed to the deque of
+	//the thread which creates them, owner takes the newest task (its data is still in cache), idle workers steal
+	//the oldest task of other deques (usually the biggest part of work). Thread waiting for a group of tasks
+	//executes tasks itself instead of blocking, so nested fork-join can't deadlock.
+	class ThreadPool {
+	public:
+		//set of tasks which can be waited for
+		class Group {
+		private:
+			friend class ThreadPool;
+			std::atomic<int> _pending = 0;
+		};
+	private:
+		struct Task {
+			std::function<void()> function;
+			Group* group = nullptr;
+		};
+
+		struct alignas(64) Queue {
+			std::mutex mutex;
+			std::deque<Task> tasks;
+		};
+
+		//one queue per worker and the last one for threads outside of pool
+		std::vector<std::unique_ptr<Queue>> _queues;
+		std::vector<std::thread> _workers;
+		std::atomic<int> _queued = 0;
+		std::atomic<bool> _stop = false;
+		std::mutex _sleepMutex;
+		std::condition_variable _wakeup;
+
+		static inline thread_local ThreadPool* _currentPool = nullptr;
+		static inline thread_local int _currentIndex = 0;
+
+		int _getIndex() const noexcept {
+			return _currentPool == this ? _currentIndex : static_cast<int>(_workers.size());
+		}
+
+		bool _take(int index, Task& task) {
+			{
+				auto& queue = *_queues[index];
+				std::lock_guard lock(queue.mutex);
+				if (queue.tasks.empty() == false) {
+					task = std::move(queue.tasks.back());
+					queue.tasks.pop_back();
+					return true;
+				}
+			}
+
+			for (int i = 1; i < _queues.size(); i++) {
+				auto& queue = *_queues[(index + i) % _queues.size()];
+				std::lock_guard lock(queue.mutex);
+				if (queue.tasks.empty() == false) {
+					task = std::move(queue.tasks.front());
+					queue.tasks.pop_front();
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		bool _runOne(int index) {
+			Task task;
+			if (_queued.load(std::memory_order_acquire) == 0 || _take(index, task) == false)
+				return false;
+
+			_queued.fetch_sub(1, std::memory_order_relaxed);
+			task.function();
+			task.group->_pending.fetch_sub(1, std::memory_order_release);
+			return true;
+		}
+
+		void _work(int index) {
+			_currentPool = this;
+			_currentIndex = index;
+			while (_stop.load(std::memory_order_relaxed) == false) {
+				if (_runOne(index))
+					continue;
+
+				std::unique_lock lock(_sleepMutex);
+				_wakeup.wait(lock, [this] { return _stop.load() || _queued.load() > 0; });
+			}
+		}
+	public:
+		//threads = 0 - number of hardware threads
+		ThreadPool(int threads = 0) {
+			if (threads <= 0)
+				threads = std::max(1u, std::thread::hardware_concurrency());
+
+			for (int i = 0; i <= threads; i++)
+				_queues.push_back(std::make_unique<Queue>());
+			for (int i = 0; i < threads; i++)
+				_workers.emplace_back([this, i] { _work(i); });
+		}
+
+		~ThreadPool() {
+			{
+				std::lock_guard lock(_sleepMutex);
+				_stop = true;
+			}
+			_wakeup.notify_all();
+			for (auto& worker : _workers)
+				worker.join();
+		}
+
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+
+		int getThreads() const noexcept {
+			return static_cast<int>(_workers.size());
+		}
+
+		//function must stay valid until wait(group) returns
+		template <class F>
+		void run(Group& group, F&& function) {
+			group._pending.fetch_add(1, std::memory_order_relaxed);
+			{
+				auto& queue = *_queues[_getIndex()];
+				std::lock_guard lock(queue.mutex);
+				queue.tasks.push_back({ std::forward<F>(function), &group });
+			}
+			_queued.fetch_add(1, std::memory_order_release);
+			//empty critical section orders the push with sleeping worker's check of _queued
+			{
+				std::lock_guard lock(_sleepMutex);
+			}
+			_wakeup.notify_one();
+		}
+
+		//executes queued tasks until all tasks of group are finished
+		void wait(Group& group) {
+			int index = _getIndex();
+			while (group._pending.load(std::memory_order_acquire) > 0) {
+				if (_runOne(index) == false)
+					std::this_thread::yield();
+			}
+		}
+
+		//runs both functions in parallel: the second one is offered to other workers, the first one runs in place
+		template <class F1, class F2>
+		void invoke(F1&& first, F2&& second) {
+			Group group;
+			run(group, std::forward<F2>(second));
+			first();
+			wait(group);
+		}
+	};
+}
@@ -0,0 +1,101 @@
+#include "MappedFile.h"
+#include <utility>
+#if defined(_WIN32)
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace algogin {
+	MappedFile::~MappedFile() {
+		close();
+	}
+
+	MappedFile::MappedFile(MappedFile&& file) noexcept {
+		*this = std::move(file);
+	}
+
+	MappedFile& MappedFile::operator=(MappedFile&& file) noexcept {
+		if (this != &file) {
+			close();
+			_data = std::exchange(file._data, nullptr);
+			_size = std::exchange(file._size, 0);
+#if defined(_WIN32)
+			_file = std::exchange(file._file, nullptr);
+			_mapping = std::exchange(file._mapping, nullptr);
+#else
+			_file = std::exchange(file._file, -1);
+#endif
+		}
+		return *this;
+	}
+
+	ALGOGIN_ERROR MappedFile::open(const std::filesystem::path& path) {
+		close();
+		if (std::filesystem::exists(path) == false)
+			return ALGOGIN_ERROR::NOT_FOUND;
+
+		_size = std::filesystem::file_size(path);
+		//empty file can't be mapped, but it's valid file
+		if (_size == 0)
+			return ALGOGIN_ERROR::OK;
+#if defined(_WIN32)
+		_file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (_file == INVALID_HANDLE_VALUE) {
+			_file = nullptr;
+			return ALGOGIN_ERROR::UNKNOWN_ERROR;
+		}
+		_mapping = CreateFileMappingW(_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (_mapping == nullptr) {
+			close();
+			return ALGOGIN_ERROR::UNKNOWN_ERROR;
+		}
+		_data = static_cast<const uint8_t*>(MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0));
+#else
+		_file = ::open(path.c_str(), O_RDONLY);
+		if (_file < 0)
+			return ALGOGIN_ERROR::UNKNOWN_ERROR;
+		void* data = mmap(nullptr, _size, PROT_READ, MAP_SHARED, _file, 0);
+		_data = data == MAP_FAILED ? nullptr : static_cast<const uint8_t*>(data);
+#endif
+		if (_data == nullptr) {
+			close();
+			return ALGOGIN_ERROR::UNKNOWN_ERROR;
+		}
+
+		return ALGOGIN_ERROR::OK;
+	}
+
+	void MappedFile::close() noexcept {
+#if defined(_WIN32)
+		if (_data)
+			UnmapViewOfFile(_data);
+		if (_mapping)
+			CloseHandle(_mapping);
+		if (_file)
+			CloseHandle(_file);
+		_mapping = nullptr;
+		_file = nullptr;
+#else
+		if (_data)
+			munmap(const_cast<uint8_t*>(_data), _size);
+		if (_file >= 0)
+			::close(_file);
+		_file = -1;
+#endif
+		_data = nullptr;
+		_size = 0;
+	}
+
+	const uint8_t* MappedFile::getData() const noexcept {
+		return _data;
+	}
+
+	size_t MappedFile::getSize() const noexcept {
+		return _size;
+	}
+}
@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+#include "Cache.h"
+#include <thread>
+
+TEST(Cache, LRU_Evict) {
+	algogin::Cache<int, int> cache({ .capacity = 3, .policy = algogin::CachePolicy::LRU, .shards = 1 });
+	cache.put(1, 10);
+	cache.put(2, 20);
+	cache.put(3, 30);
+	//1 becomes the most recently used, so 2 is evicted
+	ASSERT_EQ(cache.get(1).value(), 10);
+	ASSERT_EQ(cache.put(4, 40), algogin::ALGOGIN_ERROR::OK);
+
+	ASSERT_EQ(cache.getSize(), 3);
+	ASSERT_EQ(cache.get(2), std::nullopt);
+	ASSERT_EQ(cache.get(1).value(), 10);
+	ASSERT_EQ(cache.get(3).value(), 30);
+	ASSERT_EQ(cache.get(4).value(), 40);
+}
+
+TEST(Cache, LRU_Update) {
+	algogin::Cache<std::string, int> cache({ .capacity = 2, .policy = algogin::CachePolicy::LRU, .shards = 1 });
+	cache.put("a", 1);
+	cache.put("b", 2);
+	cache.put("a", 3);
+	cache.put("c", 4);
+
+	ASSERT_EQ(cache.get("a").value(), 3);
+	ASSERT_EQ(cache.get("b"), std::nullopt);
+	ASSERT_EQ(cache.remove("a"), algogin::ALGOGIN_ERROR::OK);
+	ASSERT_EQ(cache.remove("a"), algogin::ALGOGIN_ERROR::NOT_FOUND);
+	ASSERT_EQ(cache.getSize(), 1);
+}
+
+TEST(Cache, CLOCK_SecondChance) {
+	algogin::Cache<int, int> cache({ .capacity = 3, .policy = algogin::CachePolicy::CLOCK, .shards = 1 });
+	cache.put(1, 10);
+	cache.put(2, 20);
+	cache.put(3, 30);
+	//1 and 3 are referenced, 2 isn't, so 2 is evicted
+	cache.get(1);
+	cache.get(3);
+	cache.put(4, 40);
+
+	ASSERT_EQ(cache.get(2), std::nullopt);
+	ASSERT_EQ(cache.get(1).value(), 10);
+	ASSERT_EQ(cache.get(3).value(), 30);
+	ASSERT_EQ(cache.get(4).value(), 40);
+}
+
+TEST(Cache, TinyLFU_Admission) {
+	algogin::Cache<int, int> cache({ .capacity = 4, .policy = algogin::CachePolicy::TINY_LFU, .shards = 1 });
+	for (int i = 0; i < 4; i++) {
+		cache.put(i, i);
+		for (int j = 0; j < 5; j++)
+			cache.get(i);
+	}
+
+	//key which is seen for the first time is less popular than any entry in cache
+	ASSERT_EQ(cache.put(100, 100), algogin::ALGOGIN_ERROR::REJECTED);
+	ASSERT_EQ(cache.get(100), std::nullopt);
+	//popular key is admitted
+	for (int j = 0; j < 10; j++)
+		cache.get(200);
+	ASSERT_EQ(cache.put(200, 200), algogin::ALGOGIN_ERROR::OK);
+	ASSERT_EQ(cache.get(200).value(), 200);
+	ASSERT_EQ(cache.getSize(), 4);
+}
+
+TEST(Cache, TinyLFU_OneAccessPerRequest) {
+	algogin::Cache<int, int> cache({ .capacity = 1, .policy = algogin::CachePolicy::TINY_LFU, .shards = 1 });
+	//resident entry is accessed 3 times: put and 2 gets
+	ASSERT_EQ(cache.put(1, 10), algogin::ALGOGIN_ERROR::OK);
+	cache.get(1);
+	cache.get(1);
+
+	//put after missed get is the same request, so candidate gains 1 per attempt and wins only on the 4th one
+	for (int attempt = 1; attempt <= 4; attempt++) {
+		ASSERT_EQ(cache.get(2), std::nullopt);
+		ASSERT_EQ(cache.put(2, 20), attempt < 4 ? algogin::ALGOGIN_ERROR::REJECTED : algogin::ALGOGIN_ERROR::OK);
+	}
+	ASSERT_EQ(cache.get(2).value(), 20);
+	ASSERT_EQ(cache.get(1), std::nullopt);
+}
+
+TEST(Cache, Weight_ManyEntries) {
+	//index of weighted cache is sized for average weight 64 at first and grows with number of entries
+	algogin::Cache<int, int> cache({ .capacity = 12800, .shards = 2, .weigher = [](const int&, const int&) { return size_t(1); } });
+	for (int i = 0; i < 6400; i++)
+		ASSERT_EQ(cache.put(i, i * 3), algogin::ALGOGIN_ERROR::OK);
+	ASSERT_EQ(cache.getWeight(), 6400);
+	ASSERT_EQ(cache.getSize(), 6400);
+	for (int i = 0; i < 6400; i++)
+		ASSERT_EQ(cache.get(i).value(), i * 3);
+}
+
+TEST(Cache, Weight) {
+	algogin::Cache<int, std::string> cache({ .capacity = 10, .shards = 1, .weigher = [](const int&, const std::string& value) { return value.size(); } });
+	ASSERT_EQ(cache.put(1, "aaaa"), algogin::ALGOGIN_ERROR::OK);
+	ASSERT_EQ(cache.put(2, "bbbb"), algogin::ALGOGIN_ERROR::OK);
+	ASSERT_EQ(cache.getWeight(), 8);
+	ASSERT_EQ(cache.put(3, "ccccccccccc"), algogin::ALGOGIN_ERROR::REJECTED);
+	//both entries have to be evicted
+	ASSERT_EQ(cache.put(3, "cccccccc"), algogin::ALGOGIN_ERROR::OK);
+	ASSERT_EQ(cache.getWeight(), 8);
+	ASSERT_EQ(cache.get(1), std::nullopt);
+	ASSERT_EQ(cache.get(2), std::nullopt);
+	ASSERT_EQ(cache.get(3).value(), "cccccccc");
+}
+
+TEST(Cache, Weight_DefaultShards) {
+	auto weigher = [](const int&, const std::string& value) { return value.size(); };
+	//default number of shards keeps entry of capacity / 16
+	algogin::Cache<int, std::string> cache({ .capacity = 1600, .weigher = weigher });
+	for (int i = 0; i < 16; i++)
+		ASSERT_EQ(cache.put(i, std::string(100, 'a')), algogin::ALGOGIN_ERROR::OK);
+	ASSERT_EQ(cache.get(15).value().size(), 100);
+
+	algogin::Cache<int, std::string> heavy({ .capacity = 1600, .weigher = weigher, .maxWeight = 1000 });
+	ASSERT_EQ(heavy.put(1, std::string(1000, 'a')), algogin::ALGOGIN_ERROR::OK);
+	ASSERT_EQ(heavy.getWeight(), 1000);
+
+	//explicit number of shards limits weight of entry to capacity / shards
+	algogin::Cache<int, std::string> sharded({ .capacity = 1600, .shards = 16, .weigher = weigher });
+	ASSERT_EQ(sharded.put(1, std::string(100, 'a')), algogin::ALGOGIN_ERROR::OK);
+	ASSERT_EQ(sharded.put(2, std::string(101, 'a')), algogin::ALGOGIN_ERROR::REJECTED);
+}
+
+TEST(Cache, TTL) {
+	algogin::Cache<int, int> cache({ .capacity = 10, .shards = 1, .ttl = std::chrono::milliseconds(20) });
+	cache.put(1, 10);
+	ASSERT_EQ(cache.get(1).value(), 10);
+	std::this_thread::sleep_for(std::chrono::milliseconds(40));
+	ASSERT_EQ(cache.get(1), std::nullopt);
+	ASSERT_EQ(cache.getSize(), 0);
+}
+
+TEST(Cache, Threads) {
+	const int threadsNumber = 8;
+	algogin::Cache<int, int> cache({ .capacity = 1000, .policy = algogin::CachePolicy::CLOCK, .shards = 8 });
+	std::vector<std::thread> threads;
+	for (int t = 0; t < threadsNumber; t++) {
+		threads.emplace_back([&cache, t] {
+			for (int i = 0; i < 5000; i++) {
+				int key = (i * 31 + t) % 3000;
+				auto value = cache.get(key);
+				if (value)
+					ASSERT_EQ(value.value(), key * 2);
+				else
+					cache.put(key, key * 2);
+			}
+		});
+	}
+	for (auto& thread : threads)
+		thread.join();
+
+	ASSERT_LE(cache.getWeight(), 1000);
+	ASSERT_EQ(cache.getSize(), cache.getWeight());
+}
@@ -1,6 +1,9 @@
 #include <gtest/gtest.h>
 #include "Dictionary.h"
 #include <any>
+#include <thread>
+#include <random>
+#include <fstream>
 
 TEST(Dictionary, Move_constructor) {
 	algogin::Dictionary<int, int> d1;
@@ -1254,6 +1257,21 @@ TEST(HashTable, Remove_Simple_Int) {
 	ASSERT_EQ(hashTable.find(6), std::nullopt);
 }
 
+TEST(HashTable, Rehash) {
+	algogin::HashTable<int, int> hashTable(2);
+	for (int i = 0; i < 100; i++)
+		hashTable.insert(i, i * 2);
+
+	ASSERT_EQ(hashTable.rehash(0), algogin::ALGOGIN_ERROR::OUT_OF_BOUNDS);
+	ASSERT_EQ(hashTable.rehash(64), algogin::ALGOGIN_ERROR::OK);
+	ASSERT_EQ(hashTable.getBucketCount(), 64);
+	ASSERT_EQ(hashTable.getSize(), 100);
+	for (int i = 0; i < 100; i++)
+		ASSERT_EQ(std::get<1>(hashTable.find(i).value()), i * 2);
+	ASSERT_EQ(hashTable.remove(50), algogin::ALGOGIN_ERROR::OK);
+	ASSERT_EQ(hashTable.find(50), std::nullopt);
+}
+
 TEST(HashTable, Remove_Simple_String) {
 	algogin::HashTable<std::string, int> hashTable(5);
 	hashTable.insert("here", 2);
@@ -1274,4 +1292,605 @@ TEST(HashTable, Remove_Simple_String) {
 	ASSERT_EQ(hashTable.find("123"), std::nullopt);
 	hashTable.remove("here");
 	ASSERT_EQ(hashTable.find("here"), std::nullopt);
-}
\ No newline at end of file
+}
+TEST(HashTable, Find_StringView) {
+	algogin::HashTable<std::string, int> hashTable(5);
+	hashTable.insert("here", 2);
+	hashTable.insert("we are", 3);
+	hashTable.insert("windows", 3);
+
+	std::string_view key = "we are";
+	ASSERT_EQ(std::get<0>(hashTable.find(key).value()), "we are");
+	ASSERT_EQ(std::get<1>(hashTable.find(key).value()), 3);
+	ASSERT_EQ(hashTable.find(std::string_view("nothing")), std::nullopt);
+	ASSERT_EQ(hashTable.remove(std::string_view("here")), algogin::ALGOGIN_ERROR::OK);
+	ASSERT_EQ(hashTable.find(std::string_view("here")), std::nullopt);
+}
+
+TEST(HashTable, Insert_Big_Int) {
+	algogin::HashTable<int64_t, int> hashTable(7);
+	//float based hashing mapped such keys to the same bucket
+	for (int64_t i = 0; i < 100; i++)
+		hashTable.insert((1ll << 40) + i * (1ll << 32), i);
+
+	for (int64_t i = 0; i < 100; i++)
+		ASSERT_EQ(std::get<1>(hashTable.find((1ll << 40) + i * (1ll << 32)).value()), i);
+	ASSERT_EQ(hashTable.find(1), std::nullopt);
+}
+
+TEST(HashTable, Insert_Struct) {
+	struct Point {
+		int x;
+		int y;
+		bool operator==(const Point&) const = default;
+	};
+
+	algogin::HashTable<Point, int> hashTable(5);
+	hashTable.insert({ 1, 2 }, 12);
+	hashTable.insert({ 2, 1 }, 21);
+	hashTable.insert({ -1, 0 }, -10);
+
+	ASSERT_EQ(std::get<1>(hashTable.find({ 1, 2 }).value()), 12);
+	ASSERT_EQ(std::get<1>(hashTable.find({ 2, 1 }).value()), 21);
+	ASSERT_EQ(std::get<1>(hashTable.find({ -1, 0 }).value()), -10);
+	ASSERT_EQ(hashTable.find({ 0, 0 }), std::nullopt);
+}
+
+TEST(HashTable, Custom_Hasher) {
+	struct ModuloHash {
+		uint64_t operator()(int key) const noexcept {
+			return key;
+		}
+	};
+
+	algogin::HashTable<int, int, ModuloHash> hashTable(3);
+	hashTable.insert(1, 10);
+	hashTable.insert(4, 40);
+	hashTable.insert(7, 70);
+
+	ASSERT_EQ(std::get<1>(hashTable.find(4).value()), 40);
+	ASSERT_EQ(hashTable.remove(4), algogin::ALGOGIN_ERROR::OK);
+	ASSERT_EQ(hashTable.find(4), std::nullopt);
+	ASSERT_EQ(std::get<1>(hashTable.find(7).value()), 70);
+}
+
+TEST(HashTable, Empty_Table) {
+	algogin::HashTable<int, int> hashTable;
+	ASSERT_EQ(hashTable.insert(1, 1), algogin::ALGOGIN_ERROR::UNKNOWN_ERROR);
+	ASSERT_EQ(hashTable.find(1), std::nullopt);
+}
+
+TEST(HashTable, InsertOrAssign) {
+	algogin::HashTable<int, int> hashTable(5);
+	hashTable.insertOrAssign(1, 10);
+	hashTable.insertOrAssign(2, 20);
+	hashTable.insertOrAssign(1, 11);
+	ASSERT_EQ(hashTable.getSize(), 2);
+	ASSERT_EQ(std::get<1>(hashTable.find(1).value()), 11);
+	ASSERT_EQ(std::get<1>(hashTable.find(2).value()), 20);
+	hashTable.remove(1);
+	ASSERT_EQ(hashTable.getSize(), 1);
+}
+
+TEST(ConcurrentHashTable, Insert_Simple) {
+	algogin::ConcurrentHashTable<std::string, int> hashTable(16, 4);
+	hashTable.insert("here", 2);
+	hashTable.insert("we are", 3);
+	hashTable.insertOrAssign("here", 4);
+
+	ASSERT_EQ(hashTable.getSize(), 2);
+	ASSERT_EQ(std::get<1>(hashTable.find("here").value()), 4);
+	ASSERT_EQ(std::get<1>(hashTable.find(std::string_view("we are")).value()), 3);
+	ASSERT_EQ(hashTable.remove("here"), algogin::ALGOGIN_ERROR::OK);
+	ASSERT_EQ(hashTable.find("here"), std::nullopt);
+}
+
+TEST(ConcurrentHashTable, Grow) {
+	struct ModuloHash {
+		uint64_t operator()(int key) const noexcept {
+			return key;
+		}
+	};
+
+	//small integers with identity hasher are spread over shards, shards grow with number of elements
+	algogin::ConcurrentHashTable<int, int, ModuloHash> hashTable(4, 4);
+	ASSERT_EQ(hashTable.getBucketCount(), 4);
+	for (int i = 0; i < 20000; i++)
+		ASSERT_EQ(hashTable.insert(i, -i), algogin::ALGOGIN_ERROR::OK);
+	ASSERT_EQ(hashTable.getSize(), 20000);
+	ASSERT_GE(hashTable.getBucketCount(), 20000 / 2);
+	for (int i = 0; i < 20000; i++)
+		ASSERT_EQ(std::get<1>(hashTable.find(i).value()), -i);
+	ASSERT_EQ(hashTable.find(20000), std::nullopt);
+}
+
+TEST(ConcurrentHashTable, Insert_Threads) {
+	const int threadsNumber = 8;
+	const int keysPerThread = 2000;
+	algogin::ConcurrentHashTable<int, int> hashTable(1024);
+	std::vector<std::thread> threads;
+	for (int t = 0; t < threadsNumber; t++) {
+		threads.emplace_back([&hashTable, t] {
+			for (int i = 0; i < keysPerThread; i++) {
+				int key = t * keysPerThread + i;
+				hashTable.insertOrAssign(key, key);
+				//every thread also writes to the same keys
+				hashTable.insertOrAssign(-(i % 100) - 1, t);
+			}
+		});
+	}
+	for (auto& thread : threads)
+		thread.join();
+
+	ASSERT_EQ(hashTable.getSize(), threadsNumber * keysPerThread + 100);
+	for (int i = 0; i < threadsNumber * keysPerThread; i++)
+		ASSERT_EQ(std::get<1>(hashTable.find(i).value()), i);
+}
+
+TEST(ConcurrentHashTable, Remove_Threads) {
+	const int threadsNumber = 8;
+	const int keys = 8000;
+	algogin::ConcurrentHashTable<int, int> hashTable(1024);
+	for (int i = 0; i < keys; i++)
+		hashTable.insert(i, i);
+
+	std::vector<std::thread> threads;
+	for (int t = 0; t < threadsNumber; t++) {
+		threads.emplace_back([&hashTable, t] {
+			//remove odd keys, read even keys concurrently
+			for (int i = t; i < keys; i += threadsNumber) {
+				if (i % 2)
+					hashTable.remove(i);
+				else
+					ASSERT_EQ(std::get<1>(hashTable.find(i).value()), i);
+			}
+		});
+	}
+	for (auto& thread : threads)
+		thread.join();
+
+	ASSERT_EQ(hashTable.getSize(), keys / 2);
+	for (int i = 0; i < keys; i++)
+		ASSERT_EQ(hashTable.find(i).has_value(), i % 2 == 0);
+}
+
+TEST(LockFreeHashTable, Insert_Simple) {
+	algogin::LockFreeHashTable<std::string, int> hashTable;
+	ASSERT_EQ(hashTable.insert("here", 2), algogin::ALGOGIN_ERROR::OK);
+	ASSERT_EQ(hashTable.insert("we are", 3), algogin::ALGOGIN_ERROR::OK);
+	ASSERT_EQ(hashTable.insert("here", 4), algogin::ALGOGIN_ERROR::WRONG_KEY);
+
+	ASSERT_EQ(hashTable.getSize(), 2);
+	ASSERT_EQ(std::get<1>(hashTable.find("here").value()), 2);
+	ASSERT_EQ(std::get<1>(hashTable.find(std::string_view("we are")).value()), 3);
+	ASSERT_EQ(hashTable.find("nothing"), std::nullopt);
+	ASSERT_EQ(hashTable.remove("here"), algogin::ALGOGIN_ERROR::OK);
+	ASSERT_EQ(hashTable.remove("here"), algogin::ALGOGIN_ERROR::NOT_FOUND);
+	ASSERT_EQ(hashTable.find("here"), std::nullopt);
+	ASSERT_EQ(hashTable.getSize(), 1);
+}
+
+TEST(LockFreeHashTable, Resize) {
+	algogin::LockFreeHashTable<int, int> hashTable;
+	for (int i = 0; i < 10000; i++)
+		hashTable.insert(i, i * 2);
+
+	ASSERT_GE(hashTable.getBucketCount(), 10000 / 2);
+	for (int i = 0; i < 10000; i++)
+		ASSERT_EQ(std::get<1>(hashTable.find(i).value()), i * 2);
+	for (int i = 0; i < 10000; i += 2)
+		ASSERT_EQ(hashTable.remove(i), algogin::ALGOGIN_ERROR::OK);
+	for (int i = 0; i < 10000; i++)
+		ASSERT_EQ(hashTable.find(i).has_value(), i % 2 == 1);
+}
+
+TEST(LockFreeHashTable, Collisions) {
+	struct ConstantHash {
+		uint64_t operator()(int key) const noexcept {
+			return 42;
+		}
+	};
+
+	algogin::LockFreeHashTable<int, int, ConstantHash> hashTable;
+	for (int i = 0; i < 100; i++)
+		hashTable.insert(i, i);
+	ASSERT_EQ(hashTable.insert(50, 0), algogin::ALGOGIN_ERROR::WRONG_KEY);
+	ASSERT_EQ(hashTable.remove(50), algogin::ALGOGIN_ERROR::OK);
+	for (int i = 0; i < 100; i++)
+		ASSERT_EQ(hashTable.find(i).has_value(), i != 50);
+}
+
+TEST(LockFreeHashTable, Stress_Threads) {
+	const int threadsNumber = 8;
+	const int keysPerThread = 2000;
+	algogin::LockFreeHashTable<int, int> hashTable;
+	std::vector<std::thread> threads;
+	std::atomic<int> sharedInserted = 0;
+	for (int t = 0; t < threadsNumber; t++) {
+		threads.emplace_back([&, t] {
+			std::mt19937 generator(t);
+			//own keys: insert all, remove every third, check state
+			for (int i = 0; i < keysPerThread; i++)
+				ASSERT_EQ(hashTable.insert(t * keysPerThread + i, i), algogin::ALGOGIN_ERROR::OK);
+			for (int i = 0; i < keysPerThread; i += 3)
+				ASSERT_EQ(hashTable.remove(t * keysPerThread + i), algogin::ALGOGIN_ERROR::OK);
+			//shared keys: all threads fight for the same small range
+			for (int i = 0; i < keysPerThread; i++) {
+				int key = -1 - static_cast<int>(generator() % 64);
+				if (generator() % 2) {
+					if (hashTable.insert(key, t) == algogin::ALGOGIN_ERROR::OK)
+						sharedInserted++;
+				}
+				else if (hashTable.remove(key) == algogin::ALGOGIN_ERROR::OK)
+					sharedInserted--;
+			}
+			for (int i = 0; i < keysPerThread; i++)
+				ASSERT_EQ(hashTable.find(t * keysPerThread + i).has_value(), i % 3 != 0);
+		});
+	}
+	for (auto& thread : threads)
+		thread.join();
+
+	int shared = 0;
+	for (int key = -64; key < 0; key++)
+		shared += hashTable.find(key).has_value();
+	ASSERT_EQ(shared, sharedInserted.load());
+	ASSERT_EQ(hashTable.getSize(), threadsNumber * (keysPerThread - (keysPerThread + 2) / 3) + shared);
+}
+
+TEST(CuckooHashTable, Insert_Simple) {
+	algogin::CuckooHashTable<std::string, int> hashTable;
+	ASSERT_EQ(hashTable.insert("here", 2), algogin::ALGOGIN_ERROR::OK);
+	ASSERT_EQ(hashTable.insert("we are", 3), algogin::ALGOGIN_ERROR::OK);
+	ASSERT_EQ(hashTable.insert("here", 4), algogin::ALGOGIN_ERROR::WRONG_KEY);
+	hashTable.insertOrAssign("we are", 5);
+
+	ASSERT_EQ(hashTable.getSize(), 2);
+	ASSERT_EQ(std::get<1>(hashTable.find("here").value()), 2);
+	ASSERT_EQ(std::get<1>(hashTable.find(std::string_view("we are")).value()), 5);
+	ASSERT_EQ(hashTable.find("nothing"), std::nullopt);
+	ASSERT_EQ(hashTable.remove("here"), algogin::ALGOGIN_ERROR::OK);
+	ASSERT_EQ(hashTable.remove("here"), algogin::ALGOGIN_ERROR::NOT_FOUND);
+	ASSERT_EQ(hashTable.getSize(), 1);
+}
+
+TEST(CuckooHashTable, Grow) {
+	algogin::CuckooHashTable<int, int> hashTable(8);
+	int buckets = hashTable.getBucketCount();
+	for (int i = 0; i < 100000; i++)
+		ASSERT_EQ(hashTable.insert(i, -i), algogin::ALGOGIN_ERROR::OK);
+
+	ASSERT_GT(hashTable.getBucketCount(), buckets);
+	ASSERT_EQ(hashTable.getSize(), 100000);
+	for (int i = 0; i < 100000; i++)
+		ASSERT_EQ(std::get<1>(hashTable.find(i).value()), -i);
+	for (int i = 0; i < 100000; i += 2)
+		ASSERT_EQ(hashTable.remove(i), algogin::ALGOGIN_ERROR::OK);
+	for (int i = 0; i < 100000; i++)
+		ASSERT_EQ(hashTable.find(i).has_value(), i % 2 == 1);
+}
+
+TEST(CuckooHashTable, Stash) {
+	struct ConstantHash {
+		uint64_t operator()(int key) const noexcept {
+			return 42;
+		}
+	};
+
+	//all keys share the same 2 buckets with any seed: 8 elements fit into buckets, 8 go to stash, the rest is rejected
+	algogin::CuckooHashTable<int, int, ConstantHash> hashTable(64);
+	for (int i = 0; i < 16; i++)
+		ASSERT_EQ(hashTable.insert(i, i), algogin::ALGOGIN_ERROR::OK);
+	for (int i = 16; i < 20; i++)
+		ASSERT_EQ(hashTable.insert(i, i), algogin::ALGOGIN_ERROR::REJECTED);
+
+	ASSERT_EQ(hashTable.getSize(), 16);
+	ASSERT_EQ(hashTable.getStashSize(), 8);
+	for (int i = 0; i < 20; i++)
+		ASSERT_EQ(hashTable.find(i).has_value(), i < 16);
+	for (int i = 0; i < 16; i++)
+		ASSERT_EQ(std::get<1>(hashTable.find(i).value()), i);
+	//removal from bucket moves one element from stash to bucket
+	ASSERT_EQ(hashTable.remove(0), algogin::ALGOGIN_ERROR::OK);
+	ASSERT_EQ(hashTable.getStashSize(), 7);
+	ASSERT_EQ(hashTable.remove(15), algogin::ALGOGIN_ERROR::OK);
+	ASSERT_EQ(hashTable.insert(16, 16), algogin::ALGOGIN_ERROR::OK);
+	for (int i = 0; i < 20; i++)
+		ASSERT_EQ(hashTable.find(i).has_value(), i != 0 && i != 15 && i < 17);
+}
+
+TEST(CuckooHashTable, Stash_Rehash) {
+	struct ModuloHash {
+		uint64_t operator()(int key) const noexcept {
+			return key;
+		}
+	};
+
+	//keys which differ only in high bits share buckets of raw hash, stash stays capped and table is rehashed
+	//with seed instead of filling stash while table is almost empty
+	algogin::CuckooHashTable<int, int, ModuloHash> hashTable(1000);
+	int buckets = hashTable.getBucketCount();
+	for (int i = 0; i < 200; i++) {
+		ASSERT_EQ(hashTable.insert(i << 20, i), algogin::ALGOGIN_ERROR::OK);
+		ASSERT_LE(hashTable.getStashSize(), 8);
+	}
+	ASSERT_EQ(hashTable.getBucketCount(), buckets);
+	for (int i = 0; i < 200; i++)
+		ASSERT_EQ(std::get<1>(hashTable.find(i << 20).value()), i);
+	ASSERT_EQ(hashTable.find(1), std::nullopt);
+}
+
+TEST(PerfectHashTable, Build_Simple) {
+	std::vector<std::pair<std::string, int>> input = { {"here", 2}, {"we are", 3}, {"windows", 4}, {"friends", 5} };
+	algogin::PerfectHashTable<std::string, int> table;
+	ASSERT_EQ(table.build(input), algogin::ALGOGIN_ERROR::OK);
+
+	ASSERT_EQ(table.getSize(), 4);
+	ASSERT_EQ(table.find("here").value(), 2);
+	ASSERT_EQ(table.find(std::string_view("we are")).value(), 3);
+	ASSERT_EQ(table.find("windows").value(), 4);
+	ASSERT_EQ(table.find("friends").value(), 5);
+	ASSERT_EQ(table.find("nothing"), std::nullopt);
+}
+
+TEST(PerfectHashTable, Build_Duplicate) {
+	std::vector<std::tuple<int, int>> input = { {1, 2}, {3, 4}, {1, 5} };
+	algogin::PerfectHashTable<int, int> table;
+	ASSERT_EQ(table.build(input), algogin::ALGOGIN_ERROR::WRONG_KEY);
+	ASSERT_EQ(table.getSize(), 0);
+	ASSERT_EQ(table.find(1), std::nullopt);
+}
+
+TEST(PerfectHashTable, Build_HashCollision) {
+	struct ModuloHash {
+		uint64_t operator()(int key) const noexcept {
+			return key % 1000;
+		}
+	};
+
+	//no seed separates different keys with the same hash, build has to stop
+	std::vector<std::pair<int, int>> input = { {1, 2}, {5, 3}, {1001, 4} };
+	algogin::PerfectHashTable<int, int, ModuloHash> table;
+	ASSERT_EQ(table.build(input), algogin::ALGOGIN_ERROR::REJECTED);
+	ASSERT_EQ(table.getSize(), 0);
+	ASSERT_EQ(table.find(1), std::nullopt);
+
+	input.pop_back();
+	ASSERT_EQ(table.build(input), algogin::ALGOGIN_ERROR::OK);
+	ASSERT_EQ(table.find(5).value(), 3);
+}
+
+TEST(PerfectHashTable, Build_Big) {
+	std::vector<std::pair<int, int>> input;
+	for (int i = 0; i < 100000; i++)
+		input.push_back({ i * 3, i });
+
+	algogin::PerfectHashTable<int, int> table;
+	ASSERT_EQ(table.build(input), algogin::ALGOGIN_ERROR::OK);
+	for (int i = 0; i < 100000; i++) {
+		ASSERT_EQ(table.find(i * 3).value(), i);
+		ASSERT_EQ(table.find(i * 3 + 1), std::nullopt);
+	}
+	ASSERT_LT(table.getMetadataBits(), 4.0);
+}
+
+TEST(PerfectHashTable, DumpLoad) {
+	std::vector<std::pair<int64_t, double>> input;
+	for (int i = 0; i < 10000; i++)
+		input.push_back({ i * 7ll, i / 2.0 });
+
+	algogin::PerfectHashTable<int64_t, double> table;
+	ASSERT_EQ(table.build(input), algogin::ALGOGIN_ERROR::OK);
+	auto tmp = std::filesystem::current_path() / "temp";
+	std::filesystem::create_directory(tmp);
+	ASSERT_EQ(table.dump(tmp / "perfect.bin"), algogin::ALGOGIN_ERROR::OK);
+
+	algogin::PerfectHashTable<int64_t, double> loaded;
+	ASSERT_EQ(loaded.load(tmp / "perfect.bin"), algogin::ALGOGIN_ERROR::OK);
+	ASSERT_EQ(loaded.getSize(), 10000);
+	for (int i = 0; i < 10000; i++) {
+		ASSERT_EQ(loaded.find(i * 7ll).value(), i / 2.0);
+		ASSERT_EQ(loaded.find(i * 7ll + 1), std::nullopt);
+	}
+
+	//the file has different value type
+	algogin::PerfectHashTable<int64_t, int> wrong;
+	ASSERT_EQ(wrong.load(tmp / "perfect.bin"), algogin::ALGOGIN_ERROR::UNKNOWN_ERROR);
+	ASSERT_EQ(wrong.load(tmp / "nothing.bin"), algogin::ALGOGIN_ERROR::NOT_FOUND);
+	std::filesystem::remove(tmp / "perfect.bin");
+}
+
+//overwrites 8 bytes of file at offset, used to corrupt headers of dumps
+static void patchFile(const std::filesystem::path& path, size_t offset, uint64_t value) {
+	std::fstream file{ path, std::ios::binary | std::ios::in | std::ios::out };
+	file.seekp(offset);
+	file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+TEST(PerfectHashTable, Load_Corrupted) {
+	std::vector<std::pair<int, int>> input;
+	for (int i = 0; i < 1000; i++)
+		input.push_back({ i, i * 2 });
+	algogin::PerfectHashTable<int, int> table;
+	ASSERT_EQ(table.build(input), algogin::ALGOGIN_ERROR::OK);
+	auto tmp = std::filesystem::current_path() / "temp";
+	std::filesystem::create_directory(tmp);
+	auto path = tmp / "perfect.bin";
+
+	//header: size at 32, tableSize at 40, bucketCount at 48, pilotsOffset at 56, pilotsWords at 64, freeOffset at 72,
+	//keysOffset at 80, valuesOffset at 88; values overflow size computations or point outside of file
+	std::vector<std::pair<size_t, uint64_t>> corruptions = {
+		{ 32, 2000 }, { 32, UINT64_MAX / 2 }, { 40, 999 }, { 40, UINT64_MAX }, { 48, UINT64_MAX / 4 }, { 48, 1ull << 40 },
+		{ 56, 0 }, { 56, UINT64_MAX - 63 }, { 64, UINT64_MAX / 8 + 2 }, { 72, 1ull << 40 }, { 80, 64 }, { 88, UINT64_MAX - 63 }
+	};
+	for (auto [offset, value] : corruptions) {
+		ASSERT_EQ(table.dump(path), algogin::ALGOGIN_ERROR::OK);
+		patchFile(path, offset, value);
+		algogin::PerfectHashTable<int, int> loaded;
+		ASSERT_EQ(loaded.load(path), algogin::ALGOGIN_ERROR::UNKNOWN_ERROR);
+		ASSERT_EQ(loaded.getSize(), 0);
+	}
+
+	//remap table pointing beyond keys
+	ASSERT_EQ(table.dump(path), algogin::ALGOGIN_ERROR::OK);
+	uint64_t freeOffset;
+	{
+		std::ifstream file{ path, std::ios::binary };
+		file.seekg(72);
+		file.read(reinterpret_cast<char*>(&freeOffset), sizeof(freeOffset));
+	}
+	patchFile(path, freeOffset, UINT32_MAX);
+	algogin::PerfectHashTable<int, int> loaded;
+	ASSERT_EQ(loaded.load(path), algogin::ALGOGIN_ERROR::UNKNOWN_ERROR);
+
+	ASSERT_EQ(table.dump(path), algogin::ALGOGIN_ERROR::OK);
+	ASSERT_EQ(loaded.load(path), algogin::ALGOGIN_ERROR::OK);
+	ASSERT_EQ(loaded.find(999).value(), 1998);
+	std::filesystem::remove(path);
+}
+
+TEST(Dictionary, FindBatch) {
+	algogin::Dictionary<int, int> dictionary;
+	for (int i = 0; i < 1000; i++)
+		dictionary.insert(i * 2, i);
+
+	std::vector<int> keys;
+	for (int i = 0; i < 100; i++)
+		keys.push_back(i * 7);
+	std::vector<std::optional<int>> values(keys.size());
+	ASSERT_EQ(dictionary.findBatch(keys, values), algogin::ALGOGIN_ERROR::OK);
+	for (int i = 0; i < keys.size(); i++) {
+		if (keys[i] % 2 == 0)
+			ASSERT_EQ(values[i].value(), keys[i] / 2);
+		else
+			ASSERT_EQ(values[i], std::nullopt);
+	}
+
+	std::vector<std::optional<int>> wrong(1);
+	ASSERT_EQ(dictionary.findBatch(keys, wrong), algogin::ALGOGIN_ERROR::OUT_OF_BOUNDS);
+}
+
+TEST(Dictionary, FindBatch_Empty) {
+	algogin::Dictionary<int, int> dictionary;
+	std::vector<int> keys = { 1, 2, 3 };
+	std::vector<std::optional<int>> values(keys.size(), 0);
+	ASSERT_EQ(dictionary.findBatch(keys, values), algogin::ALGOGIN_ERROR::OK);
+	for (auto& value : values)
+		ASSERT_EQ(value, std::nullopt);
+}
+
+TEST(HashTable, FindBatch) {
+	algogin::HashTable<std::string, int> hashTable(5);
+	hashTable.insert("here", 2);
+	hashTable.insert("we are", 3);
+	hashTable.insert("windows", 3);
+	hashTable.insert("friends", 4);
+
+	std::vector<std::string> keys = { "friends", "nothing", "here", "we are", "windows", "here" };
+	std::vector<std::optional<int>> values(keys.size());
+	ASSERT_EQ(hashTable.findBatch(keys, values), algogin::ALGOGIN_ERROR::OK);
+	ASSERT_EQ(values[0].value(), 4);
+	ASSERT_EQ(values[1], std::nullopt);
+	ASSERT_EQ(values[2].value(), 2);
+	ASSERT_EQ(values[3].value(), 3);
+	ASSERT_EQ(values[4].value(), 3);
+	ASSERT_EQ(values[5].value(), 2);
+}
+
+TEST(HashTable, FindBatch_Big) {
+	algogin::HashTable<int, int> hashTable(100);
+	for (int i = 0; i < 1000; i++)
+		hashTable.insert(i, -i);
+
+	std::vector<int> keys;
+	for (int i = 0; i < 2000; i += 3)
+		keys.push_back(i);
+	std::vector<std::optional<int>> values(keys.size());
+	ASSERT_EQ(hashTable.findBatch(keys, values), algogin::ALGOGIN_ERROR::OK);
+	for (int i = 0; i < keys.size(); i++)
+		ASSERT_EQ(values[i].has_value(), keys[i] < 1000);
+}
+
+TEST(HashTable, Snapshot_View) {
+	algogin::HashTable<int64_t, double> table(1000);
+	for (int i = 0; i < 5000; i++)
+		table.insert(i * 3ll, i / 4.0);
+
+	auto tmp = std::filesystem::current_path() / "temp";
+	std::filesystem::create_directory(tmp);
+	ASSERT_EQ(table.dump(tmp / "table.bin"), algogin::ALGOGIN_ERROR::OK);
+
+	algogin::HashTableView<int64_t, double> view;
+	ASSERT_EQ(view.find(0), std::nullopt);
+	ASSERT_EQ(view.open(tmp / "table.bin"), algogin::ALGOGIN_ERROR::OK);
+	ASSERT_EQ(view.getSize(), 5000);
+	ASSERT_EQ(view.getBucketCount(), 1000);
+	for (int i = 0; i < 5000; i++) {
+		ASSERT_EQ(view.find(i * 3ll).value(), i / 4.0);
+		ASSERT_EQ(view.find(i * 3ll + 1), std::nullopt);
+	}
+	std::filesystem::remove(tmp / "table.bin");
+}
+
+TEST(HashTable, Snapshot_Load) {
+	struct ModuloHash {
+		uint64_t operator()(int key) const noexcept {
+			return key;
+		}
+	};
+
+	algogin::HashTable<int, int> table(64);
+	for (int i = 0; i < 1000; i++)
+		table.insert(i, -i);
+	table.remove(10);
+
+	auto tmp = std::filesystem::current_path() / "temp";
+	std::filesystem::create_directory(tmp);
+	ASSERT_EQ(table.dump(tmp / "table.bin"), algogin::ALGOGIN_ERROR::OK);
+
+	algogin::HashTable<int, int> loaded;
+	ASSERT_EQ(loaded.load(tmp / "table.bin"), algogin::ALGOGIN_ERROR::OK);
+	ASSERT_EQ(loaded.getSize(), 999);
+	ASSERT_EQ(loaded.find(10), std::nullopt);
+	for (int i = 11; i < 1000; i++)
+		ASSERT_EQ(std::get<1>(loaded.find(i).value()), -i);
+	//loaded table is modifiable
+	ASSERT_EQ(loaded.insert(10, 100), algogin::ALGOGIN_ERROR::OK);
+	ASSERT_EQ(std::get<1>(loaded.find(10).value()), 100);
+
+	//another value type, another hasher and missing file
+	algogin::HashTable<int, int64_t> wrongType;
+	ASSERT_EQ(wrongType.load(tmp / "table.bin"), algogin::ALGOGIN_ERROR::UNKNOWN_ERROR);
+	algogin::HashTableView<int, int, ModuloHash> wrongHasher;
+	ASSERT_EQ(wrongHasher.open(tmp / "table.bin"), algogin::ALGOGIN_ERROR::UNKNOWN_ERROR);
+	algogin::HashTableView<int, int> missing;
+	ASSERT_EQ(missing.open(tmp / "nothing.bin"), algogin::ALGOGIN_ERROR::NOT_FOUND);
+	std::filesystem::remove(tmp / "table.bin");
+}
+
+TEST(HashTable, Snapshot_Corrupted) {
+	algogin::HashTable<int, int> table(64);
+	for (int i = 0; i < 1000; i++)
+		table.insert(i, -i);
+	auto tmp = std::filesystem::current_path() / "temp";
+	std::filesystem::create_directory(tmp);
+	auto path = tmp / "table.bin";
+
+	//header: size at 24, bucketCount at 32, offsetsOffset at 40, keysOffset at 48, valuesOffset at 56, bucket offsets
+	//start at 64; values overflow size computations, point outside of file or make bucket offsets decrease
+	std::vector<std::pair<size_t, uint64_t>> corruptions = {
+		{ 24, 2000 }, { 24, UINT64_MAX / 4 }, { 32, UINT64_MAX }, { 32, UINT64_MAX / 8 }, { 32, 1ull << 40 }, { 40, 0 },
+		{ 48, UINT64_MAX - 63 }, { 56, 64 }, { 64, 1 }, { 72, 1000 }
+	};
+	for (auto [offset, value] : corruptions) {
+		ASSERT_EQ(table.dump(path), algogin::ALGOGIN_ERROR::OK);
+		patchFile(path, offset, value);
+		algogin::HashTable<int, int> loaded;
+		ASSERT_EQ(loaded.load(path), algogin::ALGOGIN_ERROR::UNKNOWN_ERROR);
+		ASSERT_EQ(loaded.getSize(), 0);
+		algogin::HashTableView<int, int> view;
+		ASSERT_EQ(view.open(path), algogin::ALGOGIN_ERROR::UNKNOWN_ERROR);
+		ASSERT_EQ(view.find(1), std::nullopt);
+	}
+	std::filesystem::remove(path);
+}
@@ -0,0 +1,186 @@
+#include <gtest/gtest.h>
+#include "Filter.h"
+#include <filesystem>
+#include <fstream>
+
+TEST(BloomFilter, Insert_Simple) {
+	algogin::BloomFilter<int> filter(100);
+	ASSERT_EQ(filter.contains(1), false);
+	for (int i = 0; i < 100; i++)
+		ASSERT_EQ(filter.insert(i), algogin::ALGOGIN_ERROR::OK);
+
+	for (int i = 0; i < 100; i++)
+		ASSERT_EQ(filter.contains(i), true);
+	ASSERT_GE(filter.getBits(), 1000);
+}
+
+TEST(BloomFilter, FalsePositive) {
+	algogin::BloomFilter<int> filter(100000);
+	for (int i = 0; i < 100000; i++)
+		filter.insert(i);
+
+	int falsePositive = 0;
+	for (int i = 100000; i < 200000; i++)
+		falsePositive += filter.contains(i);
+	//about 1% for 10 bits per key
+	ASSERT_LT(falsePositive, 2500);
+}
+
+TEST(BloomFilter, String_View) {
+	algogin::BloomFilter<std::string> filter(10);
+	filter.insert("first");
+	filter.insert("second");
+	ASSERT_EQ(filter.contains(std::string_view("first")), true);
+	ASSERT_EQ(filter.contains("second"), true);
+}
+
+TEST(BloomFilter, Build_Parallel) {
+	std::vector<int> keys;
+	for (int i = 0; i < 100000; i++)
+		keys.push_back(i * 3);
+
+	algogin::BloomFilter<int> sequential(keys.size());
+	for (auto key : keys)
+		sequential.insert(key);
+	algogin::BloomFilter<int> parallel(keys.size());
+	ASSERT_EQ(parallel.build(keys, 4), algogin::ALGOGIN_ERROR::OK);
+
+	for (int i = 0; i < 300000; i++)
+		ASSERT_EQ(parallel.contains(i), sequential.contains(i));
+}
+
+TEST(BloomFilter, DumpLoad) {
+	algogin::BloomFilter<int> filter(1000);
+	for (int i = 0; i < 1000; i++)
+		filter.insert(i);
+
+	auto tmp = std::filesystem::current_path() / "temp";
+	std::filesystem::create_directory(tmp);
+	ASSERT_EQ(filter.dump(tmp / "bloom.bin"), algogin::ALGOGIN_ERROR::OK);
+
+	algogin::BloomFilter<int> loaded;
+	ASSERT_EQ(loaded.load(tmp / "bloom.bin"), algogin::ALGOGIN_ERROR::OK);
+	ASSERT_EQ(loaded.getBits(), filter.getBits());
+	for (int i = 0; i < 2000; i++)
+		ASSERT_EQ(loaded.contains(i), filter.contains(i));
+
+	//the file has another filter type
+	algogin::CuckooFilter<int> wrong;
+	ASSERT_EQ(wrong.load(tmp / "bloom.bin"), algogin::ALGOGIN_ERROR::UNKNOWN_ERROR);
+	ASSERT_EQ(loaded.load(tmp / "nothing.bin"), algogin::ALGOGIN_ERROR::NOT_FOUND);
+	std::filesystem::remove(tmp / "bloom.bin");
+}
+
+TEST(BloomFilter, Levels) {
+	algogin::BloomFilter<int> filter(10000);
+	for (int i = 0; i < 10000; i++)
+		filter.insert(i * 7);
+
+	//every kernel supported by CPU gives the same answers as scalar loop
+	algogin::BloomFilter<int> scalar = filter;
+	scalar.setLevel(algogin::filter::Level::SCALAR);
+	ASSERT_EQ(scalar.getLevel(), algogin::filter::Level::SCALAR);
+	for (auto level : { algogin::filter::Level::SCALAR, algogin::filter::Level::AVX2 }) {
+		filter.setLevel(level);
+		ASSERT_LE(filter.getLevel(), level);
+		for (int i = 0; i < 70000; i++)
+			ASSERT_EQ(filter.contains(i), scalar.contains(i));
+	}
+}
+
+TEST(BloomFilter, Load_Corrupted) {
+	auto tmp = std::filesystem::current_path() / "temp";
+	std::filesystem::create_directory(tmp);
+	auto write = [&tmp](uint64_t size, int blocks) {
+		algogin::filter::Header header = { algogin::filter::MAGIC, algogin::filter::VERSION, 1, size, 0 };
+		std::ofstream file{ tmp / "bloom.bin", std::ios::binary };
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		std::vector<char> data(blocks * 32, 0);
+		file.write(data.data(), data.size());
+	};
+
+	algogin::BloomFilter<int> filter(100);
+	filter.insert(5);
+	//size * block size overflows to size of file
+	write((1ull << 59) + 1, 1);
+	ASSERT_EQ(filter.load(tmp / "bloom.bin"), algogin::ALGOGIN_ERROR::UNKNOWN_ERROR);
+	//filter without blocks
+	write(0, 0);
+	ASSERT_EQ(filter.load(tmp / "bloom.bin"), algogin::ALGOGIN_ERROR::UNKNOWN_ERROR);
+	ASSERT_EQ(filter.contains(5), true);
+	std::filesystem::remove(tmp / "bloom.bin");
+}
+
+TEST(CuckooFilter, Insert_Remove) {
+	algogin::CuckooFilter<int> filter(1000);
+	for (int i = 0; i < 1000; i++)
+		ASSERT_EQ(filter.insert(i), algogin::ALGOGIN_ERROR::OK);
+	ASSERT_EQ(filter.getSize(), 1000);
+	for (int i = 0; i < 1000; i++)
+		ASSERT_EQ(filter.contains(i), true);
+
+	for (int i = 0; i < 1000; i += 2)
+		ASSERT_EQ(filter.remove(i), algogin::ALGOGIN_ERROR::OK);
+	ASSERT_EQ(filter.getSize(), 500);
+	for (int i = 1; i < 1000; i += 2)
+		ASSERT_EQ(filter.contains(i), true);
+
+	int falsePositive = 0;
+	for (int i = 0; i < 1000; i += 2)
+		falsePositive += filter.contains(i);
+	ASSERT_LT(falsePositive, 5);
+}
+
+TEST(CuckooFilter, Duplicates) {
+	algogin::CuckooFilter<int> filter(100);
+	//the same key can be inserted several times and has to be removed the same number of times
+	filter.insert(5);
+	filter.insert(5);
+	ASSERT_EQ(filter.remove(5), algogin::ALGOGIN_ERROR::OK);
+	ASSERT_EQ(filter.contains(5), true);
+	ASSERT_EQ(filter.remove(5), algogin::ALGOGIN_ERROR::OK);
+	ASSERT_EQ(filter.contains(5), false);
+	ASSERT_EQ(filter.remove(5), algogin::ALGOGIN_ERROR::NOT_FOUND);
+}
+
+TEST(CuckooFilter, Full) {
+	algogin::CuckooFilter<int> filter(1000);
+	int inserted = 0;
+	while (filter.insert(inserted) == algogin::ALGOGIN_ERROR::OK)
+		inserted++;
+
+	//capacity is 512 buckets * 4 slots
+	ASSERT_GE(inserted, 2048 * 9 / 10);
+	//no false negatives even for full filter
+	for (int i = 0; i < inserted; i++)
+		ASSERT_EQ(filter.contains(i), true);
+
+	//free slot allows to insert again
+	ASSERT_EQ(filter.remove(0), algogin::ALGOGIN_ERROR::OK);
+	ASSERT_EQ(filter.insert(inserted), algogin::ALGOGIN_ERROR::OK);
+	for (int i = 1; i <= inserted; i++)
+		ASSERT_EQ(filter.contains(i), true);
+}
+
+TEST(CuckooFilter, Build_DumpLoad) {
+	std::vector<std::string> keys;
+	for (int i = 0; i < 50000; i++)
+		keys.push_back(std::to_string(i));
+
+	algogin::CuckooFilter<std::string> filter(keys.size());
+	ASSERT_EQ(filter.build(keys, 4), algogin::ALGOGIN_ERROR::OK);
+	ASSERT_EQ(filter.getSize(), 50000);
+
+	auto tmp = std::filesystem::current_path() / "temp";
+	std::filesystem::create_directory(tmp);
+	ASSERT_EQ(filter.dump(tmp / "cuckoo.bin"), algogin::ALGOGIN_ERROR::OK);
+
+	algogin::CuckooFilter<std::string> loaded;
+	ASSERT_EQ(loaded.load(tmp / "cuckoo.bin"), algogin::ALGOGIN_ERROR::OK);
+	ASSERT_EQ(loaded.getSize(), 50000);
+	for (auto& key : keys)
+		ASSERT_EQ(loaded.contains(std::string_view(key)), true);
+	ASSERT_EQ(loaded.remove(keys[0]), algogin::ALGOGIN_ERROR::OK);
+	ASSERT_EQ(loaded.getSize(), 49999);
+	std::filesystem::remove(tmp / "cuckoo.bin");
+}
@@ -0,0 +1,44 @@
+#include <gtest/gtest.h>
+#include "Hash.h"
+#include <set>
+
+TEST(Hash, Integer_Distribution) {
+	algogin::Hash<uint64_t> hash;
+	//sequential keys should spread over all buckets
+	std::vector<int> buckets(16);
+	for (uint64_t i = 0; i < 1600; i++)
+		buckets[hash(i) % buckets.size()]++;
+
+	for (auto count : buckets) {
+		ASSERT_GT(count, 50);
+		ASSERT_LT(count, 150);
+	}
+}
+
+TEST(Hash, String_Equal) {
+	algogin::Hash<std::string> hash;
+	std::string key = "some long key which doesn't fit into short path of hashing function";
+	ASSERT_EQ(hash(key), hash(std::string_view(key)));
+	ASSERT_EQ(hash("abc"), hash(std::string("abc")));
+	ASSERT_NE(hash("abc"), hash("abd"));
+	ASSERT_NE(hash(""), hash(std::string_view("\0", 1)));
+}
+
+TEST(Hash, String_AllLengths) {
+	algogin::Hash<std::string> hash;
+	std::set<uint64_t> hashes;
+	std::string key;
+	//every prefix has own hash (covers all tail cases of bytes hashing)
+	for (int i = 0; i < 200; i++) {
+		hashes.insert(hash(key));
+		key.push_back('a');
+	}
+
+	ASSERT_EQ(hashes.size(), 200);
+}
+
+TEST(Hash, Float_Zero) {
+	algogin::Hash<double> hash;
+	ASSERT_EQ(hash(0.0), hash(-0.0));
+	ASSERT_NE(hash(1.0), hash(-1.0));
+}
@@ -1,5 +1,12 @@
 #include <gtest/gtest.h>
 #include "Queue.h"
+#include <random>
+#include <set>
+#include <algorithm>
+#include <string>
+#include <memory>
+#include <thread>
+#include <filesystem>
 
 TEST(PrioriryQueue, CopyConstructor) {
 	algogin::PriorityQueue<int, int> queue;
@@ -140,3 +147,760 @@ TEST(PrioriryQueue, Remove_Simple) {
 	ASSERT_EQ(queue.getMinimum(), std::nullopt);
 }
 
+TEST(PrioriryQueue, DecreaseKey) {
+	algogin::PriorityQueue<int, int> queue;
+	queue.insert(30, 130);
+	auto handle = queue.insert(50, 150);
+	queue.insert(20, 120);
+
+	ASSERT_EQ(queue.decreaseKey(handle, 10), algogin::ALGOGIN_ERROR::OK);
+	ASSERT_EQ(queue.decreaseKey(handle, 40), algogin::ALGOGIN_ERROR::REJECTED);
+	ASSERT_EQ(queue.getMinimum().value(), std::make_tuple(10, 150));
+	ASSERT_EQ(queue.contains(handle), false);
+	ASSERT_EQ(queue.decreaseKey(handle, 5), algogin::ALGOGIN_ERROR::NOT_FOUND);
+	ASSERT_EQ(queue.getMinimum().value(), std::make_tuple(20, 120));
+	ASSERT_EQ(queue.getMinimum().value(), std::make_tuple(30, 130));
+}
+
+TEST(PrioriryQueue, Update_Erase) {
+	algogin::PriorityQueue<int, int> queue;
+	std::vector<algogin::PriorityQueue<int, int>::Handle> handles;
+	for (int i = 0; i < 10; i++)
+		handles.push_back(queue.insert(i, 100 + i));
+
+	ASSERT_EQ(queue.update(handles[0], 100), algogin::ALGOGIN_ERROR::OK);
+	ASSERT_EQ(queue.update(handles[9], -1), algogin::ALGOGIN_ERROR::OK);
+	ASSERT_EQ(queue.erase(handles[5]), algogin::ALGOGIN_ERROR::OK);
+	ASSERT_EQ(queue.erase(handles[5]), algogin::ALGOGIN_ERROR::NOT_FOUND);
+	ASSERT_EQ(queue.getSize(), 9);
+
+	//slot of erased element is reused, but old handle stays invalid
+	auto handle = queue.insert(5, 200);
+	ASSERT_EQ(handle.id, handles[5].id);
+	ASSERT_EQ(queue.contains(handles[5]), false);
+	ASSERT_EQ(queue.contains(handle), true);
+
+	std::vector<int> values;
+	while (auto minimum = queue.getMinimum())
+		values.push_back(std::get<1>(minimum.value()));
+	ASSERT_EQ(values, std::vector<int>({ 109, 101, 102, 103, 104, 200, 106, 107, 108, 100 }));
+}
+
+TEST(PrioriryQueue, Handles_Random) {
+	std::mt19937 generator(7);
+	algogin::PriorityQueue<int, int> queue;
+	std::set<std::pair<int, int>> reference;
+	std::vector<std::pair<algogin::PriorityQueue<int, int>::Handle, int>> alive;
+	std::vector<int> priorities;
+	for (int step = 0; step < 20000; step++) {
+		int operation = generator() % 5;
+		if (operation <= 1 || alive.empty()) {
+			int priority = generator() % 1000;
+			int value = static_cast<int>(priorities.size());
+			priorities.push_back(priority);
+			alive.push_back({ queue.insert(priority, value), value });
+			reference.insert({ priority, value });
+		}
+		else {
+			int index = generator() % alive.size();
+			auto [handle, value] = alive[index];
+			if (operation == 2) {
+				int priority = generator() % 1000;
+				ASSERT_EQ(queue.update(handle, priority), algogin::ALGOGIN_ERROR::OK);
+				reference.erase({ priorities[value], value });
+				priorities[value] = priority;
+				reference.insert({ priority, value });
+			}
+			else if (operation == 3) {
+				ASSERT_EQ(queue.erase(handle), algogin::ALGOGIN_ERROR::OK);
+				reference.erase({ priorities[value], value });
+				alive[index] = alive.back();
+				alive.pop_back();
+			}
+			else {
+				auto [priority, minimum] = queue.getMinimum().value();
+				ASSERT_EQ(priority, reference.begin()->first);
+				reference.erase({ priority, minimum });
+				auto found = std::find_if(alive.begin(), alive.end(), [minimum](auto& item) { return item.second == minimum; });
+				ASSERT_EQ(queue.contains(found->first), false);
+				*found = alive.back();
+				alive.pop_back();
+			}
+		}
+		ASSERT_EQ(queue.getSize(), reference.size());
+	}
+}
+
+template <class Queue>
+static void checkHeapSort(int number) {
+	std::mt19937 generator(3);
+	Queue queue;
+	std::vector<int> expected;
+	for (int i = 0; i < number; i++) {
+		int priority = generator() % 10000;
+		queue.insert(priority, -priority);
+		expected.push_back(priority);
+	}
+	std::sort(expected.begin(), expected.end());
+
+	for (int i = 0; i < number; i++) {
+		auto [priority, value] = queue.getMinimum().value();
+		ASSERT_EQ(priority, expected[i]);
+		ASSERT_EQ(value, -priority);
+	}
+	ASSERT_EQ(queue.getMinimum(), std::nullopt);
+}
+
+TEST(PrioriryQueue, Arity) {
+	checkHeapSort<algogin::PriorityQueue<int, int, 3>>(5000);
+	checkHeapSort<algogin::PriorityQueue<int, int, 4>>(5000);
+	checkHeapSort<algogin::PriorityQueue<int, int, 8>>(5000);
+	checkHeapSort<algogin::PriorityQueue<int, int, 4, algogin::HeapLayout::SPLIT>>(5000);
+	checkHeapSort<algogin::PriorityQueue<int, int, 8, algogin::HeapLayout::SPLIT>>(5000);
+	checkHeapSort<algogin::PriorityQueue<float, int, 4, algogin::HeapLayout::SPLIT>>(5000);
+	checkHeapSort<algogin::PriorityQueue<float, int, 8, algogin::HeapLayout::SPLIT>>(5000);
+}
+
+TEST(PrioriryQueue, Split_Handles) {
+	algogin::PriorityQueue<double, std::string, 4, algogin::HeapLayout::SPLIT> queue;
+	std::vector<algogin::PriorityQueue<double, std::string, 4, algogin::HeapLayout::SPLIT>::Handle> handles;
+	for (int i = 0; i < 20; i++)
+		handles.push_back(queue.insert(i, std::to_string(i)));
+
+	ASSERT_EQ(queue.decreaseKey(handles[15], -1), algogin::ALGOGIN_ERROR::OK);
+	ASSERT_EQ(queue.update(handles[0], 100), algogin::ALGOGIN_ERROR::OK);
+	ASSERT_EQ(queue.erase(handles[1]), algogin::ALGOGIN_ERROR::OK);
+	ASSERT_EQ(queue.getMinimum().value(), std::make_tuple(-1.0, std::string("15")));
+	ASSERT_EQ(queue.getMinimum().value(), std::make_tuple(2.0, std::string("2")));
+	ASSERT_EQ(queue.getSize(), 17);
+}
+
+TEST(PrioriryQueue, FindMinimum) {
+	float floats[8] = { 5, 3, 7, 3, 9, 1, 1, 8 };
+	ASSERT_EQ(algogin::queue::findMinimum<4>(floats), 1);
+	ASSERT_EQ(algogin::queue::findMinimum<8>(floats), 5);
+	int32_t ints[8] = { -5, 3, -7, 3, 9, -7, 1, -8 };
+	ASSERT_EQ(algogin::queue::findMinimum<4>(ints), 2);
+	ASSERT_EQ(algogin::queue::findMinimum<8>(ints), 7);
+	int64_t longs[4] = { 4, 3, 2, 2 };
+	ASSERT_EQ(algogin::queue::findMinimum<4>(longs), 2);
+}
+
+TEST(PrioriryQueue, FindMinimum_Levels) {
+	std::mt19937 generator(7);
+	//small range gives many equal priorities
+	std::uniform_int_distribution<int32_t> distribution(-4, 4);
+	auto scalar = [](const auto* priorities, int arity) {
+		int minimum = 0;
+		for (int i = 1; i < arity; i++)
+			minimum = priorities[i] < priorities[minimum] ? i : minimum;
+		return minimum;
+	};
+	using algogin::queue::Level;
+	for (auto level : { Level::SCALAR, Level::SSE2, Level::AVX2 }) {
+		for (int attempt = 0; attempt < 1000; attempt++) {
+			int32_t ints[8];
+			float floats[8];
+			for (int i = 0; i < 8; i++) {
+				ints[i] = distribution(generator);
+				floats[i] = static_cast<float>(distribution(generator));
+			}
+			if (attempt % 10 == 0)
+				floats[attempt % 8] = std::numeric_limits<float>::quiet_NaN();
+			ASSERT_EQ(algogin::queue::findMinimum<4>(ints, level), scalar(ints, 4));
+			ASSERT_EQ(algogin::queue::findMinimum<8>(ints, level), scalar(ints, 8));
+			ASSERT_EQ(algogin::queue::findMinimum<4>(floats, level), scalar(floats, 4));
+			ASSERT_EQ(algogin::queue::findMinimum<8>(floats, level), scalar(floats, 8));
+		}
+	}
+}
+
+TEST(PrioriryQueue, FindAbove_Levels) {
+	std::mt19937 generator(11);
+	std::uniform_int_distribution<int32_t> distribution(-100, 100);
+	std::vector<int32_t> ints(101);
+	std::vector<float> floats(101);
+	for (int i = 0; i < 101; i++) {
+		ints[i] = distribution(generator);
+		floats[i] = static_cast<float>(distribution(generator));
+	}
+	std::vector<uint32_t> expectedInts, expectedFloats;
+	for (uint32_t i = 0; i < 101; i++) {
+		if (ints[i] > 10)
+			expectedInts.push_back(i);
+		if (floats[i] > 10)
+			expectedFloats.push_back(i);
+	}
+	using algogin::queue::Level;
+	for (auto level : { Level::SCALAR, Level::SSE2, Level::AVX2 }) {
+		std::vector<uint32_t> indexes(101);
+		indexes.resize(algogin::queue::findAbove(ints.data(), ints.size(), 10, indexes.data(), level));
+		ASSERT_EQ(indexes, expectedInts);
+		indexes.resize(101);
+		indexes.resize(algogin::queue::findAbove(floats.data(), floats.size(), 10.0f, indexes.data(), level));
+		ASSERT_EQ(indexes, expectedFloats);
+	}
+}
+
+struct CountedPriority {
+	int priority;
+	static inline int comparisons = 0;
+
+	bool operator<(const CountedPriority& other) const {
+		comparisons++;
+		return priority < other.priority;
+	}
+
+	bool operator>(const CountedPriority& other) const {
+		comparisons++;
+		return priority > other.priority;
+	}
+};
+
+TEST(PrioriryQueue, Heapify) {
+	std::mt19937 generator(5);
+	std::vector<std::pair<CountedPriority, int>> input;
+	for (int i = 0; i < 1 << 16; i++) {
+		int priority = generator() % 100000;
+		input.push_back({ { priority }, priority });
+	}
+
+	CountedPriority::comparisons = 0;
+	algogin::PriorityQueue<CountedPriority, int> queue(input);
+	//Floyd's heapify does less than 2 comparisons per element
+	ASSERT_LT(CountedPriority::comparisons, 2 * input.size());
+	ASSERT_EQ(queue.getSize(), input.size());
+
+	std::sort(input.begin(), input.end(), [](auto& left, auto& right) { return left.second < right.second; });
+	for (auto& [priority, value] : input)
+		ASSERT_EQ(std::get<1>(queue.getMinimum().value()), value);
+}
+
+TEST(PrioriryQueue, InsertBulk) {
+	algogin::PriorityQueue<int, int, 4> queue;
+	queue.insert(50, 500);
+	//more elements than in queue: heapify, less: sift-up one by one
+	std::vector<std::tuple<int, int>> big = { { 40, 400 }, { 10, 100 }, { 70, 700 } };
+	auto handles = queue.insertBulk(big);
+	ASSERT_EQ(handles.size(), 3);
+	std::vector<std::tuple<int, int>> small = { { 5, 50 } };
+	auto handles2 = queue.insertBulk(std::move(small));
+	ASSERT_EQ(queue.getSize(), 5);
+
+	ASSERT_EQ(queue.decreaseKey(handles[2], 1), algogin::ALGOGIN_ERROR::OK);
+	ASSERT_EQ(queue.erase(handles2[0]), algogin::ALGOGIN_ERROR::OK);
+	std::vector<int> values;
+	int value;
+	while (queue.popInto(value) == algogin::ALGOGIN_ERROR::OK)
+		values.push_back(value);
+	ASSERT_EQ(values, std::vector<int>({ 700, 100, 400, 500 }));
+
+	std::vector<std::pair<int, int>> empty;
+	algogin::PriorityQueue<int, int, 4> emptyQueue(empty);
+	ASSERT_EQ(emptyQueue.insertBulk(empty).size(), 0);
+	ASSERT_EQ(emptyQueue.getSize(), 0);
+}
+
+TEST(PrioriryQueue, Emplace_Top_PopInto) {
+	algogin::PriorityQueue<int, std::unique_ptr<std::string>> queue;
+	ASSERT_EQ(queue.top(), std::nullopt);
+	queue.emplace(3, std::make_unique<std::string>("three"));
+	queue.emplace(1, new std::string("one"));
+	queue.insert(2, std::make_unique<std::string>("two"));
+
+	auto [topPriority, topValue] = queue.top().value();
+	ASSERT_EQ(topPriority, 1);
+	ASSERT_EQ(*topValue, "one");
+	ASSERT_EQ(queue.getSize(), 3);
+
+	int priority;
+	std::unique_ptr<std::string> value;
+	ASSERT_EQ(queue.popInto(priority, value), algogin::ALGOGIN_ERROR::OK);
+	ASSERT_EQ(priority, 1);
+	ASSERT_EQ(*value, "one");
+	ASSERT_EQ(*std::get<1>(queue.getMinimum().value()), "two");
+	ASSERT_EQ(queue.popInto(priority, value), algogin::ALGOGIN_ERROR::OK);
+	ASSERT_EQ(*value, "three");
+	ASSERT_EQ(queue.popInto(priority, value), algogin::ALGOGIN_ERROR::NOT_FOUND);
+}
+
+TEST(MultiQueue, Insert_Simple) {
+	algogin::MultiQueue<int, int> queue(2, 2, 4);
+	auto worker = queue.getWorker(1);
+	for (int i = 0; i < 1000; i++)
+		worker.insert(i, -i);
+	ASSERT_EQ(queue.getSize(), 1000);
+
+	std::vector<int> values;
+	while (auto minimum = worker.getMinimum()) {
+		ASSERT_EQ(std::get<1>(minimum.value()), -std::get<0>(minimum.value()));
+		values.push_back(std::get<0>(minimum.value()));
+	}
+	ASSERT_EQ(queue.getSize(), 0);
+	ASSERT_EQ(values.size(), 1000);
+	//order is relaxed, but beginning of output has to consist of small elements
+	ASSERT_LT(*std::max_element(values.begin(), values.begin() + 10), 100);
+	std::sort(values.begin(), values.end());
+	for (int i = 0; i < 1000; i++)
+		ASSERT_EQ(values[i], i);
+}
+
+TEST(MultiQueue, Flush) {
+	algogin::MultiQueue<int, int> queue(1, 1, 16);
+	{
+		auto worker = queue.getWorker(1);
+		worker.insert(5, 50);
+		worker.insert(3, 30);
+		//buffered elements are returned to heaps when worker is destroyed
+	}
+	auto worker = queue.getWorker(2);
+	ASSERT_EQ(worker.getMinimum().value(), std::make_tuple(3, 30));
+	ASSERT_EQ(worker.getMinimum().value(), std::make_tuple(5, 50));
+	ASSERT_EQ(worker.getMinimum(), std::nullopt);
+}
+
+TEST(MultiQueue, Threads) {
+	const int threads = 4;
+	const int number = 20000;
+	algogin::MultiQueue<int, int> queue(threads);
+	std::vector<std::vector<int>> popped(threads);
+	std::vector<std::thread> workers;
+	for (int t = 0; t < threads; t++) {
+		workers.emplace_back([&, t] {
+			auto worker = queue.getWorker(t);
+			for (int i = 0; i < number; i++) {
+				worker.insert(t * number + i, t);
+				//mix inserts and deletes
+				if (i % 3 == 0) {
+					auto minimum = worker.getMinimum();
+					if (minimum)
+						popped[t].push_back(std::get<0>(minimum.value()));
+				}
+			}
+		});
+	}
+	for (auto& worker : workers)
+		worker.join();
+
+	auto worker = queue.getWorker(threads);
+	std::vector<int> all;
+	while (auto minimum = worker.getMinimum())
+		all.push_back(std::get<0>(minimum.value()));
+	for (auto& part : popped)
+		all.insert(all.end(), part.begin(), part.end());
+
+	//every element is returned exactly once
+	std::sort(all.begin(), all.end());
+	ASSERT_EQ(all.size(), threads * number);
+	for (int i = 0; i < threads * number; i++)
+		ASSERT_EQ(all[i], i);
+}
+
+template <class Queue>
+static void checkMonotone(Queue queue) {
+	std::mt19937 generator(11);
+	std::multiset<uint32_t> reference;
+	for (int i = 0; i < 10000; i++) {
+		uint32_t priority = generator() % 5000;
+		queue.insert(priority, priority * 2);
+		reference.insert(priority);
+	}
+
+	//Dijkstra-like: extracted minimum produces new elements with bigger priorities
+	for (int i = 0; i < 50000; i++) {
+		auto [priority, value] = queue.getMinimum().value();
+		ASSERT_EQ(priority, *reference.begin());
+		ASSERT_EQ(value, priority * 2);
+		reference.erase(reference.begin());
+		for (int j = 0; j < 1 + i % 2; j++) {
+			uint32_t next = priority + generator() % 100;
+			queue.insert(next, next * 2);
+			reference.insert(next);
+		}
+		ASSERT_EQ(queue.getSize(), reference.size());
+	}
+}
+
+TEST(RadixHeap, Monotone) {
+	checkMonotone(algogin::RadixHeap<uint32_t, uint32_t>());
+	static_assert(std::is_same_v<algogin::MonotonePriorityQueue<uint64_t, int>, algogin::RadixHeap<uint64_t, int>>);
+	static_assert(std::is_same_v<algogin::MonotonePriorityQueue<int, int>, algogin::PriorityQueue<int, int>>);
+}
+
+TEST(RadixHeap, Handles) {
+	algogin::RadixHeap<uint32_t, int> queue;
+	auto first = queue.insert(100, 1);
+	auto second = queue.insert(200, 2);
+	queue.insert(300, 3);
+	ASSERT_EQ(queue.decreaseKey(second, 50), algogin::ALGOGIN_ERROR::OK);
+	ASSERT_EQ(queue.decreaseKey(first, 150), algogin::ALGOGIN_ERROR::REJECTED);
+	ASSERT_EQ(std::get<0>(queue.top().value()), 50);
+	ASSERT_EQ(queue.getMinimum().value(), std::make_tuple(50u, 2));
+
+	//priorities below the last minimum are rejected
+	ASSERT_EQ(queue.contains(queue.insert(10, 0)), false);
+	ASSERT_EQ(queue.update(first, 40), algogin::ALGOGIN_ERROR::REJECTED);
+	ASSERT_EQ(queue.update(first, 400), algogin::ALGOGIN_ERROR::OK);
+	ASSERT_EQ(queue.erase(second), algogin::ALGOGIN_ERROR::NOT_FOUND);
+
+	int value;
+	ASSERT_EQ(queue.popInto(value), algogin::ALGOGIN_ERROR::OK);
+	ASSERT_EQ(value, 3);
+	ASSERT_EQ(queue.erase(first), algogin::ALGOGIN_ERROR::OK);
+	ASSERT_EQ(queue.getMinimum(), std::nullopt);
+}
+
+TEST(BucketQueue, Monotone) {
+	checkMonotone(algogin::BucketQueue<uint32_t, uint32_t>(5000));
+}
+
+TEST(BucketQueue, Window) {
+	algogin::BucketQueue<int, std::string> queue(10);
+	ASSERT_EQ(queue.contains(queue.insert(11, "far")), false);
+	auto handle = queue.insert(7, "seven");
+	queue.insert(3, "three");
+	queue.insert(3, "three again");
+	ASSERT_EQ(queue.decreaseKey(handle, 1), algogin::ALGOGIN_ERROR::OK);
+	ASSERT_EQ(std::get<1>(queue.getMinimum().value()), "seven");
+	ASSERT_EQ(std::get<0>(queue.getMinimum().value()), 3);
+	//window moved to [3, 13]
+	ASSERT_EQ(queue.contains(queue.insert(13, "thirteen")), true);
+	ASSERT_EQ(queue.contains(queue.insert(2, "two")), false);
+	ASSERT_EQ(queue.getSize(), 2);
+
+	auto moved = std::move(queue);
+	ASSERT_EQ(queue.getSize(), 0);
+	ASSERT_EQ(queue.getMinimum(), std::nullopt);
+	ASSERT_EQ(std::get<0>(moved.getMinimum().value()), 3);
+	ASSERT_EQ(std::get<0>(moved.getMinimum().value()), 13);
+}
+
+TEST(TimerWheel, Expire) {
+	algogin::TimerWheel<int> wheel(100);
+	wheel.schedule(105, 1);
+	wheel.schedule(103, 2);
+	wheel.schedule(103, 3);
+	wheel.schedule(50, 4);
+	auto handle = wheel.schedule(104, 5);
+	ASSERT_EQ(wheel.cancel(handle), algogin::ALGOGIN_ERROR::OK);
+	ASSERT_EQ(wheel.cancel(handle), algogin::ALGOGIN_ERROR::NOT_FOUND);
+	ASSERT_EQ(wheel.getSize(), 4);
+
+	std::vector<std::pair<uint64_t, int>> fired;
+	auto callback = [&](uint64_t expiration, int value) { fired.push_back({ wheel.getTime(), value }); };
+	//timer in the past fires on the next tick
+	ASSERT_EQ(wheel.advance(101, callback), 1);
+	ASSERT_EQ(wheel.advance(104, callback), 2);
+	ASSERT_EQ(wheel.advance(110, callback), 1);
+	std::sort(fired.begin() + 1, fired.begin() + 3);
+	ASSERT_EQ(fired, (std::vector<std::pair<uint64_t, int>>{ { 101, 4 }, { 103, 2 }, { 103, 3 }, { 105, 1 } }));
+	ASSERT_EQ(wheel.getSize(), 0);
+	ASSERT_EQ(wheel.getTime(), 110);
+}
+
+template <class Wheel>
+void testCascade() {
+	Wheel wheel;
+	std::mt19937_64 generator(3);
+	std::vector<std::pair<typename Wheel::Handle, uint64_t>> timers;
+	//timers on all levels, including ones far in the future
+	for (int i = 0; i < 20000; i++) {
+		uint64_t expiration = 1 + generator() % (1ull << (4 + i % 40));
+		timers.push_back({ wheel.schedule(expiration, expiration), expiration });
+	}
+	std::vector<uint64_t> expected;
+	for (int i = 0; i < timers.size(); i++) {
+		if (i % 3 == 0)
+			ASSERT_EQ(wheel.cancel(timers[i].first), algogin::ALGOGIN_ERROR::OK);
+		else
+			expected.push_back(timers[i].second);
+	}
+	std::sort(expected.begin(), expected.end());
+
+	//every timer fires exactly at its tick, time is advanced by irregular steps
+	std::vector<uint64_t> fired;
+	uint64_t now = 0;
+	while (wheel.getSize() > 0) {
+		now += 1 + generator() % (1ull << (generator() % 44));
+		wheel.advance(now, [&](uint64_t expiration, uint64_t value) {
+			ASSERT_EQ(expiration, value);
+			ASSERT_EQ(wheel.getTime(), expiration);
+			fired.push_back(expiration);
+		});
+	}
+	ASSERT_EQ(fired, expected);
+}
+
+TEST(TimerWheel, Cascade) {
+	testCascade<algogin::TimerWheel<uint64_t>>();
+	//the last level covers bits above 64
+	testCascade<algogin::TimerWheel<uint64_t, 11, 6>>();
+	testCascade<algogin::TimerWheel<uint64_t, 4, 16>>();
+}
+
+TEST(TimerWheel, Reschedule) {
+	//callback schedules next timer, like periodic task
+	algogin::TimerWheel<int> wheel;
+	wheel.schedule(10, 0);
+	int count = 0;
+	wheel.advance(1000, [&](uint64_t expiration, int value) {
+		count++;
+		wheel.schedule(expiration + 10, value + 1);
+	});
+	ASSERT_EQ(count, 100);
+	ASSERT_EQ(wheel.getSize(), 1);
+}
+
+TEST(PairingHeap, HeapSort) {
+	std::mt19937 generator(5);
+	algogin::PairingHeap<int, int> heap;
+	std::vector<int> priorities;
+	for (int i = 0; i < 10000; i++) {
+		priorities.push_back(generator() % 1000);
+		heap.insert(priorities.back(), i);
+	}
+	std::sort(priorities.begin(), priorities.end());
+	ASSERT_EQ(heap.getSize(), 10000);
+	ASSERT_EQ(heap.traversal(algogin::TraversalMode::LEVEL_ORDER).size(), 10000);
+
+	auto copy = heap;
+	for (int i = 0; i < priorities.size(); i++) {
+		ASSERT_EQ(std::get<0>(heap.getMinimum().value()), priorities[i]);
+		ASSERT_EQ(std::get<0>(copy.getMinimum().value()), priorities[i]);
+	}
+	ASSERT_EQ(heap.getMinimum(), std::nullopt);
+}
+
+TEST(PairingHeap, Handles_Random) {
+	std::mt19937 generator(7);
+	algogin::PairingHeap<int, int> heap;
+	std::vector<std::pair<algogin::PairingHeap<int, int>::Handle, int>> handles;
+	std::multiset<int> reference;
+	for (int i = 0; i < 20000; i++) {
+		int operation = generator() % 5;
+		if (operation <= 1 || handles.empty()) {
+			int priority = generator() % 100000;
+			handles.push_back({ heap.insert(priority, priority), priority });
+			reference.insert(priority);
+			continue;
+		}
+
+		int index = generator() % handles.size();
+		auto& [handle, priority] = handles[index];
+		ASSERT_EQ(heap.contains(handle), true);
+		reference.erase(reference.find(priority));
+		if (operation == 2) {
+			int next = priority - generator() % 1000;
+			ASSERT_EQ(heap.decreaseKey(handle, next), algogin::ALGOGIN_ERROR::OK);
+			priority = next;
+		}
+		else if (operation == 3) {
+			priority = generator() % 100000;
+			ASSERT_EQ(heap.update(handle, priority), algogin::ALGOGIN_ERROR::OK);
+		}
+		else {
+			ASSERT_EQ(heap.erase(handle), algogin::ALGOGIN_ERROR::OK);
+			ASSERT_EQ(heap.contains(handle), false);
+			handles[index] = handles.back();
+			handles.pop_back();
+			continue;
+		}
+		reference.insert(priority);
+		ASSERT_EQ(std::get<0>(heap.top().value()), *reference.begin());
+	}
+
+	ASSERT_EQ(heap.getSize(), reference.size());
+	for (auto priority : reference)
+		ASSERT_EQ(std::get<0>(heap.getMinimum().value()), priority);
+}
+
+TEST(PairingHeap, Meld) {
+	algogin::PairingHeap<int, std::string> first, second;
+	auto handle = second.insert(10, "ten");
+	for (int i = 0; i < 3000; i++) {
+		first.insert(i * 2 + 1, "odd");
+		second.insert(i * 2 + 2, "even");
+	}
+	//free nodes of both heaps are reused after meld
+	second.erase(second.insert(0, "erased"));
+	//handle of other heap is rejected
+	ASSERT_EQ(first.contains(handle), false);
+	ASSERT_EQ(first.erase(handle), algogin::ALGOGIN_ERROR::NOT_FOUND);
+
+	ASSERT_EQ(first.meld(second), algogin::ALGOGIN_ERROR::OK);
+	ASSERT_EQ(second.getSize(), 0);
+	ASSERT_EQ(second.top(), std::nullopt);
+	ASSERT_EQ(first.getSize(), 6001);
+	//handle of melded heap is valid for the result only
+	ASSERT_EQ(second.contains(handle), false);
+	ASSERT_EQ(first.contains(handle), true);
+	ASSERT_EQ(first.decreaseKey(handle, 0), algogin::ALGOGIN_ERROR::OK);
+	ASSERT_EQ(std::get<1>(first.getMinimum().value()), "ten");
+
+	//both heaps are usable after meld
+	second.insert(5, "five");
+	ASSERT_EQ(second.getSize(), 1);
+	for (int i = 0; i < 100; i++)
+		first.insert(-i, "negative");
+	int previous = -1000;
+	std::string value;
+	int priority;
+	while (first.popInto(priority, value) == algogin::ALGOGIN_ERROR::OK) {
+		ASSERT_GE(priority, previous);
+		previous = priority;
+	}
+	ASSERT_EQ(first.meld(first), algogin::ALGOGIN_ERROR::OK);
+	ASSERT_EQ(first.meld(second), algogin::ALGOGIN_ERROR::OK);
+	ASSERT_EQ(std::get<1>(first.getMinimum().value()), "five");
+
+	//handles follow elements when heap is moved
+	handle = second.insert(1, "one");
+	algogin::PairingHeap<int, std::string> third = std::move(second);
+	ASSERT_EQ(third.contains(handle), true);
+	second.insert(2, "two");
+	ASSERT_EQ(second.contains(handle), false);
+}
+
+TEST(ExternalPriorityQueue, Spill_Merge) {
+	auto tmp = std::filesystem::current_path() / "temp";
+	std::filesystem::create_directory(tmp);
+	std::mt19937 generator(3);
+	std::multiset<std::pair<int, int>> reference;
+	int maxRuns = 0;
+	{
+		//heap keeps about 100 elements, 4 blocks of 16 records fit to memory
+		algogin::ExternalPriorityQueue<int, int> queue({ .memory = 2048, .blockSize = 128, .directory = tmp });
+		for (int i = 0; i < 20000; i++) {
+			if (generator() % 3 != 0 || reference.empty()) {
+				int priority = generator() % 100000;
+				ASSERT_EQ(queue.insert(priority, priority + 1), algogin::ALGOGIN_ERROR::OK);
+				reference.insert({ priority, priority + 1 });
+			}
+			else {
+				ASSERT_EQ(std::get<0>(queue.top().value()), reference.begin()->first);
+				auto [priority, value] = queue.getMinimum().value();
+				ASSERT_EQ(priority, reference.begin()->first);
+				ASSERT_EQ(value, priority + 1);
+				reference.erase(reference.begin());
+			}
+			ASSERT_EQ(queue.getSize(), reference.size());
+			maxRuns = std::max(maxRuns, queue.getRuns());
+		}
+		ASSERT_GE(maxRuns, 2);
+		//runs are merged when their blocks don't fit to memory
+		ASSERT_LE(maxRuns, 8);
+
+		auto moved = std::move(queue);
+		ASSERT_EQ(queue.getSize(), 0);
+		ASSERT_EQ(queue.getMinimum(), std::nullopt);
+		for (int i = 0; i < reference.size() / 2; i++)
+			moved.getMinimum();
+	}
+	//run files are removed with the queue
+	ASSERT_EQ(std::filesystem::is_empty(tmp), true);
+}
+
+TEST(ExternalPriorityQueue, Drain) {
+	auto tmp = std::filesystem::current_path() / "temp";
+	std::filesystem::create_directory(tmp);
+	algogin::ExternalPriorityQueue<uint64_t, uint32_t> queue({ .memory = 4096, .blockSize = 256, .directory = tmp });
+	for (uint64_t i = 0; i < 10000; i++)
+		queue.insert((i * 7919) % 10000, static_cast<uint32_t>(i));
+	ASSERT_GT(queue.getRuns(), 0);
+
+	uint64_t priority;
+	uint32_t value;
+	for (uint64_t i = 0; i < 10000; i++) {
+		ASSERT_EQ(queue.popInto(priority, value), algogin::ALGOGIN_ERROR::OK);
+		ASSERT_EQ(priority, i);
+	}
+	ASSERT_EQ(queue.popInto(value), algogin::ALGOGIN_ERROR::NOT_FOUND);
+	ASSERT_EQ(queue.getRuns(), 0);
+	ASSERT_EQ(std::filesystem::is_empty(tmp), true);
+}
+
+TEST(TopK, Offer) {
+	algogin::TopK<int, std::string> top(3);
+	ASSERT_EQ(top.getThreshold(), std::nullopt);
+	ASSERT_EQ(top.offer(5, "five"), algogin::ALGOGIN_ERROR::OK);
+	ASSERT_EQ(top.offer(1, "one"), algogin::ALGOGIN_ERROR::OK);
+	ASSERT_EQ(top.offer(7, "seven"), algogin::ALGOGIN_ERROR::OK);
+	ASSERT_EQ(top.getThreshold(), 1);
+	//equal to threshold is rejected
+	ASSERT_EQ(top.offer(1, "another one"), algogin::ALGOGIN_ERROR::REJECTED);
+	ASSERT_EQ(top.offer(6, "six"), algogin::ALGOGIN_ERROR::OK);
+	ASSERT_EQ(top.getThreshold(), 5);
+	ASSERT_EQ(top.getSize(), 3);
+
+	auto sorted = top.getSorted();
+	ASSERT_EQ(sorted.size(), 3);
+	ASSERT_EQ(sorted[0], std::make_tuple(7, std::string("seven")));
+	ASSERT_EQ(sorted[1], std::make_tuple(6, std::string("six")));
+	ASSERT_EQ(sorted[2], std::make_tuple(5, std::string("five")));
+}
+
+template <class T>
+static void checkTopBatch() {
+	std::mt19937 generator(9);
+	std::vector<T> priorities(100003);
+	std::vector<int> values(priorities.size());
+	for (int i = 0; i < priorities.size(); i++) {
+		//increasing trend makes threshold grow inside chunks
+		priorities[i] = static_cast<T>(generator() % 1000000 + i * 5);
+		values[i] = i;
+	}
+
+	algogin::TopK<T, int> batch(1000), single(1000);
+	size_t accepted = batch.offerBatch(priorities, values);
+	size_t expected = 0;
+	for (int i = 0; i < priorities.size(); i++)
+		expected += single.offer(priorities[i], values[i]) == algogin::ALGOGIN_ERROR::OK;
+	ASSERT_EQ(accepted, expected);
+
+	std::vector<T> sorted = priorities;
+	std::sort(sorted.rbegin(), sorted.rend());
+	auto result = batch.getSorted();
+	ASSERT_EQ(result.size(), 1000);
+	for (int i = 0; i < 1000; i++) {
+		ASSERT_EQ(std::get<0>(result[i]), sorted[i]);
+		ASSERT_EQ(priorities[std::get<1>(result[i])], sorted[i]);
+	}
+}
+
+TEST(TopK, OfferBatch) {
+	checkTopBatch<int32_t>();
+	checkTopBatch<float>();
+	checkTopBatch<uint64_t>();
+}
+
+TEST(TopK, Merge_Threads) {
+	const int threads = 4;
+	const int perThread = 50000;
+	std::vector<algogin::TopK<int, int>> partial(threads, algogin::TopK<int, int>(100));
+	std::vector<std::thread> workers;
+	for (int t = 0; t < threads; t++) {
+		workers.emplace_back([&, t] {
+			for (int i = 0; i < perThread; i++) {
+				int item = t * perThread + i;
+				partial[t].offer((item * 7919) % 200000, item);
+			}
+		});
+	}
+	for (auto& worker : workers)
+		worker.join();
+
+	algogin::TopK<int, int> result(100);
+	result.merge(partial[0]);
+	for (int t = 1; t < threads; t++)
+		result.merge(std::move(partial[t]));
+	ASSERT_EQ(partial[1].getSize(), 0);
+
+	auto sorted = result.getSorted();
+	for (int i = 0; i < 100; i++)
+		ASSERT_EQ(std::get<0>(sorted[i]), 199999 - i);
+
+	//merge with itself keeps selector unchanged
+	ASSERT_EQ(result.merge(result), algogin::ALGOGIN_ERROR::OK);
+	ASSERT_EQ(result.merge(std::move(result)), algogin::ALGOGIN_ERROR::OK);
+	ASSERT_EQ(result.getSorted(), sorted);
+}
@@ -1,5 +1,14 @@
 #include <gtest/gtest.h>
 #include "Sorting.h"
+#include <algorithm>
+#include <random>
+#include <string>
+#include <deque>
+#include <memory>
+#include <span>
+#include <limits>
+#include <bit>
+#include <cmath>
 
 TEST(BubbleSorting, Simple) {
 	Sorting sorting;
@@ -114,4 +123,445 @@ TEST(QuickSorting, Simple) {
 	ASSERT_EQ(output[2], 4);
 	ASSERT_EQ(output[3], 5);
 	ASSERT_EQ(output[4], 8);
-}
\ No newline at end of file
+}
+//sizes around insertion threshold and ninther threshold, patterns which are quadratic for naive pivot
+static std::vector<std::vector<int>> generatePatterns() {
+	std::mt19937 generator(1);
+	std::vector<std::vector<int>> patterns;
+	for (int size : { 0, 1, 2, 3, 24, 25, 129, 1000, 20000 }) {
+		std::vector<int> random(size), sorted(size), reverse(size), organ(size), duplicates(size), equal(size, 7);
+		for (int i = 0; i < size; i++) {
+			random[i] = generator();
+			sorted[i] = i;
+			reverse[i] = size - i;
+			organ[i] = i < size / 2 ? i : size - i;
+			duplicates[i] = generator() % 4;
+		}
+		patterns.insert(patterns.end(), { random, sorted, reverse, organ, duplicates, equal });
+	}
+
+	return patterns;
+}
+
+TEST(QuickSorting, Patterns) {
+	Sorting sorting;
+	for (auto& pattern : generatePatterns()) {
+		auto expected = pattern;
+		std::sort(expected.begin(), expected.end());
+		ASSERT_EQ(sorting.quickSort(pattern), expected);
+	}
+
+	std::vector<std::string> strings;
+	for (int i = 0; i < 1000; i++)
+		strings.push_back(std::to_string(i % 37));
+	auto expected = strings;
+	std::sort(expected.begin(), expected.end());
+	ASSERT_EQ(sorting.quickSort(strings), expected);
+}
+
+//element counting comparisons, the counter is shared by all elements
+struct Counted {
+	static inline int64_t comparisons = 0;
+	int value;
+
+	bool operator<(const Counted& other) const {
+		comparisons++;
+		return value < other.value;
+	}
+};
+
+TEST(QuickSorting, Comparisons) {
+	Sorting sorting;
+	for (auto& pattern : generatePatterns()) {
+		if (pattern.size() != 20000)
+			continue;
+
+		std::vector<Counted> input;
+		for (int value : pattern)
+			input.push_back({ value });
+		Counted::comparisons = 0;
+		auto output = sorting.quickSort(input);
+		//n log n is about 290K
+		ASSERT_LT(Counted::comparisons, 700'000);
+		for (int i = 1; i < output.size(); i++)
+			ASSERT_LE(output[i - 1].value, output[i].value);
+	}
+}
+
+struct Record {
+	int key;
+	std::string name;
+};
+
+//counts copies, moves are free
+struct CopyCounted {
+	static inline int copies = 0;
+	int value;
+
+	CopyCounted(int value) : value(value) {}
+	CopyCounted(const CopyCounted& other) : value(other.value) { copies++; }
+	CopyCounted(CopyCounted&&) = default;
+	CopyCounted& operator=(const CopyCounted& other) { value = other.value; copies++; return *this; }
+	CopyCounted& operator=(CopyCounted&&) = default;
+	bool operator<(const CopyCounted& other) const { return value < other.value; }
+};
+
+TEST(Sorting, InPlace_Span) {
+	Sorting sorting;
+	std::vector<int> input = { 5, 3, 9, 1, 7, 2 };
+	sorting.quickSort(std::span<int>(input).subspan(1, 4));
+	ASSERT_EQ(input, std::vector<int>({ 5, 1, 3, 7, 9, 2 }));
+
+	sorting.insertionSort(input.begin(), input.end(), std::greater<>());
+	ASSERT_EQ(input, std::vector<int>({ 9, 7, 5, 3, 2, 1 }));
+	sorting.selectionSort(std::span<int>(input));
+	ASSERT_EQ(input, std::vector<int>({ 1, 2, 3, 5, 7, 9 }));
+	sorting.bubbleSort(input.begin(), input.end(), std::greater<>());
+	ASSERT_EQ(input, std::vector<int>({ 9, 7, 5, 3, 2, 1 }));
+
+	std::deque<int> deque = { 4, 2, 8, 6 };
+	sorting.mergeSort(deque.begin(), deque.end());
+	ASSERT_EQ(deque, std::deque<int>({ 2, 4, 6, 8 }));
+}
+
+TEST(Sorting, Projection_Stable) {
+	Sorting sorting;
+	std::vector<Record> records;
+	for (int i = 0; i < 1000; i++)
+		records.push_back({ (i * 7) % 10, std::to_string(i) });
+
+	//merge sort is stable: records with equal keys keep their order
+	auto sorted = sorting.mergeSort(records, std::less<>(), &Record::key);
+	for (int i = 1; i < sorted.size(); i++) {
+		ASSERT_LE(sorted[i - 1].key, sorted[i].key);
+		if (sorted[i - 1].key == sorted[i].key)
+			ASSERT_LT(std::stoi(sorted[i - 1].name), std::stoi(sorted[i].name));
+	}
+
+	sorting.quickSort(records.begin(), records.end(), std::greater<>(), [](const Record& record) { return record.name; });
+	for (int i = 1; i < records.size(); i++)
+		ASSERT_GE(records[i - 1].name, records[i].name);
+}
+
+TEST(Sorting, No_Copies) {
+	Sorting sorting;
+	std::vector<CopyCounted> input;
+	for (int i = 0; i < 10000; i++)
+		input.push_back((i * 7919) % 10000);
+
+	CopyCounted::copies = 0;
+	input = sorting.quickSort(std::move(input));
+	input = sorting.mergeSort(std::move(input), [](const CopyCounted& left, const CopyCounted& right) { return right < left; });
+	sorting.quickSort(std::span<CopyCounted>(input));
+	ASSERT_EQ(CopyCounted::copies, 0);
+	for (int i = 0; i < input.size(); i++)
+		ASSERT_EQ(input[i].value, i);
+
+	//move-only elements
+	std::vector<std::unique_ptr<int>> pointers;
+	for (int i = 0; i < 100; i++)
+		pointers.push_back(std::make_unique<int>(100 - i));
+	pointers = sorting.quickSort(std::move(pointers), std::less<>(), [](const std::unique_ptr<int>& pointer) { return *pointer; });
+	for (int i = 0; i < 100; i++)
+		ASSERT_EQ(*pointers[i], i + 1);
+}
+
+TEST(Sorting, ParallelMergeSort) {
+	Sorting sorting;
+	std::mt19937 generator(2);
+	for (int threads : { 1, 4 }) {
+		algogin::ThreadPool pool(threads);
+		for (int size : { 0, 1, 30, 1000, 140000 }) {
+			std::vector<uint64_t> input(size);
+			for (auto& value : input)
+				value = generator() % 1000;
+			auto expected = input;
+			std::sort(expected.begin(), expected.end());
+			ASSERT_EQ(sorting.parallelMergeSort(input, pool), expected);
+		}
+
+		//stable: values with equal keys keep their order after parallel merges
+		std::vector<std::pair<int, int>> pairs(140000);
+		for (int i = 0; i < pairs.size(); i++)
+			pairs[i] = { static_cast<int>(generator() % 100), i };
+		sorting.parallelMergeSort(std::span<std::pair<int, int>>(pairs), pool, std::greater<>(), &std::pair<int, int>::first);
+		for (int i = 1; i < pairs.size(); i++) {
+			ASSERT_GE(pairs[i - 1].first, pairs[i].first);
+			if (pairs[i - 1].first == pairs[i].first)
+				ASSERT_LT(pairs[i - 1].second, pairs[i].second);
+		}
+	}
+}
+
+TEST(Sorting, SampleSort) {
+	Sorting sorting;
+	std::mt19937 generator(4);
+	algogin::ThreadPool pool(3);
+	//sizes below and above base case and parallel threshold, few and many distinct keys
+	for (int size : { 0, 1, 4097, 30000, 140001 }) {
+		for (uint32_t distinct : { 2u, 1000u, 1u << 31 }) {
+			std::vector<uint32_t> input(size);
+			for (auto& value : input)
+				value = generator() % distinct;
+			auto expected = input;
+			std::sort(expected.begin(), expected.end());
+			ASSERT_EQ(sorting.sampleSort(input), expected);
+			ASSERT_EQ(sorting.parallelSampleSort(input, pool), expected);
+		}
+	}
+
+	for (auto& pattern : generatePatterns()) {
+		auto expected = pattern;
+		std::sort(expected.begin(), expected.end());
+		ASSERT_EQ(sorting.sampleSort(pattern), expected);
+	}
+
+	std::vector<Record> records;
+	for (int i = 0; i < 20000; i++)
+		records.push_back({ i % 300, std::to_string(i) });
+	sorting.parallelSampleSort(std::span<Record>(records), pool, std::greater<>(), &Record::key);
+	for (int i = 1; i < records.size(); i++)
+		ASSERT_GE(records[i - 1].key, records[i].key);
+}
+
+TEST(Sorting, RadixSort) {
+	Sorting sorting;
+	std::mt19937_64 generator(5);
+	algogin::ThreadPool pool(3);
+	for (int size : { 0, 1, 25, 1000, 140000 }) {
+		std::vector<int64_t> signedKeys(size);
+		std::vector<uint16_t> shortKeys(size);
+		std::vector<double> floatKeys(size);
+		for (int i = 0; i < size; i++) {
+			signedKeys[i] = static_cast<int64_t>(generator());
+			shortKeys[i] = static_cast<uint16_t>(generator());
+			floatKeys[i] = std::uniform_real_distribution<double>(-1e6, 1e6)(generator);
+		}
+		if (size > 1) {
+			floatKeys[0] = -0.0;
+			floatKeys[1] = 0.0;
+		}
+
+		auto expectedSigned = signedKeys;
+		std::sort(expectedSigned.begin(), expectedSigned.end());
+		ASSERT_EQ(sorting.radixSort(signedKeys), expectedSigned);
+		ASSERT_EQ(sorting.radixSort<8>(signedKeys), expectedSigned);
+		auto expectedShort = shortKeys;
+		std::sort(expectedShort.begin(), expectedShort.end());
+		ASSERT_EQ(sorting.radixSort<16>(shortKeys), expectedShort);
+		auto expectedFloat = floatKeys;
+		std::stable_sort(expectedFloat.begin(), expectedFloat.end());
+		ASSERT_EQ(sorting.radixSort(floatKeys), expectedFloat);
+
+		auto parallel = signedKeys;
+		sorting.parallelRadixSort(std::span<int64_t>(parallel), pool);
+		ASSERT_EQ(parallel, expectedSigned);
+		auto msd = floatKeys;
+		sorting.msdRadixSort(std::span<double>(msd));
+		ASSERT_EQ(msd, expectedFloat);
+	}
+
+	for (auto& pattern : generatePatterns()) {
+		auto expected = pattern;
+		std::sort(expected.begin(), expected.end());
+		ASSERT_EQ(sorting.radixSort(pattern), expected);
+		ASSERT_EQ(sorting.sort(pattern), expected);
+		sorting.msdRadixSort(std::span<int>(pattern));
+		ASSERT_EQ(pattern, expected);
+	}
+}
+
+TEST(Sorting, RadixSort_KeyValue) {
+	Sorting sorting;
+	std::mt19937 generator(6);
+	algogin::ThreadPool pool(3);
+	//values keep order of insertion inside equal keys
+	std::vector<int> keys(140000);
+	std::vector<std::string> values(keys.size());
+	for (int i = 0; i < keys.size(); i++) {
+		keys[i] = static_cast<int>(generator() % 2000) - 1000;
+		values[i] = std::to_string(i);
+	}
+	auto parallelKeys = keys;
+	auto parallelValues = values;
+	sorting.radixSort(std::span<int>(keys), std::span<std::string>(values));
+	sorting.parallelRadixSort(std::span<int>(parallelKeys), std::span<std::string>(parallelValues), pool);
+	ASSERT_EQ(parallelKeys, keys);
+	ASSERT_EQ(parallelValues, values);
+	for (int i = 1; i < keys.size(); i++) {
+		ASSERT_LE(keys[i - 1], keys[i]);
+		if (keys[i - 1] == keys[i])
+			ASSERT_LT(std::stoi(values[i - 1]), std::stoi(values[i]));
+	}
+
+	std::vector<Record> records;
+	for (int i = 0; i < 20000; i++)
+		records.push_back({ static_cast<int>(generator() % 300), std::to_string(i) });
+	auto expected = records;
+	std::stable_sort(expected.begin(), expected.end(), [](auto& left, auto& right) { return left.key < right.key; });
+	sorting.radixSort(std::span<Record>(records), &Record::key);
+	for (int i = 0; i < records.size(); i++)
+		ASSERT_EQ(records[i].name, expected[i].name);
+	//descending order isn't radix sortable and goes to introsort
+	sorting.sort(std::span<Record>(records), std::greater<>(), &Record::key);
+	for (int i = 1; i < records.size(); i++)
+		ASSERT_GE(records[i - 1].key, records[i].key);
+}
+
+template <class T>
+static void checkNetwork(algogin::network::Level level) {
+	std::mt19937_64 generator(7);
+	for (int size = 0; size <= algogin::network::MAX_SIZE; size++) {
+		//few distinct values and full range with negative numbers
+		for (int64_t distinct : { 3ll, 1ll << 40 }) {
+			std::vector<T> input(size);
+			for (auto& value : input)
+				value = static_cast<T>(static_cast<int64_t>(generator() % distinct) - distinct / 2);
+			auto expected = input;
+			std::sort(expected.begin(), expected.end());
+			ASSERT_EQ(algogin::network::sort(input.data(), size, level), algogin::ALGOGIN_ERROR::OK);
+			ASSERT_EQ(input, expected);
+		}
+	}
+}
+
+TEST(Sorting, Network) {
+	//levels not supported by CPU fall back to narrower ones
+	for (auto level : { algogin::network::Level::SCALAR, algogin::network::Level::AVX2, algogin::network::Level::AVX512 }) {
+		checkNetwork<int32_t>(level);
+		checkNetwork<int64_t>(level);
+		checkNetwork<float>(level);
+	}
+
+	std::vector<int> tooLong(algogin::network::MAX_SIZE + 1);
+	ASSERT_EQ(algogin::network::sort(tooLong.data(), static_cast<int>(tooLong.size())), algogin::ALGOGIN_ERROR::OUT_OF_BOUNDS);
+
+	//zeros are compared bitwise: -0.f == 0.f would hide lost signs
+	const float infinity = std::numeric_limits<float>::infinity();
+	for (auto level : { algogin::network::Level::SCALAR, algogin::network::Level::AVX2, algogin::network::Level::AVX512 }) {
+		std::vector<float> special = { 3.f, infinity, -0.f, -infinity, 0.f, -1.f, -0.f, 0.f, -0.f };
+		algogin::network::sort(special.data(), static_cast<int>(special.size()), level);
+		ASSERT_TRUE(std::is_sorted(special.begin(), special.end()));
+		ASSERT_EQ(std::count_if(special.begin(), special.end(), [](float value) { return value == 0.f && std::signbit(value); }), 3);
+		ASSERT_EQ(std::count_if(special.begin(), special.end(), [](float value) { return value == 0.f && !std::signbit(value); }), 2);
+
+		std::mt19937 generator(11);
+		for (int size : { 17, 100, 256 }) {
+			std::vector<float> zeros(size);
+			for (auto& value : zeros)
+				value = generator() % 2 ? -0.f : static_cast<float>(static_cast<int>(generator() % 5) - 2);
+			auto expected = zeros;
+			std::sort(expected.begin(), expected.end(), [](float left, float right) {
+				return std::bit_cast<int32_t>(left) < std::bit_cast<int32_t>(right);
+			});
+			algogin::network::sort(zeros.data(), size, level);
+			std::vector<uint32_t> bits, expectedBits;
+			for (int i = 0; i < size; i++) {
+				bits.push_back(std::bit_cast<uint32_t>(zeros[i]));
+				expectedBits.push_back(std::bit_cast<uint32_t>(expected[i]));
+			}
+			std::sort(bits.begin(), bits.end());
+			std::sort(expectedBits.begin(), expectedBits.end());
+			ASSERT_EQ(bits, expectedBits);
+			ASSERT_TRUE(std::is_sorted(zeros.begin(), zeros.end()));
+		}
+
+		//NaN isn't lost
+		std::vector<float> withNaN = { 2.f, std::numeric_limits<float>::quiet_NaN(), 1.f, 1.f };
+		algogin::network::sort(withNaN.data(), static_cast<int>(withNaN.size()), level);
+		ASSERT_EQ(std::count_if(withNaN.begin(), withNaN.end(), [](float value) { return value != value; }), 1);
+		ASSERT_EQ(std::count(withNaN.begin(), withNaN.end(), 1.f), 2);
+	}
+}
+
+TEST(Sorting, Network_BaseCase) {
+	Sorting sorting;
+	std::mt19937 generator(8);
+	//recursive sorts finish short ranges of plain numbers by network, other orders keep the old base case
+	for (int size : { 100, 257, 5000 }) {
+		std::vector<int64_t> input(size);
+		std::vector<float> floats(size);
+		for (int i = 0; i < size; i++) {
+			input[i] = static_cast<int64_t>(generator()) - (1ll << 31);
+			floats[i] = static_cast<float>(generator() % 100) - 50.f;
+		}
+		auto expected = input;
+		std::sort(expected.begin(), expected.end());
+		auto expectedFloats = floats;
+		std::stable_sort(expectedFloats.begin(), expectedFloats.end());
+		ASSERT_EQ(sorting.quickSort(input), expected);
+		ASSERT_EQ(sorting.mergeSort(input), expected);
+		ASSERT_EQ(sorting.sampleSort(input), expected);
+		ASSERT_EQ(sorting.quickSort(floats), expectedFloats);
+		ASSERT_EQ(sorting.mergeSort(floats), expectedFloats);
+		std::reverse(expected.begin(), expected.end());
+		ASSERT_EQ(sorting.quickSort(input, std::greater<>()), expected);
+
+		//signed zeros are equal for comparison sorts but none of them may lose its sign
+		std::vector<float> zeros(size);
+		for (auto& value : zeros)
+			value = generator() % 3 ? -0.f : 0.f;
+		auto negativeZeros = std::count_if(zeros.begin(), zeros.end(), [](float value) { return std::signbit(value); });
+		for (auto& sorted : { sorting.quickSort(zeros), sorting.mergeSort(zeros), sorting.sampleSort(zeros), sorting.sort(zeros) })
+			ASSERT_EQ(std::count_if(sorted.begin(), sorted.end(), [](float value) { return std::signbit(value); }), negativeZeros);
+	}
+}
+
+TEST(Sorting, PowerSort) {
+	Sorting sorting;
+	for (auto& pattern : generatePatterns()) {
+		auto expected = pattern;
+		std::sort(expected.begin(), expected.end());
+		ASSERT_EQ(sorting.powerSort(pattern), expected);
+		ASSERT_EQ(sorting.powerSort(pattern, std::greater<>()), std::vector<int>(expected.rbegin(), expected.rend()));
+	}
+
+	//stable for long random merges (split by rotations) and for runs with many equal keys (galloping)
+	std::mt19937 generator(9);
+	for (int distinct : { 3, 100, 100000 }) {
+		std::vector<std::pair<int, int>> pairs(60000);
+		for (int i = 0; i < pairs.size(); i++)
+			pairs[i] = { static_cast<int>(generator() % distinct), i };
+		//the second half is made of sorted blocks
+		for (int i = 30000; i < 60000; i += 5000)
+			std::stable_sort(pairs.begin() + i, pairs.begin() + i + 5000, [](auto& left, auto& right) { return left.first < right.first; });
+		auto expected = pairs;
+		std::stable_sort(expected.begin(), expected.end(), [](auto& left, auto& right) { return left.first < right.first; });
+		sorting.powerSort(std::span<std::pair<int, int>>(pairs), std::less<>(), &std::pair<int, int>::first);
+		ASSERT_EQ(pairs, expected);
+	}
+}
+
+TEST(Sorting, PowerSort_Adaptive) {
+	Sorting sorting;
+	std::mt19937 generator(10);
+	//sorted input is one run: n - 1 comparisons
+	std::vector<Counted> sorted;
+	for (int i = 0; i < 100000; i++)
+		sorted.push_back({ i / 3 });
+	Counted::comparisons = 0;
+	sorting.powerSort(std::span<Counted>(sorted));
+	ASSERT_EQ(Counted::comparisons, 99999);
+
+	//strictly descending run is reversed
+	std::vector<Counted> descending;
+	for (int i = 0; i < 100000; i++)
+		descending.push_back({ 100000 - i });
+	Counted::comparisons = 0;
+	sorting.powerSort(std::span<Counted>(descending));
+	ASSERT_EQ(Counted::comparisons, 99999);
+	for (int i = 0; i < descending.size(); i++)
+		ASSERT_EQ(descending[i].value, i + 1);
+
+	//sorted log with a few random inserts: galloping skips long sorted blocks
+	std::vector<Counted> log;
+	for (int i = 0; i < 100000; i++)
+		log.push_back({ i });
+	for (int i = 0; i < 100; i++)
+		log.insert(log.begin() + generator() % log.size(), { static_cast<int>(generator() % 100000) });
+	Counted::comparisons = 0;
+	sorting.powerSort(std::span<Counted>(log));
+	ASSERT_LT(Counted::comparisons, 300000);
+	for (int i = 1; i < log.size(); i++)
+		ASSERT_LE(log[i - 1].value, log[i].value);
+}
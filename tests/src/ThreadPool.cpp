@@ -0,0 +1,44 @@
+#include <gtest/gtest.h>
+#include "ThreadPool.h"
+#include <atomic>
+#include <numeric>
+#include <vector>
+
+TEST(ThreadPool, Run_Wait) {
+	algogin::ThreadPool pool(4);
+	ASSERT_EQ(pool.getThreads(), 4);
+
+	std::vector<int> values(10000);
+	algogin::ThreadPool::Group group;
+	for (int i = 0; i < values.size(); i++)
+		pool.run(group, [&values, i] { values[i] = i * 2; });
+	pool.wait(group);
+	for (int i = 0; i < values.size(); i++)
+		ASSERT_EQ(values[i], i * 2);
+
+	//pool is reusable after wait
+	std::atomic<int> counter = 0;
+	for (int i = 0; i < 100; i++)
+		pool.run(group, [&counter] { counter++; });
+	pool.wait(group);
+	ASSERT_EQ(counter.load(), 100);
+}
+
+static int64_t parallelSum(algogin::ThreadPool& pool, const int* data, int size) {
+	if (size <= 16)
+		return std::accumulate(data, data + size, int64_t(0));
+
+	int64_t left = 0, right = 0;
+	pool.invoke([&] { left = parallelSum(pool, data, size / 2); },
+				[&] { right = parallelSum(pool, data + size / 2, size - size / 2); });
+	return left + right;
+}
+
+TEST(ThreadPool, Invoke_Nested) {
+	std::vector<int> data(100000);
+	std::iota(data.begin(), data.end(), 0);
+	for (int threads : { 1, 3, 8 }) {
+		algogin::ThreadPool pool(threads);
+		ASSERT_EQ(parallelSum(pool, data.data(), data.size()), int64_t(99999) * 100000 / 2);
+	}
+}